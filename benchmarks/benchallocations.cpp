@@ -0,0 +1,176 @@
+/**
+@file  benchallocations.cpp
+@brief Counts the heap allocations of the Monte Carlo pricers, which must not grow with the paths
+*/
+
+#include "benchutils.hpp"
+#include <orflib/pricers/bsmcpricer.hpp>
+#include <orflib/pricers/multiassetbsmcpricer.hpp>
+#include <orflib/pricers/portfoliobsmcpricer.hpp>
+#include <orflib/products/americancallput.hpp>
+#include <orflib/products/asianbasketcallput.hpp>
+#include <orflib/products/barriercallput.hpp>
+#include <orflib/products/digitalcallput.hpp>
+#include <orflib/products/europeancallput.hpp>
+#include <orflib/products/worstofdigitalcallput.hpp>
+#include <orflib/math/stats/meanvarcalculator.hpp>
+#include <orflib/math/stats/quantilecalculator.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// every allocation of the program goes through the global operator new, and is counted
+static std::atomic<size_t> nallocs(0);
+
+#ifdef ORF_WRAP_ALLOCATIONS
+// armadillo allocates with posix_memalign, not operator new: the linker redirects the calls of the
+// program to malloc and posix_memalign here, and operator new counts through malloc
+extern "C" {
+void* __real_malloc(size_t n);
+int __real_posix_memalign(void** p, size_t alignment, size_t n);
+
+void* __wrap_malloc(size_t n)
+{
+  ++nallocs;
+  return __real_malloc(n);
+}
+
+int __wrap_posix_memalign(void** p, size_t alignment, size_t n)
+{
+  ++nallocs;
+  return __real_posix_memalign(p, alignment, n);
+}
+}
+#endif
+
+void* operator new(size_t n)
+{
+#ifndef ORF_WRAP_ALLOCATIONS
+  ++nallocs;
+#endif
+  void* p = std::malloc(n > 0 ? n : 1);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](size_t n)
+{
+  return operator new(n);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+using namespace orf;
+using UrngType = McParams::UrngType;
+using PathGenType = McParams::PathGenType;
+using ControlVarType = McParams::ControlVarType;
+
+/** Checks that the allocations of a simulation do not depend on its number of paths: after a first
+    simulate() call, which sizes the scratch buffers and the samples kept by the statistics,
+    simulate() is called for npaths and 4 npaths, in whole blocks of paths. Both calls must make
+    the same allocations, so no batch allocates. The calibration of the Longstaff-Schwartz regression
+    allocates a few times in each call, but fewer than once per block.
+*/
+template <typename PRICER, typename STATS>
+static void countAllocations(std::string const& name, PRICER& pricer, STATS& stats, BenchChecks& checks,
+                             bool hasLsm = false)
+{
+  const unsigned long npaths = 16 * McParams::PATHBLOCKSIZE;
+  pricer.simulate(stats, 4 * npaths);
+  size_t counts[2];
+  for (int k = 0; k < 2; ++k) {
+    stats.reset();
+    size_t before = nallocs;
+    pricer.simulate(stats, k == 0 ? npaths : 4 * npaths);
+    counts[k] = nallocs - before;
+  }
+  std::printf("%-44s allocations: %4zu for %lu paths, %4zu for %lu paths\n",
+    name.c_str(), counts[0], npaths, counts[1], 4 * npaths);
+  size_t nblocks = 3 * npaths / McParams::PATHBLOCKSIZE;
+  if (hasLsm)
+    checks.check(counts[1] < counts[0] + nblocks, name + ": no allocation per batch of paths");
+  else
+    checks.check(counts[1] == counts[0], name + ": no allocation per batch of paths");
+}
+
+int main()
+{
+  BenchChecks checks;
+  double expiry = 1.0, rate = 0.05, vol = 0.2;
+  SPtrYieldCurve discountCurve(new YieldCurve(&expiry, &expiry + 1, &rate, &rate + 1,
+                                              YieldCurve::InputType::SPOTRATE));
+  SPtrVolatilityTermStructure volTS(new VolatilityTermStructure(&expiry, &expiry + 1, &vol, &vol + 1));
+  Vector fixings = arma::regspace(1.0, 1.0, 12.0) / 12.0;
+  Vector one{ 1.0 };
+
+  struct Config
+  {
+    std::string name;
+    SPtrProduct prod;
+    McParams mcparams;
+  };
+  std::vector<Config> configs{
+    { "European", SPtrProduct(new EuropeanCallPut(1, 100.0, expiry)), McParams() },
+    { "European, antithetic", SPtrProduct(new EuropeanCallPut(1, 100.0, expiry)),
+      McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::ANTITHETIC) },
+    { "European, control variate", SPtrProduct(new EuropeanCallPut(1, 100.0, expiry)),
+      McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::CONTROLVARIATE) },
+    { "European, Greeks", SPtrProduct(new EuropeanCallPut(1, 100.0, expiry)),
+      McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::NONE, 0, 0, true) },
+    { "digital, Greeks", SPtrProduct(new DigitalCallPut(1, 100.0, expiry)),
+      McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::NONE, 0, 0, true) },
+    { "Asian, Brownian bridge, Sobol", SPtrProduct(new AsianBasketCallPut(1, 100.0, fixings, one)),
+      McParams(UrngType::SOBOL, PathGenType::BROWNIANBRIDGE) },
+    { "Asian, Greeks", SPtrProduct(new AsianBasketCallPut(1, 100.0, fixings, one)),
+      McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::NONE, 0, 0, true) },
+    { "barrier, control variate", SPtrProduct(new BarrierCallPut(1, 100.0, -1, 90.0, fixings)),
+      McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::CONTROLVARIATE) },
+    { "barrier, conditional", SPtrProduct(new BarrierCallPut(1, 100.0, -1, 90.0, fixings)),
+      McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::CONDITIONAL) },
+    { "American, LSM", SPtrProduct(new AmericanCallPut(-1, 100.0, expiry)), McParams() },
+  };
+  for (Config const& config : configs) {
+    BsMcPricer pricer(config.prod, discountCurve, 0.02, volTS, 100.0, config.mcparams);
+    MeanVarCalculator<double*> stats(pricer.nVariables());
+    countAllocations("BsMcPricer, " + config.name, pricer, stats, checks, config.prod->hasEarlyExercise());
+  }
+  {
+    BsMcPricer pricer(configs[1].prod, discountCurve, 0.02, volTS, 100.0, configs[1].mcparams);
+    QuantileCalculator<double*> stats(1, Vector{ 0.01, 0.5 });
+    countAllocations("BsMcPricer, European, antithetic, quantiles", pricer, stats, checks);
+  }
+
+  Vector quantities{ 0.4, 0.3, 0.3 }, spots{ 100.0, 100.0, 100.0 }, divyields{ 0.02, 0.02, 0.02 };
+  Vector vols{ 0.2, 0.25, 0.3 };
+  Matrix correl(3, 3);
+  correl.fill(0.5);
+  correl.diag().ones();
+  SPtrProduct basket(new AsianBasketCallPut(1, 100.0, fixings, quantities));
+  SPtrProduct worstof(new WorstOfDigitalCallPut(1, 1.0, 0.5, expiry, 3));
+  std::vector<Config> multiConfigs{
+    { "basket", basket, McParams() },
+    { "basket, control variate", basket,
+      McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::CONTROLVARIATE) },
+    { "basket, Greeks", basket,
+      McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::NONE, 0, 0, true) },
+    { "worst-of, Greeks", worstof,
+      McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::NONE, 0, 0, true) },
+  };
+  for (Config const& config : multiConfigs) {
+    MultiAssetBsMcPricer pricer(config.prod, discountCurve, divyields, vols, spots, correl, config.mcparams);
+    MeanVarCalculator<double*> stats(pricer.nVariables());
+    countAllocations("MultiAssetBsMcPricer, " + config.name, pricer, stats, checks);
+  }
+  {
+    std::vector<SPtrProduct> prods{ basket, worstof };
+    PortfolioBsMcPricer pricer(prods, discountCurve, divyields, vols, spots, correl, McParams());
+    MeanVarCalculator<double*> stats(pricer.nVariables());
+    countAllocations("PortfolioBsMcPricer, basket and worst-of", pricer, stats, checks);
+  }
+
+  return checks.exitCode();
+}
@@ -0,0 +1,108 @@
+/**
+@file  benchbarrier.cpp
+@brief Benchmark of the early termination of knocked-out paths in the Monte Carlo pricers
+*/
+
+#include "benchutils.hpp"
+#include <orflib/pricers/bsmcpricer.hpp>
+#include <orflib/pricers/multiassetbsmcpricer.hpp>
+#include <orflib/pricers/simplepricers.hpp>
+#include <orflib/products/barriercallput.hpp>
+#include <orflib/math/stats/meanvarcalculator.hpp>
+#include <cmath>
+
+using namespace orf;
+
+// the barrier option simulated to expiration, the pricers then generate every path in full
+class BarrierNoTermination : public BarrierCallPut
+{
+public:
+  using BarrierCallPut::BarrierCallPut;
+  virtual SPtrProduct clone() const override
+  {
+    return SPtrProduct(new BarrierNoTermination(*this));
+  }
+  virtual bool hasEarlyTermination() const override { return false; }
+};
+
+const double spot = 100.0, rate = 0.05, divyield = 0.02, vol = 0.3, expiry = 1.0;
+
+struct Estimate
+{
+  double mean, stderror, seconds;
+};
+
+template <typename PRICER>
+static Estimate simulate(PRICER& pricer, unsigned long npaths)
+{
+  MeanVarCalculator<double*> stats(1);
+  Estimate est;
+  est.seconds = secondsPerCall([&] {
+    stats.reset();
+    pricer.simulate(stats, npaths);
+  }, 1, 1);
+  Matrix const& results = stats.results();
+  est.mean = results(0, 0);
+  est.stderror = std::sqrt(results(1, 0) / stats.nSamples());
+  return est;
+}
+
+static Estimate priceBs(SPtrProduct prod, McParams const& mcparams, unsigned long npaths)
+{
+  SPtrYieldCurve discountCurve(new YieldCurve(&expiry, &expiry + 1, &rate, &rate + 1,
+                                              YieldCurve::InputType::SPOTRATE));
+  SPtrVolatilityTermStructure volTS(new VolatilityTermStructure(&expiry, &expiry + 1, &vol, &vol + 1));
+  BsMcPricer pricer(prod, discountCurve, divyield, volTS, spot, mcparams);
+  return simulate(pricer, npaths);
+}
+
+static Estimate priceMultiAsset(SPtrProduct prod, McParams const& mcparams, unsigned long npaths)
+{
+  SPtrYieldCurve discountCurve(new YieldCurve(&expiry, &expiry + 1, &rate, &rate + 1,
+                                              YieldCurve::InputType::SPOTRATE));
+  MultiAssetBsMcPricer pricer(prod, discountCurve, Vector{ divyield }, Vector{ vol }, Vector{ spot },
+                              Matrix(1, 1, arma::fill::ones), mcparams);
+  return simulate(pricer, npaths);
+}
+
+int main()
+{
+  BenchChecks checks;
+  const unsigned long npaths = 200000;
+  Vector fixings = arma::regspace(1.0 / 52, 1.0 / 52, expiry);
+  fixings[fixings.n_elem - 1] = expiry;
+
+  // a down-and-out call with weekly monitoring: about half of the paths are knocked out
+  SPtrProduct barrier(new BarrierCallPut(1, 100.0, -1, 90.0, fixings));
+  SPtrProduct noTermination(new BarrierNoTermination(1, 100.0, -1, 90.0, fixings));
+
+  std::printf("down-and-out call, 52 fixings    with termination       without termination\n");
+  for (auto cvtype : { McParams::ControlVarType::NONE, McParams::ControlVarType::CONDITIONAL }) {
+    McParams mcparams(McParams::UrngType::MT19937, McParams::PathGenType::EULER, cvtype);
+    bool conditional = cvtype == McParams::ControlVarType::CONDITIONAL;
+    for (int multi = 0; multi < 2; ++multi) {
+      auto price = multi ? priceMultiAsset : priceBs;
+      Estimate with = price(barrier, mcparams, npaths);
+      Estimate without = price(noTermination, mcparams, npaths);
+      std::string name = std::string(multi ? "MultiAssetBsMcPricer" : "BsMcPricer")
+        + (conditional ? ", conditional" : "");
+      std::printf("%-33s %.6f (%.4f) %.3fs   %.6f (%.4f) %.3fs\n", name.c_str(), with.mean,
+        with.stderror, with.seconds, without.mean, without.stderror, without.seconds);
+      checks.check(std::fabs(with.mean - without.mean) < 1.0e-12 * without.mean,
+        name + ": the same price with and without termination");
+    }
+  }
+
+  // an up-and-out call with an unreachable barrier is the European call
+  Vector call = europeanOptionBS(1, spot, 100.0, expiry, rate, divyield, vol);
+  SPtrProduct farBarrier(new BarrierCallPut(1, 100.0, 1, 1.0e6, fixings));
+  for (auto cvtype : { McParams::ControlVarType::NONE, McParams::ControlVarType::CONDITIONAL }) {
+    McParams mcparams(McParams::UrngType::MT19937, McParams::PathGenType::EULER, cvtype);
+    Estimate est = priceBs(farBarrier, mcparams, npaths);
+    std::printf("unreachable barrier: %.6f (%.4f), Black-Scholes %.6f\n", est.mean, est.stderror, call[0]);
+    checks.check(std::fabs(est.mean - call[0]) < 4.0 * est.stderror,
+      "the call with an unreachable barrier matches Black-Scholes within 4 standard errors");
+  }
+
+  return checks.exitCode();
+}
@@ -0,0 +1,88 @@
+/**
+@file  benchconditional.cpp
+@brief Checks the variance reduction of conditional Monte Carlo on a worst-of digital, and times it
+*/
+
+#include "benchutils.hpp"
+#include <orflib/pricers/multiassetbsmcpricer.hpp>
+#include <orflib/products/worstofdigitalcallput.hpp>
+#include <orflib/math/stats/meanvarcalculator.hpp>
+#include <cmath>
+
+using namespace orf;
+using UrngType = McParams::UrngType;
+using PathGenType = McParams::PathGenType;
+using ControlVarType = McParams::ControlVarType;
+
+const double expiry = 1.0, rate = 0.05;
+const Vector spots{ 100.0, 100.0, 100.0 }, divyields{ 0.02, 0.02, 0.02 }, vols{ 0.2, 0.25, 0.3 };
+
+struct Estimate
+{
+  double mean, stderror, seconds;
+};
+
+static Estimate price(SPtrProduct prod, Matrix const& correl, McParams const& mcparams,
+                      Matrix const& shift, unsigned long npaths)
+{
+  SPtrYieldCurve discountCurve(new YieldCurve(&expiry, &expiry + 1, &rate, &rate + 1,
+                                              YieldCurve::InputType::SPOTRATE));
+  MultiAssetBsMcPricer pricer(prod, discountCurve, divyields, vols, spots, correl, mcparams);
+  if (!shift.is_empty())
+    pricer.setDriftShift(shift);
+  MeanVarCalculator<double*> stats(1);
+  Estimate est;
+  est.seconds = secondsPerCall([&] {
+    stats.reset();
+    pricer.simulate(stats, npaths);
+  }, 1, 1);
+  Matrix const& results = stats.results();
+  est.mean = results(0, 0);
+  est.stderror = std::sqrt(results(1, 0) / stats.nSamples());
+  return est;
+}
+
+int main()
+{
+  BenchChecks checks;
+  const unsigned long npaths = 200000;
+  Matrix correl{ { 1.0, 0.5, 0.3 }, { 0.5, 1.0, 0.4 }, { 0.3, 0.4, 1.0 } };
+  Matrix independent = arma::eye<Matrix>(3, 3);
+
+  // a worst-of digital on the returns from 6 months to expiration: conditional Monte Carlo
+  // integrates a deviate every asset loads on, so the variance of all the assets is smoothed
+  std::printf("worst-of digital, 3 assets            plain                 conditional\n");
+  for (int type : { 1, -1 }) {
+    for (int corr = 0; corr < 2; ++corr) {
+      SPtrProduct worstof(new WorstOfDigitalCallPut(type, 0.95, 0.5, expiry, 3));
+      Matrix const& C = corr ? correl : independent;
+      std::string name = std::string(type == 1 ? "call" : "put") + (corr ? ", correlated" : ", independent");
+      Estimate plain = price(worstof, C, McParams(UrngType::MT19937, PathGenType::EULER,
+                             ControlVarType::NONE, 0, 3), Matrix(), npaths);
+      Estimate cond = price(worstof, C, McParams(UrngType::MT19937, PathGenType::EULER,
+                            ControlVarType::CONDITIONAL, 0, 3), Matrix(), npaths);
+      double ratio = plain.stderror * plain.stderror / (cond.stderror * cond.stderror);
+      std::printf("%-36s %.6f (%.4f) %.3fs   %.6f (%.4f) %.3fs  variance / %.1f\n", name.c_str(),
+        plain.mean, plain.stderror, plain.seconds, cond.mean, cond.stderror, cond.seconds, ratio);
+      double se = std::sqrt(plain.stderror * plain.stderror + cond.stderror * cond.stderror);
+      checks.check(std::fabs(plain.mean - cond.mean) < 4.0 * se,
+        name + ": the plain and conditional prices agree within 4 standard errors");
+      checks.check(ratio > 4.0, name + ": conditional Monte Carlo divides the variance by more than 4");
+    }
+  }
+
+  // importance sampling does not shift the integrated deviate, so the price stays unbiased
+  SPtrProduct put(new WorstOfDigitalCallPut(-1, 0.8, 0.5, expiry, 3));
+  Matrix shift(2, 3, arma::fill::value(-0.5));
+  Estimate plain = price(put, correl, McParams(UrngType::MT19937, PathGenType::EULER,
+                         ControlVarType::NONE, 0, 5), Matrix(), npaths);
+  Estimate shifted = price(put, correl, McParams(UrngType::MT19937, PathGenType::EULER,
+                           ControlVarType::CONDITIONAL, 0, 5), shift, npaths);
+  std::printf("put at 0.8, shifted and conditional   %.6f (%.4f)   %.6f (%.4f)\n",
+    plain.mean, plain.stderror, shifted.mean, shifted.stderror);
+  double se = std::sqrt(plain.stderror * plain.stderror + shifted.stderror * shifted.stderror);
+  checks.check(std::fabs(plain.mean - shifted.mean) < 4.0 * se,
+    "drift shift: the plain and the shifted conditional prices agree within 4 standard errors");
+
+  return checks.exitCode();
+}
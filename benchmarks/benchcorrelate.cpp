@@ -0,0 +1,89 @@
+/**
+@file  benchcorrelate.cpp
+@brief Benchmark of the dense product correlating the deviates of the path generators
+*/
+
+#include "benchutils.hpp"
+#include <orflib/methods/montecarlo/eulerpathgenerator.hpp>
+#include <cmath>
+
+using namespace orf;
+
+// gives access to the correlation of one path and of a batch
+class BenchPathGenerator : public EulerPathGenerator<NormalRngMt19937>
+{
+public:
+  using EulerPathGenerator<NormalRngMt19937>::EulerPathGenerator;
+  using EulerPathGenerator<NormalRngMt19937>::correlate;
+};
+
+// the triple loop the dense product replaced, in place from the last factor
+static void loopCorrelate(Matrix const& sqrtCorrel, Matrix& path)
+{
+  size_t nfactors = sqrtCorrel.n_rows;
+  for (size_t i = 0; i < path.n_rows; ++i) {
+    for (size_t j = 0; j < nfactors; ++j) {
+      double sum = 0.0;
+      for (size_t k = 0; k < nfactors; ++k)
+        sum += sqrtCorrel(nfactors - j - 1, k) * path(i, k);
+      path(i, nfactors - j - 1) = sum;
+    }
+  }
+}
+
+int main()
+{
+  BenchChecks checks;
+  const size_t batchsize = 1024;
+  Vector times = arma::regspace(1.0 / 12, 1.0 / 12, 1.0);
+  arma::arma_rng::set_seed(42);
+
+  std::printf("assets  steps  loop us/path  gemm us/path  batch us/path  "
+    "speedup path  speedup batch  max diff\n");
+  for (size_t nassets : { 10, 50, 100, 200 }) {
+    Matrix correl(nassets, nassets);
+    for (size_t i = 0; i < nassets; ++i)
+      for (size_t j = 0; j < nassets; ++j)
+        correl(i, j) = i == j ? 1.0 : 0.3 + 0.2 * std::exp(-std::fabs(double(i) - double(j)));
+    BenchPathGenerator pathgen(times.begin(), times.end(), nassets, correl);
+    Matrix const& sqrtCorrel = pathgen.sqrtCorrelation();
+
+    // the batch is checked slice by slice against the loop on each path
+    Cube devs = arma::randn<Cube>(batchsize, nassets, times.n_elem), batch = devs;
+    pathgen.correlate(batch);
+    Matrix path(times.n_elem, nassets), loopPath(times.n_elem, nassets);
+    double maxdiff = 0.0;
+    for (size_t p = 0; p < batchsize; p += 97) {
+      for (size_t i = 0; i < times.n_elem; ++i)
+        path.row(i) = devs.slice(i).row(p);
+      loopPath = path;
+      loopCorrelate(sqrtCorrel, loopPath);
+      pathgen.correlate(path);
+      maxdiff = std::max(maxdiff, arma::abs(path - loopPath).max());
+      for (size_t i = 0; i < times.n_elem; ++i)
+        maxdiff = std::max(maxdiff, arma::abs(batch.slice(i).row(p) - loopPath.row(i)).max());
+    }
+
+    size_t reps = size_t(2.0e7 / (nassets * nassets * times.n_elem)) + 1;
+    Matrix path0 = path;
+    double tloop = secondsPerCall([&] {
+      loopPath = path0;
+      loopCorrelate(sqrtCorrel, loopPath);
+    }, reps);
+    double tgemm = secondsPerCall([&] {
+      path = path0;
+      pathgen.correlate(path);
+    }, reps);
+    double tbatch = secondsPerCall([&] {
+      batch = devs;
+      pathgen.correlate(batch);
+    }, std::max<size_t>(1, reps / batchsize)) / batchsize;
+    std::printf("%6zu  %5u  %12.2f  %12.2f  %13.3f  %11.1fx  %12.1fx  %.1e\n",
+      nassets, times.n_elem, tloop * 1.0e6, tgemm * 1.0e6, tbatch * 1.0e6,
+      tloop / tgemm, tloop / tbatch, maxdiff);
+    checks.check(maxdiff < 1.0e-12,
+      std::to_string(nassets) + " assets: dense products match the triple loop");
+  }
+
+  return checks.exitCode();
+}
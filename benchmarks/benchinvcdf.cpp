@@ -0,0 +1,89 @@
+/**
+@file  benchinvcdf.cpp
+@brief Benchmark of the batched inverse normal cdf against the scalar one
+*/
+
+#include "benchutils.hpp"
+#include <orflib/math/stats/normaldistribution.hpp>
+#include <orflib/math/random/rng.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace orf;
+
+// the quantile of p by Newton iterations on the long double erfc, from the guess x
+static long double refQuantile(double p, long double x)
+{
+  for (int k = 0; k < 5; ++k) {
+    long double cdf = 0.5L * std::erfc(-x / std::sqrt(2.0L));
+    long double pdf = std::exp(-0.5L * x * x) / std::sqrt(2.0L * 3.14159265358979323846L);
+    if (pdf == 0.0L)
+      break;
+    x -= (cdf - p) / pdf;
+  }
+  return x;
+}
+
+int main()
+{
+  BenchChecks checks;
+  NormalDistribution normal;
+
+  // accuracy over the whole range, including the far tails
+  std::vector<double> probs;
+  for (int e = -300; e <= -1; ++e) {
+    probs.push_back(std::pow(10.0, e));
+    if (e >= -16)
+      probs.push_back(1.0 - std::pow(10.0, e));
+  }
+  for (int i = 1; i < 100000; ++i)
+    probs.push_back(i / 100000.0);
+  std::vector<double> quants(probs);
+  normal.invcdf(quants.begin(), quants.end());
+  double batchErr = 0.0, scalarErr = 0.0;
+  for (size_t i = 0; i < probs.size(); ++i) {
+    double ref = static_cast<double>(refQuantile(probs[i], quants[i]));
+    if (ref == 0.0)
+      continue;
+    batchErr = std::max(batchErr, std::fabs(quants[i] / ref - 1.0));
+    scalarErr = std::max(scalarErr, std::fabs(normal.invcdf(probs[i]) / ref - 1.0));
+  }
+  std::printf("max relative error for p in [1e-300, 1 - 1e-16]: batched %.2e, scalar %.2e\n",
+    batchErr, scalarErr);
+  checks.check(batchErr < 1.0e-14, "batched invcdf relative error below 1e-14");
+
+  // throughput on uniform deviates
+  size_t n = size_t(1) << 16;
+  std::vector<double> uniforms(n), values(n);
+  std::mt19937 urng(1);
+  std::uniform_real_distribution<double> unif(0.0, 1.0);
+  for (double& u : uniforms)
+    do u = unif(urng); while (u == 0.0);
+  double sink = 0.0;
+  double tscalar = secondsPerCall([&] {
+    for (size_t i = 0; i < n; ++i)
+      values[i] = normal.invcdf(uniforms[i]);
+    sink += values[0];
+  }, 20);
+  double tbatch = secondsPerCall([&] {
+    values = uniforms;
+    normal.invcdf(values.begin(), values.end());
+    sink += values[0];
+  }, 20);
+  std::printf("ns per value: scalar %.2f, batched %.2f, speedup %.1fx\n",
+    tscalar * 1.0e9 / n, tbatch * 1.0e9 / n, tscalar / tbatch);
+
+  // the Sobol normal rng, which uses the batched invcdf
+  size_t dim = 64;
+  NormalRngSobol sobol(dim);
+  std::vector<double> point(dim);
+  double tsobol = secondsPerCall([&] {
+    sobol.next(point.begin(), point.end());
+    sink += point[0];
+  }, 1 << 14);
+  std::printf("NormalRngSobol, dimension %zu: %.2f ns per deviate (%g)\n",
+    dim, tsobol * 1.0e9 / dim, sink);
+
+  return checks.exitCode();
+}
@@ -0,0 +1,72 @@
+/**
+@file  benchmlmc.cpp
+@brief Checks the multilevel Monte Carlo pricer against the Monte Carlo pricer, and times both
+*/
+
+#include "benchutils.hpp"
+#include <orflib/pricers/bsmcpricer.hpp>
+#include <orflib/pricers/bsmlmcpricer.hpp>
+#include <orflib/products/asianbasketcallput.hpp>
+#include <orflib/math/stats/meanvarcalculator.hpp>
+#include <cmath>
+
+using namespace orf;
+using UrngType = McParams::UrngType;
+using PathGenType = McParams::PathGenType;
+using ControlVarType = McParams::ControlVarType;
+
+int main()
+{
+  BenchChecks checks;
+  const double spot = 100.0, rate = 0.05, divyield = 0.02, vol = 0.3, expiry = 1.0, rmse = 0.02;
+  SPtrYieldCurve discountCurve(new YieldCurve(&expiry, &expiry + 1, &rate, &rate + 1,
+                                              YieldCurve::InputType::SPOTRATE));
+  SPtrVolatilityTermStructure volTS(new VolatilityTermStructure(&expiry, &expiry + 1, &vol, &vol + 1));
+  // an Asian call with daily fixings, the case multilevel Monte Carlo is for
+  Vector fixings = arma::regspace(1.0, 1.0, 256.0) / 256.0;
+  SPtrProduct asian(new AsianBasketCallPut(1, 100.0, fixings, Vector{ 1.0 }));
+
+  std::vector<McParams> configs{
+    McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::NONE, 0, 11),
+    McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::ANTITHETIC, 0, 11),
+    McParams(UrngType::PHILOX, PathGenType::EULER, ControlVarType::NONE, 0, 11),
+  };
+  std::vector<std::string> names{ "MT19937", "MT19937, antithetic", "Philox" };
+  std::printf("Asian call, 256 fixings, error %.2f   multilevel                Monte Carlo\n", rmse);
+  for (size_t c = 0; c < configs.size(); ++c) {
+    double mlmcmean = 0.0, mlmcerr = 0.0;
+    size_t nlevels = 0;
+    double tmlmc = secondsPerCall([&] {
+      BsMlmcPricer pricer(asian, discountCurve, divyield, volTS, spot, configs[c]);
+      mlmcmean = pricer.simulate(rmse);
+      mlmcerr = pricer.stdErr();
+      nlevels = pricer.nLevels();
+    }, 1, 1);
+
+    // the run is reproducible for a given seed
+    BsMlmcPricer again(asian, discountCurve, divyield, volTS, spot, configs[c]);
+    checks.check(again.simulate(rmse) == mlmcmean, names[c] + ": the same multilevel price on the same seed");
+
+    BsMcPricer pricer(asian, discountCurve, divyield, volTS, spot, configs[c]);
+    MeanVarCalculator<double*> stats(pricer.nVariables());
+    unsigned long npaths = 0;
+    double tmc = secondsPerCall([&] {
+      stats.reset();
+      npaths = pricer.simulateToTolerance(stats, McErrorTarget(rmse));
+    }, 1, 1);
+    double mcmean = stats.results()(0, 0);
+    double mcerr = std::sqrt(stats.results()(1, 0) / stats.nSamples());
+
+    std::printf("%-36s %.4f (%.4f) %zu levels %.2fs   %.4f (%.4f) %lu paths %.2fs  speedup %.1fx\n",
+      names[c].c_str(), mlmcmean, mlmcerr, nlevels, tmlmc, mcmean, mcerr, npaths, tmc, tmc / tmlmc);
+    checks.check(mlmcerr <= rmse, names[c] + ": the multilevel standard error is within the target");
+    checks.check(std::fabs(mlmcmean - mcmean) < 4.0 * std::sqrt(mlmcerr * mlmcerr + mcerr * mcerr),
+      names[c] + ": the multilevel and Monte Carlo prices agree within 4 standard errors");
+    // the coarse levels evaluate the average on their simulated fixings only, so a path of level l
+    // costs 2^l fixings instead of 256: about 20 times faster with MT19937, a third of that with
+    // Philox, whose cost per point of one dimension weighs on the coarse levels
+    checks.check(tmc > 4.0 * tmlmc, names[c] + ": the multilevel pricer is at least 4 times faster");
+  }
+
+  return checks.exitCode();
+}
@@ -0,0 +1,138 @@
+/**
+@file  benchportfolio.cpp
+@brief Checks the portfolio pricer against the multiasset pricer, and times both
+*/
+
+#include "benchutils.hpp"
+#include <orflib/pricers/multiassetbsmcpricer.hpp>
+#include <orflib/pricers/portfoliobsmcpricer.hpp>
+#include <orflib/products/asianbasketcallput.hpp>
+#include <orflib/products/worstofdigitalcallput.hpp>
+#include <orflib/math/stats/meanvarcalculator.hpp>
+#include <cmath>
+
+using namespace orf;
+using UrngType = McParams::UrngType;
+using PathGenType = McParams::PathGenType;
+using ControlVarType = McParams::ControlVarType;
+
+const double expiry = 1.0, rate = 0.05;
+const Vector spots{ 100.0, 100.0, 100.0 }, divyields{ 0.02, 0.02, 0.02 }, vols{ 0.2, 0.25, 0.3 };
+
+static Matrix correlation()
+{
+  Matrix correl(3, 3);
+  correl.fill(0.5);
+  correl.diag().ones();
+  return correl;
+}
+
+// the means and standard errors of the variables of a simulation, and its time
+struct Estimates
+{
+  Vector means, stderrs;
+  double seconds;
+};
+
+template <typename PRICER>
+static Estimates simulate(PRICER& pricer, unsigned long npaths)
+{
+  MeanVarCalculator<double*> stats(pricer.nVariables());
+  Estimates est;
+  est.seconds = secondsPerCall([&] {
+    stats.reset();
+    pricer.simulate(stats, npaths);
+  }, 1, 1);
+  Matrix const& results = stats.results();
+  est.means = results.row(0).t();
+  est.stderrs = arma::sqrt(results.row(1).t() / double(stats.nSamples()));
+  return est;
+}
+
+// prices each product on its own, with the seed of the portfolio
+static Estimates priceEach(std::vector<SPtrProduct> const& prods, McParams const& mcparams,
+                           unsigned long npaths)
+{
+  SPtrYieldCurve discountCurve(new YieldCurve(&expiry, &expiry + 1, &rate, &rate + 1,
+                                              YieldCurve::InputType::SPOTRATE));
+  Estimates est;
+  est.means.set_size(prods.size());
+  est.stderrs.set_size(prods.size());
+  est.seconds = 0.0;
+  for (size_t k = 0; k < prods.size(); ++k) {
+    MultiAssetBsMcPricer pricer(prods[k], discountCurve, divyields, vols, spots, correlation(), mcparams);
+    Estimates one = simulate(pricer, npaths);
+    est.means[k] = one.means[0];
+    est.stderrs[k] = one.stderrs[0];
+    est.seconds += one.seconds;
+  }
+  return est;
+}
+
+static Estimates pricePortfolio(std::vector<SPtrProduct> const& prods, Vector const& quantities,
+                                McParams const& mcparams, unsigned long npaths)
+{
+  SPtrYieldCurve discountCurve(new YieldCurve(&expiry, &expiry + 1, &rate, &rate + 1,
+                                              YieldCurve::InputType::SPOTRATE));
+  PortfolioBsMcPricer pricer(prods, discountCurve, divyields, vols, spots, correlation(), mcparams,
+                             quantities);
+  return simulate(pricer, npaths);
+}
+
+int main()
+{
+  BenchChecks checks;
+  const unsigned long npaths = 100000;
+  Vector fixings = arma::regspace(1.0, 1.0, 12.0) / 12.0;
+  Vector basket{ 0.4, 0.3, 0.3 };
+
+  // products fixing on the same grid see the same paths in both pricers, which then agree exactly
+  std::vector<SPtrProduct> sameGrid{
+    SPtrProduct(new AsianBasketCallPut(1, 100.0, fixings, basket)),
+    SPtrProduct(new AsianBasketCallPut(-1, 95.0, fixings, basket)),
+    SPtrProduct(new AsianBasketCallPut(1, 110.0, fixings, Vector{ 1.0, 0.0, 0.0 })),
+  };
+  Vector quantities{ 1.0, -2.0, 0.5 };
+  std::vector<McParams> configs{
+    McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::NONE, 0, 7),
+    McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::ANTITHETIC, 0, 7),
+    McParams(UrngType::SOBOL, PathGenType::BROWNIANBRIDGE, ControlVarType::NONE),
+  };
+  std::vector<std::string> names{ "MT19937", "MT19937, antithetic", "Sobol, Brownian bridge" };
+  std::printf("3 Asian baskets, same fixings     portfolio          one pricer per product\n");
+  for (size_t c = 0; c < configs.size(); ++c) {
+    Estimates pt = pricePortfolio(sameGrid, quantities, configs[c], npaths);
+    Estimates each = priceEach(sameGrid, configs[c], npaths);
+    double maxdiff = arma::abs(pt.means.head(sameGrid.size()) - each.means).max();
+    double ptpv = arma::dot(quantities, each.means);
+    std::printf("%-33s %.6f %.3fs   %.6f %.3fs\n", names[c].c_str(), pt.means[sameGrid.size()],
+      pt.seconds, ptpv, each.seconds);
+    checks.check(maxdiff < 1.0e-12 * arma::abs(each.means).max(),
+      names[c] + ": the same product prices on the same seed");
+    checks.check(std::fabs(pt.means[sameGrid.size()] - ptpv) < 1.0e-12 * std::fabs(ptpv),
+      names[c] + ": the portfolio price is the sum of the product prices");
+  }
+
+  // products on different grids: the portfolio simulates on the merged grid, so the prices agree
+  // within the standard errors only
+  std::vector<SPtrProduct> mixedGrid{
+    SPtrProduct(new AsianBasketCallPut(1, 100.0, fixings, basket)),
+    SPtrProduct(new AsianBasketCallPut(1, 100.0, Vector{ 0.5 }, basket)),
+    SPtrProduct(new WorstOfDigitalCallPut(1, 1.0, 0.8, expiry, 3)),
+  };
+  McParams mcparams(UrngType::MT19937, PathGenType::EULER, ControlVarType::NONE, 0, 7);
+  Estimates pt = pricePortfolio(mixedGrid, Vector(), mcparams, npaths);
+  Estimates each = priceEach(mixedGrid, mcparams, npaths);
+  std::printf("Asian, European basket, worst-of  portfolio %.3fs, one pricer per product %.3fs\n",
+    pt.seconds, each.seconds);
+  bool agree = true;
+  for (size_t k = 0; k < mixedGrid.size(); ++k) {
+    double se = std::sqrt(pt.stderrs[k] * pt.stderrs[k] + each.stderrs[k] * each.stderrs[k]);
+    std::printf("  product %zu: %.6f (%.4f)   %.6f (%.4f)\n", k, pt.means[k], pt.stderrs[k],
+      each.means[k], each.stderrs[k]);
+    agree = agree && std::fabs(pt.means[k] - each.means[k]) < 4.0 * se;
+  }
+  checks.check(agree, "products on different grids: the same prices within 4 standard errors");
+
+  return checks.exitCode();
+}
@@ -0,0 +1,236 @@
+/**
+@file  benchstatic.cpp
+@brief Benchmark of statically dispatched Monte Carlo pipelines against the virtual calls of BsMcPricer
+*/
+
+#include "benchutils.hpp"
+#include <orflib/pricers/bsmcpricer.hpp>
+#include <orflib/methods/montecarlo/eulerpathgenerator.hpp>
+#include <orflib/products/asianbasketcallput.hpp>
+#include <orflib/products/europeancallput.hpp>
+#include <orflib/math/stats/meanvarcalculator.hpp>
+#include <cmath>
+
+using namespace orf;
+using UrngType = McParams::UrngType;
+using PathGenType = McParams::PathGenType;
+using ControlVarType = McParams::ControlVarType;
+
+/** The discount factors and the log drifts and standard deviations from fixing to fixing,
+    as BsMcPricer computes them
+*/
+class BsModel
+{
+public:
+  BsModel(Product const& prod, SPtrYieldCurve discountCurve, double divYield,
+          SPtrVolatilityTermStructure volatility, double spot)
+  : spot_(spot)
+  {
+    Vector const& paytimes = prod.payTimes();
+    discfactors_.resize(paytimes.size());
+    for (size_t i = 0; i < paytimes.size(); ++i)
+      discfactors_[i] = discountCurve->discount(paytimes[i]);
+    Vector const& fixtimes = prod.fixTimes();
+    double t1 = 0.0;
+    drifts_.resize(fixtimes.size());
+    stdevs_.resize(fixtimes.size());
+    for (size_t i = 0; i < fixtimes.size(); ++i) {
+      double t2 = fixtimes[i];
+      double fwdvol = volatility->fwdVol(t1, t2);
+      double var = fwdvol * fwdvol * (t2 - t1);
+      stdevs_[i] = std::sqrt(var);
+      double fwdrate = t2 > t1 ? discountCurve->fwdRate(t1, t2) : 0.0;
+      drifts_[i] = (fwdrate - divYield) * (t2 - t1) - 0.5 * var;
+      t1 = t2;
+    }
+  }
+
+protected:
+  double spot_;
+  Vector discfactors_;
+  Vector drifts_;
+  Vector stdevs_;
+};
+
+/** The batch pipeline of BsMcPricer with the product and path generator held by value and called
+    with qualified names, so the compiler binds and can inline the calls. It draws the same random
+    stream, so its PVs are those of BsMcPricer without Greeks and variance reduction.
+*/
+template <typename PRODUCT, typename NRNG>
+class StaticBatchPricer : public BsModel
+{
+public:
+  StaticBatchPricer(PRODUCT const& prod, SPtrYieldCurve discountCurve, double divYield,
+                    SPtrVolatilityTermStructure volatility, double spot)
+  : BsModel(prod, discountCurve, divYield, volatility, spot), prod_(prod),
+    pathgen_(prod.fixTimes().begin(), prod.fixTimes().end(), 1)
+  {}
+
+  void simulate(MeanVarCalculator<double*>& stats, unsigned long npaths)
+  {
+    samples_.set_size(McParams::PATHBLOCKSIZE, 1);
+    for (unsigned long k = 0; k < npaths; k += McParams::PATHBLOCKSIZE) {
+      size_t n = std::min<unsigned long>(McParams::PATHBLOCKSIZE, npaths - k);
+      pathgen_.EulerPathGenerator<NRNG>::nextBatch(n, paths_);
+      prod_.PRODUCT::resetState(n, states_);
+      currspots_.set_size(n, 1);
+      double* spots = currspots_.colptr(0);
+      std::fill(spots, spots + n, spot_);
+      for (size_t i = 0; i < paths_.n_slices; ++i) {
+        double const* devs = paths_.slice_colptr(i, 0);
+        double drift = drifts_[i];
+        double stdev = stdevs_[i];
+        for (size_t p = 0; p < n; ++p)
+          spots[p] = spots[p] * std::exp(drift + stdev * devs[p]);
+        prod_.PRODUCT::updateState(i, currspots_, states_);
+      }
+      prod_.PRODUCT::finalizeState(states_, payamts_);
+      double* pvs = samples_.colptr(0);
+      for (size_t p = 0; p < n; ++p)
+        pvs[p] = discfactors_[0] * payamts_(p, 0);
+      stats.addSamples(samples_, 0, n);
+    }
+  }
+
+private:
+  PRODUCT prod_;
+  EulerPathGenerator<NRNG> pathgen_;
+  Cube paths_;
+  Matrix currspots_;
+  Matrix states_;
+  Matrix payamts_;
+  Matrix samples_;
+};
+
+// the payoffs of the fused pipeline, which updates them one spot at a time
+struct EuropeanPayoff
+{
+  double strike, last;
+  void reset() {}
+  void update(double spot) { last = spot; }
+  double payoff(size_t) const { return last > strike ? last - strike : 0.0; }
+};
+
+struct AsianPayoff
+{
+  double strike, sum;
+  void reset() { sum = 0.0; }
+  void update(double spot) { sum += spot; }
+  double payoff(size_t nfixings) const
+  {
+    double avg = sum / nfixings;
+    return avg > strike ? avg - strike : 0.0;
+  }
+};
+
+/** A fused pipeline, one path at a time from the deviates to the PV, with the payoff inlined.
+    The normal rng draws the deviates of each path in the order of EulerPathGenerator, so its PVs
+    are those of BsMcPricer too.
+*/
+template <typename PAYOFF, typename NRNG>
+class FusedPathPricer : public BsModel
+{
+public:
+  FusedPathPricer(Product const& prod, PAYOFF const& payoff, SPtrYieldCurve discountCurve,
+                  double divYield, SPtrVolatilityTermStructure volatility, double spot)
+  : BsModel(prod, discountCurve, divYield, volatility, spot), payoff_(payoff),
+    nrng_(prod.fixTimes().size()), devs_(prod.fixTimes().size())
+  {}
+
+  void simulate(MeanVarCalculator<double*>& stats, unsigned long npaths)
+  {
+    size_t nfix = devs_.size();
+    samples_.set_size(McParams::PATHBLOCKSIZE, 1);
+    for (unsigned long k = 0; k < npaths; k += McParams::PATHBLOCKSIZE) {
+      size_t n = std::min<unsigned long>(McParams::PATHBLOCKSIZE, npaths - k);
+      double* pvs = samples_.colptr(0);
+      for (size_t p = 0; p < n; ++p) {
+        nrng_.next(devs_.begin(), devs_.end());
+        payoff_.reset();
+        double spot = spot_;
+        for (size_t i = 0; i < nfix; ++i) {
+          spot = spot * std::exp(drifts_[i] + stdevs_[i] * devs_[i]);
+          payoff_.update(spot);
+        }
+        pvs[p] = discfactors_[0] * payoff_.payoff(nfix);
+      }
+      stats.addSamples(samples_, 0, n);
+    }
+  }
+
+private:
+  PAYOFF payoff_;
+  NRNG nrng_;
+  Vector devs_;
+  Matrix samples_;
+};
+
+const double spot = 100.0, strike = 100.0, rate = 0.05, divyield = 0.02, vol = 0.2, expiry = 1.0;
+
+/** Times the three pipelines on npaths paths, prints the nanoseconds per path and checks that
+    they price the same
+*/
+template <typename PRODUCT, typename PAYOFF, typename NRNG>
+static void compare(std::string const& name, PRODUCT const& prod, PAYOFF const& payoff, UrngType urngType,
+                    unsigned long npaths, BenchChecks& checks)
+{
+  SPtrYieldCurve discountCurve(new YieldCurve(&expiry, &expiry + 1, &rate, &rate + 1,
+                                              YieldCurve::InputType::SPOTRATE));
+  SPtrVolatilityTermStructure volTS(new VolatilityTermStructure(&expiry, &expiry + 1, &vol, &vol + 1));
+  MeanVarCalculator<double*> stats(1);
+  double means[3], nsecs[3];
+
+  McParams mcparams(urngType, PathGenType::EULER, ControlVarType::NONE);
+  double secs = secondsPerCall([&] {
+    BsMcPricer pricer(SPtrProduct(new PRODUCT(prod)), discountCurve, divyield, volTS, spot, mcparams);
+    stats.reset();
+    pricer.simulate(stats, npaths);
+  }, 1);
+  means[0] = stats.results()(0, 0);
+  nsecs[0] = 1.0e9 * secs / npaths;
+
+  secs = secondsPerCall([&] {
+    StaticBatchPricer<PRODUCT, NRNG> pricer(prod, discountCurve, divyield, volTS, spot);
+    stats.reset();
+    pricer.simulate(stats, npaths);
+  }, 1);
+  means[1] = stats.results()(0, 0);
+  nsecs[1] = 1.0e9 * secs / npaths;
+
+  secs = secondsPerCall([&] {
+    FusedPathPricer<PAYOFF, NRNG> pricer(prod, payoff, discountCurve, divyield, volTS, spot);
+    stats.reset();
+    pricer.simulate(stats, npaths);
+  }, 1);
+  means[2] = stats.results()(0, 0);
+  nsecs[2] = 1.0e9 * secs / npaths;
+
+  std::printf("%-24s %8.1f %8.1f %8.1f    %.1fx    %.1fx\n", name.c_str(), nsecs[0], nsecs[1], nsecs[2],
+    nsecs[0] / nsecs[1], nsecs[0] / nsecs[2]);
+  for (int k = 1; k < 3; ++k)
+    checks.check(std::fabs(means[k] - means[0]) < 1.0e-12 * means[0],
+      name + (k == 1 ? ": the static batch" : ": the fused") + " pipeline prices as BsMcPricer");
+}
+
+int main()
+{
+  BenchChecks checks;
+  const unsigned long npaths = 1 << 20;
+  Vector fixings = arma::regspace(1.0, 1.0, 52.0) / 52.0;
+  EuropeanCallPut euro(1, strike, expiry);
+  AsianBasketCallPut asian(1, strike, fixings, Vector{ 1.0 });
+
+  // the decision to keep BsMcPricer dynamic rests on these timings: it makes one virtual call per
+  // batch of paths, so inlining the pipeline saves nothing next to the random numbers and exp
+  std::printf("ns per path                BsMcPricer  static    fused   static  fused speedup\n");
+  compare<EuropeanCallPut, EuropeanPayoff, NormalRngMt19937>("European, MT19937", euro,
+    EuropeanPayoff{ strike, 0.0 }, UrngType::MT19937, npaths, checks);
+  compare<EuropeanCallPut, EuropeanPayoff, NormalRngPhilox>("European, Philox", euro,
+    EuropeanPayoff{ strike, 0.0 }, UrngType::PHILOX, npaths, checks);
+  compare<AsianBasketCallPut, AsianPayoff, NormalRngMt19937>("Asian 52, MT19937", asian,
+    AsianPayoff{ strike, 0.0 }, UrngType::MT19937, npaths / 16, checks);
+  compare<AsianBasketCallPut, AsianPayoff, NormalRngPhilox>("Asian 52, Philox", asian,
+    AsianPayoff{ strike, 0.0 }, UrngType::PHILOX, npaths / 16, checks);
+
+  return checks.exitCode();
+}
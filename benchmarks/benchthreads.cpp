@@ -0,0 +1,95 @@
+/**
+@file  benchthreads.cpp
+@brief Checks that the block-partitioned simulation does not depend on the number of threads
+*/
+
+#include "benchutils.hpp"
+#include <orflib/pricers/bsmcpricer.hpp>
+#include <orflib/products/americancallput.hpp>
+#include <orflib/products/asianbasketcallput.hpp>
+#include <orflib/products/barriercallput.hpp>
+#include <orflib/products/europeancallput.hpp>
+#include <orflib/math/stats/meanvarcalculator.hpp>
+#include <cmath>
+#include <thread>
+
+using namespace orf;
+using UrngType = McParams::UrngType;
+using PathGenType = McParams::PathGenType;
+using ControlVarType = McParams::ControlVarType;
+
+int main()
+{
+  BenchChecks checks;
+  const unsigned long npaths = 20 * McParams::PATHBLOCKSIZE + 100;
+  double expiry = 1.0, rate = 0.05, vol = 0.2;
+  SPtrYieldCurve discountCurve(new YieldCurve(&expiry, &expiry + 1, &rate, &rate + 1,
+                                              YieldCurve::InputType::SPOTRATE));
+  SPtrVolatilityTermStructure volTS(new VolatilityTermStructure(&expiry, &expiry + 1, &vol, &vol + 1));
+  Vector fixings = arma::regspace(1.0, 1.0, 12.0) / 12.0;
+
+  struct Config
+  {
+    std::string name;
+    SPtrProduct prod;
+    McParams mcparams;
+  };
+  std::vector<Config> configs;
+  std::vector<std::pair<std::string, UrngType>> urngs{
+    { "MT19937", UrngType::MT19937 }, { "Sobol", UrngType::SOBOL },
+    { "Philox", UrngType::PHILOX }, { "Latin hypercube", UrngType::LATINHYPERCUBE } };
+  std::vector<std::pair<std::string, ControlVarType>> cvtypes{
+    { "", ControlVarType::NONE }, { ", antithetic", ControlVarType::ANTITHETIC },
+    { ", control variate", ControlVarType::CONTROLVARIATE } };
+  for (auto const& urng : urngs)
+    for (auto const& cvtype : cvtypes)
+      configs.push_back({ "Asian, " + urng.first + cvtype.first,
+        SPtrProduct(new AsianBasketCallPut(1, 100.0, fixings, Vector{ 1.0 })),
+        McParams(urng.second, PathGenType::BROWNIANBRIDGE, cvtype.second) });
+  configs.push_back({ "European, MT19937, Greeks", SPtrProduct(new EuropeanCallPut(1, 100.0, expiry)),
+    McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::NONE, 0, 0, true) });
+  configs.push_back({ "barrier, Philox, conditional", SPtrProduct(new BarrierCallPut(1, 100.0, -1, 90.0, fixings)),
+    McParams(UrngType::PHILOX, PathGenType::EULER, ControlVarType::CONDITIONAL) });
+  configs.push_back({ "American, MT19937, LSM", SPtrProduct(new AmericanCallPut(-1, 100.0, expiry)),
+    McParams(UrngType::MT19937, PathGenType::EULER, ControlVarType::NONE) });
+
+  // the results on one thread are the reference, the other thread counts must match them bit by bit
+  const size_t maxthreads = 4;
+  std::printf("%zu hardware threads, %lu paths\n", size_t(std::thread::hardware_concurrency()), npaths);
+  for (Config& config : configs) {
+    Matrix reference;
+    bool same = true;
+    for (size_t nthreads = 1; nthreads <= maxthreads; ++nthreads) {
+      config.mcparams.nThreads = nthreads;
+      config.mcparams.seed = 17;
+      BsMcPricer pricer(config.prod, discountCurve, 0.02, volTS, 100.0, config.mcparams);
+      MeanVarCalculator<double*> stats(pricer.nVariables());
+      pricer.simulate(stats, npaths);
+      Matrix const& results = stats.results();
+      if (nthreads == 1)
+        reference = results;
+      else
+        same = same && arma::approx_equal(results, reference, "absdiff", 0.0);
+    }
+    std::printf("%-40s %.6f (%.4f)\n", config.name.c_str(), reference(0, 0),
+      std::sqrt(reference(1, 0) / npaths));
+    checks.check(same, config.name + ": the same results on 1 to " + std::to_string(maxthreads) + " threads");
+  }
+
+  // the error-targeted simulation stops at the same path
+  McParams mcparams(UrngType::MT19937, PathGenType::EULER, ControlVarType::NONE, 1, 17);
+  SPtrProduct call(new EuropeanCallPut(1, 100.0, expiry));
+  unsigned long stopped[2];
+  double means[2];
+  for (int k = 0; k < 2; ++k) {
+    mcparams.nThreads = k == 0 ? 1 : maxthreads;
+    BsMcPricer pricer(call, discountCurve, 0.02, volTS, 100.0, mcparams);
+    MeanVarCalculator<double*> stats(pricer.nVariables());
+    stopped[k] = pricer.simulateToTolerance(stats, McErrorTarget(0.05));
+    means[k] = stats.results()(0, 0);
+  }
+  checks.check(stopped[0] == stopped[1] && means[0] == means[1],
+    "error target: the same paths and price on 1 and " + std::to_string(maxthreads) + " threads");
+
+  return checks.exitCode();
+}
@@ -0,0 +1,55 @@
+/**
+@file  benchutils.hpp
+@brief Timing and checking helpers shared by the benchmarks
+*/
+
+#ifndef ORF_BENCHUTILS_HPP
+#define ORF_BENCHUTILS_HPP
+
+#include <orflib/defines.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+BEGIN_NAMESPACE(orf)
+
+/** Returns the wall clock time of one call to f, in seconds, as the best of nruns averages
+    over reps calls, which filters out most of the noise of a shared machine.
+*/
+template <typename F>
+double secondsPerCall(F f, size_t reps, size_t nruns = 3)
+{
+  double best = 1.0e300;
+  for (size_t r = 0; r < nruns; ++r) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < reps; ++i)
+      f();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count() / reps);
+  }
+  return best;
+}
+
+/** Counts the failed checks of a benchmark, which returns exitCode() from main() */
+class BenchChecks
+{
+public:
+  /** Prints the outcome of a check and counts it if it failed */
+  void check(bool ok, std::string const& what)
+  {
+    std::printf("%s: %s\n", ok ? "ok" : "FAILED", what.c_str());
+    if (!ok)
+      ++nfailed_;
+  }
+
+  /** Returns 0 if all the checks passed, 1 otherwise */
+  int exitCode() const { return nfailed_ > 0 ? 1 : 0; }
+
+private:
+  size_t nfailed_ = 0;   // the number of failed checks
+};
+
+END_NAMESPACE(orf)
+
+#endif // ORF_BENCHUTILS_HPP
@@ -0,0 +1,99 @@
+/**
+@file  benchziggurat.cpp
+@brief Benchmark of the ziggurat normal sampler against std::normal_distribution
+*/
+
+#include "benchutils.hpp"
+#include <orflib/math/random/rng.hpp>
+#include <orflib/math/stats/normaldistribution.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace orf;
+
+// the chi-square statistic of the deviates on NBINS equiprobable bins of the standard normal
+static double chiSquare(std::vector<double> const& devs)
+{
+  const size_t NBINS = 100;
+  NormalDistribution normal;
+  std::vector<double> edges(NBINS - 1);
+  for (size_t i = 0; i < edges.size(); ++i)
+    edges[i] = normal.invcdf((i + 1.0) / NBINS);
+  std::vector<size_t> counts(NBINS, 0);
+  for (double x : devs)
+    ++counts[std::upper_bound(edges.begin(), edges.end(), x) - edges.begin()];
+  double expected = double(devs.size()) / NBINS, chi2 = 0.0;
+  for (size_t c : counts)
+    chi2 += (c - expected) * (c - expected) / expected;
+  return chi2;
+}
+
+// times and checks the ziggurat NormalRng<URNG> against std::normal_distribution on URNG
+template <typename URNG>
+static void benchUrng(char const* name, BenchChecks& checks)
+{
+  const size_t n = size_t(1) << 22;
+  std::vector<double> devs(n);
+  double sink = 0.0;
+
+  URNG stdurng;
+  std::normal_distribution<double> stdnormal;
+  double tstd = secondsPerCall([&] {
+    for (double& x : devs)
+      x = stdnormal(stdurng);
+    sink += devs[0];
+  }, 1);
+
+  NormalRng<URNG> zig(1);
+  double tzig = secondsPerCall([&] {
+    zig.next(devs.begin(), devs.end());
+    sink += devs[0];
+  }, 1);
+  std::printf("%-12s ns per deviate: std::normal_distribution %6.2f, ziggurat %6.2f, "
+    "speedup %.1fx (%g)\n", name, tstd * 1.0e9 / n, tzig * 1.0e9 / n, tstd / tzig, sink);
+
+  // the moments of the last batch, with bounds of about 5 standard errors
+  double m1 = 0.0, m2 = 0.0, m3 = 0.0, m4 = 0.0;
+  for (double x : devs) {
+    double x2 = x * x;
+    m1 += x;
+    m2 += x2;
+    m3 += x2 * x;
+    m4 += x2 * x2;
+  }
+  m1 /= n; m2 /= n; m3 /= n; m4 /= n;
+  double se = 5.0 / std::sqrt(double(n));
+  bool momentsOk = std::fabs(m1) < se && std::fabs(m2 - 1.0) < std::sqrt(2.0) * se
+    && std::fabs(m3) < std::sqrt(15.0) * se && std::fabs(m4 - 3.0) < std::sqrt(96.0) * se;
+  std::printf("%-12s moments: %.5f %.5f %.5f %.5f\n", name, m1, m2, m3, m4);
+  checks.check(momentsOk, std::string(name) + " ziggurat moments within 5 standard errors");
+
+  // 99 degrees of freedom: mean 99, standard deviation 14; 170 is a p-value of about 1e-5
+  double chi2 = chiSquare(devs);
+  std::printf("%-12s chi-square on 100 bins: %.1f\n", name, chi2);
+  checks.check(chi2 < 170.0, std::string(name) + " ziggurat chi-square test");
+}
+
+int main()
+{
+  BenchChecks checks;
+  benchUrng<std::minstd_rand>("minstd_rand", checks);
+  benchUrng<std::mt19937>("mt19937", checks);
+  benchUrng<std::ranlux24>("ranlux24", checks);
+  benchUrng<std::ranlux48>("ranlux48", checks);
+
+  // the ziggurat deviates are fixed by the standard URNG sequence, on any compiler
+  NormalRngMt19937 rng(4);
+  std::vector<double> first(4);
+  rng.next(first.begin(), first.end());
+  const double expected[] = { 0.42849499648069933, 0.48123915879733759,
+                              -0.82594344234463035, 0.8905361225825934 };
+  bool same = true;
+  for (size_t i = 0; i < first.size(); ++i)
+    same = same && std::fabs(first[i] - expected[i]) < 1.0e-15;
+  checks.check(same, "first mt19937 ziggurat deviates match the reference values");
+
+  return checks.exitCode();
+}
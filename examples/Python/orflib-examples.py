@@ -139,6 +139,26 @@ euromc1 = orf.euroBSMC(payofftype = 1, strike = 100, timetoexp = 1.0, spot = 100
 print(f'URNGTYPE={mcpars1["URNGTYPE"]} PATHGENTYPE={mcpars1["PATHGENTYPE"]} NPATHS={npaths1}')
 print(f'Price={euromc1}')
 
+print('Portfolio of basket options using Black-Scholes Monte Carlo')
+
+#basketptbsmc
+correl = np.full((3, 3), 0.5)
+np.fill_diagonal(correl, 1.0)
+basketmc = orf.basketPtBSMC(payofftypes = [1, -1], strikes = [100, 95], timestoexp = [1.0, 0.5],
+                            basketwghts = np.array([[0.4, 0.3, 0.3], [1.0, 0.0, 0.0]]),
+                            spots = [100, 100, 100], discountcrv = yc, divyields = [0.04, 0.04, 0.04],
+                            volatilities = [0.2, 0.3, 0.4], correlmat = correl,
+                            mcparams = mcpars0, npaths = npaths0, ptqtys = [1, 2])
+print(f'Price={basketmc}')
+
+print('Asian option using Black-Scholes multilevel Monte Carlo')
+
+#asianbsmlmc
+asianmlmc = orf.asianBSMLMC(payofftype = 1, strike = 100, fixtimes = np.arange(1, 257) / 256, spot = 100,
+                            discountcrv = yc, divyield = 0.04, volatility = 0.4,
+                            mcparams = mcpars0, rmse = 0.05)
+print(f'Price={asianmlmc}')
+
 #%%
 # function group 4
 print('=================')
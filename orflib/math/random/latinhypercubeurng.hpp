@@ -0,0 +1,223 @@
+/**
+*   @file  latinhypercubeurng.hpp
+*   @brief Stratified and Latin hypercube uniform random number generators
+*/
+
+#ifndef ORF_LATINHYPERCUBEURNG_HPP
+#define ORF_LATINHYPERCUBEURNG_HPP
+
+
+#include <orflib/math/random/philoxurng.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+BEGIN_NAMESPACE(orf)
+
+/** Latin hypercube sampling in batches of nStrata() points.
+    The leading nStratDims components of the points of each batch are stratified: component i
+    of point k of the batch falls in the stratum perm_i(k) of the nStrata() equal subintervals
+    of (0, 1), uniformly within it, where the perm_i are independent random permutations drawn
+    afresh for each batch. So each stratum holds exactly one point of a complete batch, and each
+    point, on its own, is uniform on the unit cube. The other components are plain uniforms.
+    Like PhiloxURng it produces points of dim() uniforms, and point n depends only on the seed
+    and n, so skipTo() is cheap.
+    The points of a batch are not independent: the standard error from the sample variance
+    overestimates the actual one, which is smaller.
+*/
+class LatinHypercubeURng
+{
+
+public:
+  /** The default number of strata, equal to McParams::PATHBLOCKSIZE so that the blocks of a
+      block-partitioned simulation are complete batches
+  */
+  enum { NSTRATA = 1024 };
+
+  /** Required for compatibility with std generators */
+  using result_type = double;
+
+  /** Initializing ctor, stratifying all the components */
+  explicit LatinHypercubeURng(size_t dimension);
+
+  /** Initializing ctor, stratifying the first nStratDims components */
+  LatinHypercubeURng(size_t dimension, size_t nStratDims, size_t nStrata = NSTRATA, unsigned long seed = 0);
+
+  /** Default ctor */
+  LatinHypercubeURng() : LatinHypercubeURng(1) {};
+
+  /** Returns the dimension of the generator */
+  size_t dim() const;
+
+  /** Returns the number of points in a batch, the number of strata of each stratified component */
+  size_t nStrata() const;
+
+  /** Returns a batch of random deviates
+      CAUTION: it requires end - begin to be a divisor of dimension()
+   */
+  template <typename ITER>
+  void next(ITER begin, ITER end);
+
+  /** Returns the next uniform number.
+      It should be called exactly dim() times to get one point (vector).
+  */
+  double operator()();
+
+  double min() { return uniforms_.min(); }
+
+  double max() { return uniforms_.max(); }
+
+  /** Sets the seed of the generator and restarts it at the first point */
+  void seed(unsigned long x0 = 0);
+
+  /** Positions the generator at the n-th point (counting from 0) */
+  void skipTo(unsigned long long n);
+
+protected:
+  /** Fills point_ with the n-th point */
+  void fillPoint(unsigned long long n);
+
+  /** Draws the permutations of the strata of batch b */
+  void drawPermutations(unsigned long long b);
+
+private:
+  // state
+  size_t dim_;                  // the number of dimensions
+  size_t nstratdims_;           // the number of leading components that are stratified
+  size_t nstrata_;              // the number of strata, and of points in a batch
+  PhiloxURng uniforms_;         // the uniforms within the strata
+  PhiloxURng shuffles_;         // the uniforms of the permutations, on a separate stream
+  std::vector<size_t> perm_;    // the permutations of the current batch, one after the other
+  unsigned long long batch_;    // the index of the current batch, nothing drawn if ~0
+  std::vector<double> point_;   // the current point in dim_ dimensions
+  size_t curridx_;              // the current index in the point_ vector
+  unsigned long long in_;       // the index of the next point
+};
+
+/** Stratified sampling of the first component only, in batches of nStrata() points.
+    With the Brownian bridge path generator it stratifies the terminal value of the first factor.
+*/
+class StratifiedURng : public LatinHypercubeURng
+{
+public:
+  /** Initializing ctor */
+  explicit StratifiedURng(size_t dimension) : LatinHypercubeURng(dimension, 1) {}
+
+  /** Default ctor */
+  StratifiedURng() : StratifiedURng(1) {};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+inline
+LatinHypercubeURng::LatinHypercubeURng(size_t dimension)
+: LatinHypercubeURng(dimension, dimension)
+{}
+
+inline
+LatinHypercubeURng::LatinHypercubeURng(size_t dimension, size_t nStratDims, size_t nStrata, unsigned long seed)
+: dim_(dimension), nstratdims_(nStratDims), nstrata_(nStrata),
+  uniforms_(dimension, seed, 0), shuffles_(1, seed, 1), point_(dimension)
+{
+  ORF_ASSERT(dimension > 0, "the dimension must be positive!");
+  ORF_ASSERT(nStratDims <= dimension, "cannot stratify more components than the dimension!");
+  ORF_ASSERT(nStrata > 0, "the number of strata must be positive!");
+  perm_.resize(nstratdims_ * nstrata_);
+  this->seed(seed);
+}
+
+inline
+size_t LatinHypercubeURng::dim() const
+{
+  return dim_;
+}
+
+inline
+size_t LatinHypercubeURng::nStrata() const
+{
+  return nstrata_;
+}
+
+inline
+void LatinHypercubeURng::seed(unsigned long x0)
+{
+  uniforms_.seed(x0);
+  shuffles_.seed(x0);
+  batch_ = ~0ULL;
+  skipTo(0);
+}
+
+inline
+void LatinHypercubeURng::skipTo(unsigned long long n)
+{
+  in_ = n;
+  curridx_ = dim_;
+}
+
+inline
+void LatinHypercubeURng::drawPermutations(unsigned long long b)
+{
+  // Fisher-Yates shuffles, uniform j of permutation i of the batch is point (b * nstratdims + i) * nstrata + j
+  for (size_t i = 0; i < nstratdims_; ++i) {
+    size_t* perm = perm_.data() + i * nstrata_;
+    unsigned long long first = (b * nstratdims_ + i) * nstrata_;
+    for (size_t k = 0; k < nstrata_; ++k)
+      perm[k] = k;
+    for (size_t k = nstrata_ - 1; k > 0; --k) {
+      size_t j = static_cast<size_t>(shuffles_.uniform(first + k, 0) * (k + 1));
+      std::swap(perm[k], perm[std::min(j, k)]);
+    }
+  }
+  batch_ = b;
+}
+
+inline
+void LatinHypercubeURng::fillPoint(unsigned long long n)
+{
+  unsigned long long b = n / nstrata_;
+  size_t k = static_cast<size_t>(n % nstrata_);
+  if (nstratdims_ > 0 && b != batch_)
+    drawPermutations(b);
+  uniforms_.skipTo(n);
+  uniforms_.next(point_.begin(), point_.end());
+  // in the top stratum the product can round up to 1, whose normal deviate is infinite
+  static const double maxuniform = std::nextafter(1.0, 0.0);
+  double width = 1.0 / nstrata_;
+  for (size_t i = 0; i < nstratdims_; ++i)
+    point_[i] = std::min((perm_[i * nstrata_ + k] + point_[i]) * width, maxuniform);
+}
+
+template <typename ITER>
+inline
+void LatinHypercubeURng::next(ITER begin, ITER end)
+{
+  size_t ncomp = 0;
+  for (auto it = begin; it != end; ++it)
+    ncomp++;
+  ORF_ASSERT(ncomp <= dim_, "LatinHypercubeURng::next(), size of range to fill is too large");
+  ORF_ASSERT(dim_ % ncomp == 0, "LatinHypercubeURng::next(), size of range to fill is not a divisor of dim")
+
+  if (curridx_ == dim_) {  // generate a new point
+    fillPoint(in_++);
+    curridx_ = 0;
+  }
+  for (auto it = begin; it != end; ++it) {
+    *it = point_[curridx_++];
+  }
+}
+
+inline
+double LatinHypercubeURng::operator()()
+{
+  if (curridx_ == dim_) {  // generate a new point
+    fillPoint(in_++);
+    curridx_ = 0;
+  }
+  return point_[curridx_++];
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_LATINHYPERCUBEURNG_HPP
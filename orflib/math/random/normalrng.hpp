@@ -1,100 +1,193 @@
-/**
-@file  normalrng.hpp
-@brief Generator of random deviates from the Normal distribution
-*/
-
-#ifndef ORF_NORMALRNG_HPP
-#define ORF_NORMALRNG_HPP
-
-
-#include <orflib/defines.hpp>
-#include <orflib/exception.hpp>
-#include <random>
-#include <orflib/math/random/sobolurng.hpp>
-#include <orflib/math/stats/normaldistribution.hpp>
-
-BEGIN_NAMESPACE(orf)
-
-/** Generator of normal deviates. It is templatized on the underlying uniform RNG
-*/
-template<typename URNG>
-class NormalRng
-{
-
-public:
-  /** Ctor from distribution parameters */
-  explicit NormalRng(size_t dimension, double mean = 0.0, double stdev = 1.0, URNG const & urng = URNG());
-
-  /** Returns the dimension of the generator */
-  size_t dim() const;
-
-  /** Returns a batch of random deviates
-      CAUTION: it requires end - begin == dimension() */
-  template <typename ITER>
-  void next(ITER begin, ITER end);
-
-  /** Returns the underlying uniform rng. */
-  URNG & urng();
-
-private:
-
-  // state
-  size_t dim_;      // the dimension of the generator
-  URNG urng_;       // the uniform random number generator
-  std::normal_distribution<double> normcdf_;  // the normal distribution
-
-};
-
-///////////////////////////////////////////////////////////////////////////////
-// Inline definitions
-
-template<typename URNG>
-NormalRng<URNG>::NormalRng(size_t dimension, double mean, double stdev, URNG const & urng)
-  : dim_(dimension), urng_(urng)
-{
-  ORF_ASSERT(stdev > 0.0, "the standard deviation must be positive!");
-  normcdf_ = std::normal_distribution<double>(mean, stdev);
-}
-
-template<typename URNG>
-size_t NormalRng<URNG>::dim() const
-{
-  return dim_;
-}
-
-template<typename URNG>
-template <typename ITER>
-void NormalRng<URNG>::next(ITER begin, ITER end)
-{
-  for (ITER it = begin; it != end; ++it)
-    *it = normcdf_(urng_);
-}
-
-template<typename URNG>
-URNG & NormalRng<URNG>::urng()
-{
-  return urng_;
-}
-
-template<>
-inline
-NormalRng<SobolURng>::NormalRng(size_t dimension, double mean, double stdev, SobolURng const& urng)
-: dim_(dimension), urng_(dimension)
-{
-  ORF_ASSERT(stdev > 0.0, "the standard deviation must be positive!");
-  normcdf_ = std::normal_distribution<double>(mean, stdev);
-}
-
-template<>
-template <typename ITER>
-void NormalRng<SobolURng>::next(ITER begin, ITER end)
-{
-  urng_.next(begin, end);
-  orf::NormalDistribution stdnorm;
-  for (ITER it = begin; it != end; ++it)
-    *it = stdnorm.invcdf(*it);
-}
-
-END_NAMESPACE(orf)
-
-#endif // ORF_NORMALRNG_HPP
+/**
+@file  normalrng.hpp
+@brief Generator of random deviates from the Normal distribution
+*/
+
+#ifndef ORF_NORMALRNG_HPP
+#define ORF_NORMALRNG_HPP
+
+
+#include <orflib/defines.hpp>
+#include <orflib/exception.hpp>
+#include <random>
+#include <type_traits>
+#include <orflib/math/stats/normaldistribution.hpp>
+#include <orflib/math/random/zigguratnormal.hpp>
+
+BEGIN_NAMESPACE(orf)
+
+/** Generator of normal deviates. It is templatized on the underlying uniform RNG.
+    Uniform RNGs returning doubles produce points and use the specialization below.
+*/
+template<typename URNG, bool ISPOINTRNG = std::is_floating_point<typename URNG::result_type>::value>
+class NormalRng
+{
+
+public:
+  /** Ctor from distribution parameters */
+  explicit NormalRng(size_t dimension, double mean = 0.0, double stdev = 1.0, URNG const & urng = URNG());
+
+  /** Returns the dimension of the generator */
+  size_t dim() const;
+
+  /** Returns a batch of random deviates
+      CAUTION: it requires end - begin == dimension() */
+  template <typename ITER>
+  void next(ITER begin, ITER end);
+
+  /** Returns the underlying uniform rng. */
+  URNG & urng();
+
+  /** Restarts the generator on the random stream identified by (seed, streamIdx).
+      firstPoint is the global index of the first point (vector of dim() deviates) drawn
+      from the stream; pseudo-random generators ignore it and reseed instead,
+      low discrepancy generators ignore the seed and skip ahead to firstPoint.
+  */
+  void setStream(unsigned long seed, size_t streamIdx, size_t firstPoint);
+
+private:
+
+  // state
+  size_t dim_;      // the dimension of the generator
+  URNG urng_;       // the uniform random number generator
+  ZigguratNormal normdist_;  // the normal distribution
+
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+template<typename URNG, bool ISPOINTRNG>
+NormalRng<URNG, ISPOINTRNG>::NormalRng(size_t dimension, double mean, double stdev, URNG const & urng)
+  : dim_(dimension), urng_(urng), normdist_(mean, stdev)
+{
+  ORF_ASSERT(stdev > 0.0, "the standard deviation must be positive!");
+}
+
+template<typename URNG, bool ISPOINTRNG>
+size_t NormalRng<URNG, ISPOINTRNG>::dim() const
+{
+  return dim_;
+}
+
+template<typename URNG, bool ISPOINTRNG>
+template <typename ITER>
+void NormalRng<URNG, ISPOINTRNG>::next(ITER begin, ITER end)
+{
+  normdist_.next(urng_, begin, end);
+}
+
+template<typename URNG, bool ISPOINTRNG>
+URNG & NormalRng<URNG, ISPOINTRNG>::urng()
+{
+  return urng_;
+}
+
+template<typename URNG, bool ISPOINTRNG>
+void NormalRng<URNG, ISPOINTRNG>::setStream(unsigned long seed, size_t streamIdx, size_t firstPoint)
+{
+  std::seed_seq sseq{ static_cast<unsigned int>(seed), static_cast<unsigned int>(streamIdx) };
+  urng_.seed(sseq);
+}
+
+/** Generator of normal deviates from a uniform generator of points, such as a low discrepancy
+    sequence or a counter-based generator. It maps the uniforms to normal deviates by inverting
+    the normal cdf, so each point of uniforms becomes one point of normal deviates.
+*/
+template<typename URNG>
+class NormalRng<URNG, true>
+{
+
+public:
+  /** Ctor from distribution parameters */
+  explicit NormalRng(size_t dimension, double mean = 0.0, double stdev = 1.0, URNG const & urng = URNG());
+
+  /** Returns the dimension of the generator */
+  size_t dim() const;
+
+  /** Returns a batch of random deviates
+      CAUTION: it requires end - begin to be a divisor of dimension() */
+  template <typename ITER>
+  void next(ITER begin, ITER end);
+
+  /** Returns the uniform deviates that next() would map to normal deviates, drawing them
+      from the stream in the same way. toNormal() maps them later, only where needed.
+  */
+  template <typename ITER>
+  void nextUniform(ITER begin, ITER end);
+
+  /** Maps uniform deviates from nextUniform() to normal deviates in place, as next() does */
+  template <typename ITER>
+  void toNormal(ITER begin, ITER end) const;
+
+  /** Returns the underlying uniform rng. */
+  URNG & urng();
+
+  /** Restarts the generator on the random stream identified by seed, at the point firstPoint.
+      The points are indexed globally, so streamIdx is not needed.
+  */
+  void setStream(unsigned long seed, size_t streamIdx, size_t firstPoint);
+
+private:
+
+  // state
+  size_t dim_;                  // the dimension of the generator
+  URNG urng_;                   // the uniform random number generator
+  NormalDistribution normdist_; // the normal distribution
+
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+template<typename URNG>
+NormalRng<URNG, true>::NormalRng(size_t dimension, double mean, double stdev, URNG const& urng)
+: dim_(dimension), urng_(dimension), normdist_(mean, stdev)
+{
+  ORF_ASSERT(stdev > 0.0, "the standard deviation must be positive!");
+}
+
+template<typename URNG>
+size_t NormalRng<URNG, true>::dim() const
+{
+  return dim_;
+}
+
+template<typename URNG>
+template <typename ITER>
+void NormalRng<URNG, true>::next(ITER begin, ITER end)
+{
+  urng_.next(begin, end);
+  normdist_.invcdf(begin, end);
+}
+
+template<typename URNG>
+template <typename ITER>
+void NormalRng<URNG, true>::nextUniform(ITER begin, ITER end)
+{
+  urng_.next(begin, end);
+}
+
+template<typename URNG>
+template <typename ITER>
+void NormalRng<URNG, true>::toNormal(ITER begin, ITER end) const
+{
+  normdist_.invcdf(begin, end);
+}
+
+template<typename URNG>
+URNG & NormalRng<URNG, true>::urng()
+{
+  return urng_;
+}
+
+template<typename URNG>
+void NormalRng<URNG, true>::setStream(unsigned long seed, size_t streamIdx, size_t firstPoint)
+{
+  urng_.seed(seed);          // a no-op for low discrepancy sequences
+  urng_.skipTo(firstPoint);
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_NORMALRNG_HPP
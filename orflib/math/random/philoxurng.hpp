@@ -0,0 +1,229 @@
+/**
+*   @file  philoxurng.hpp
+*   @brief Counter-based Philox4x32-10 uniform random number generator
+*/
+
+#ifndef ORF_PHILOXURNG_HPP
+#define ORF_PHILOXURNG_HPP
+
+
+#include <orflib/defines.hpp>
+#include <orflib/exception.hpp>
+#include <cstdint>
+#include <vector>
+
+
+BEGIN_NAMESPACE(orf)
+
+/** Counter-based generator Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+    Like SobolURng it produces points of dim() uniforms. Component i of point n in stream s
+    is a pure function of (seed, s, n, i), so any point can be drawn in O(1) and parallel
+    runs are reproducible without any seeding heuristics.
+    Each Philox block of 4 x 32 bits yields two uniforms with 53 random bits,
+    in the open interval (0, 1).
+*/
+class PhiloxURng
+{
+
+public:
+
+  /** Required for compatibility with std generators */
+  using result_type = double;
+
+  /** Initializing ctor */
+  explicit PhiloxURng(size_t dimension, unsigned long seed = 0, unsigned long stream = 0);
+
+  /** Default ctor */
+  PhiloxURng() : PhiloxURng(1) {};
+
+  /** Returns the dimension of the generator */
+  size_t dim() const;
+
+  /** Returns a batch of random deviates
+      CAUTION: it requires end - begin to be a divisor of dimension()
+   */
+  template <typename ITER>
+  void next(ITER begin, ITER end);
+
+  /** Returns the next uniform number.
+      This method is provided to make PhiloxURng compatible with the URNGs in std.
+      It should be called exactly dim() times to get one point (vector).
+  */
+  double operator()();
+
+  double min() { return 0.5 * TWOPOWM53; }
+
+  double max() { return 1.0 - 0.5 * TWOPOWM53; }
+
+  /** Sets the key of the generator and restarts it at the first point */
+  void seed(unsigned long x0 = 0);
+
+  /** Positions the generator at the n-th point of its stream (counting from 0) */
+  void skipTo(unsigned long long n);
+
+  /** Returns component i of the n-th point of the stream, without changing the state */
+  double uniform(unsigned long long n, size_t i) const;
+
+protected:
+  /** Fills out with the dim() components of the n-th point */
+  void fillPoint(unsigned long long n, double* out) const;
+
+  /** Applies the 10 Philox rounds to a counter, with the generator key */
+  void philox(uint32_t ctr[4]) const;
+
+  /** Converts 64 random bits to a double in (0, 1) */
+  static double toUniform(uint32_t hi, uint32_t lo);
+
+private:
+  // state
+  static constexpr double TWOPOWM53 = 1.0 / 9007199254740992.0;  // 2^-53
+  static const uint32_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;   // round multipliers
+  static const uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;   // Weyl key increments
+  enum { NLANES = 8 };        // number of counters processed together, so that the rounds vectorize
+
+  size_t  dim_;               // the number of dimensions
+  uint32_t key_[2];           // the key, from the seed
+  uint32_t stream_;           // the stream index, last counter word
+  std::vector<double> point_; // the current point in dim_ dimensions
+  size_t curridx_;            // the current index in the point_ vector
+  unsigned long long in_;     // the index of the next point
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+inline
+PhiloxURng::PhiloxURng(size_t dimension, unsigned long seed, unsigned long stream)
+: dim_(dimension), stream_(static_cast<uint32_t>(stream)), point_(dimension), curridx_(dimension), in_(0)
+{
+  ORF_ASSERT(dimension > 0, "the dimension must be positive!");
+  this->seed(seed);
+}
+
+inline
+size_t PhiloxURng::dim() const
+{
+  return dim_;
+}
+
+inline
+void PhiloxURng::seed(unsigned long x0)
+{
+  unsigned long long x = x0;
+  key_[0] = static_cast<uint32_t>(x);
+  key_[1] = static_cast<uint32_t>(x >> 32);
+  skipTo(0);
+}
+
+inline
+void PhiloxURng::skipTo(unsigned long long n)
+{
+  in_ = n;
+  curridx_ = dim_;
+}
+
+inline
+double PhiloxURng::toUniform(uint32_t hi, uint32_t lo)
+{
+  unsigned long long bits = (static_cast<unsigned long long>(hi >> 5) << 26) | (lo >> 6);
+  return (bits + 0.5) * TWOPOWM53;
+}
+
+inline
+void PhiloxURng::philox(uint32_t ctr[4]) const
+{
+  uint32_t k0 = key_[0], k1 = key_[1];
+  for (int r = 0; r < 10; ++r) {
+    uint64_t p0 = static_cast<uint64_t>(M0) * ctr[0];
+    uint64_t p1 = static_cast<uint64_t>(M1) * ctr[2];
+    uint32_t c0 = static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ k0;
+    uint32_t c2 = static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ k1;
+    ctr[0] = c0;
+    ctr[1] = static_cast<uint32_t>(p1);
+    ctr[2] = c2;
+    ctr[3] = static_cast<uint32_t>(p0);
+    k0 += W0;
+    k1 += W1;
+  }
+}
+
+inline
+double PhiloxURng::uniform(unsigned long long n, size_t i) const
+{
+  ORF_ASSERT(i < dim_, "PhiloxURng::uniform(), component index out of range");
+  uint32_t ctr[4] = { static_cast<uint32_t>(i / 2), static_cast<uint32_t>(n),
+                      static_cast<uint32_t>(n >> 32), stream_ };
+  philox(ctr);
+  return i % 2 == 0 ? toUniform(ctr[0], ctr[1]) : toUniform(ctr[2], ctr[3]);
+}
+
+inline
+void PhiloxURng::fillPoint(unsigned long long n, double* out) const
+{
+  size_t nblocks = (dim_ + 1) / 2;
+  uint32_t c0[NLANES], c1[NLANES], c2[NLANES], c3[NLANES];
+  for (size_t b0 = 0; b0 < nblocks; b0 += NLANES) {
+    for (size_t l = 0; l < NLANES; ++l) {
+      c0[l] = static_cast<uint32_t>(b0 + l);
+      c1[l] = static_cast<uint32_t>(n);
+      c2[l] = static_cast<uint32_t>(n >> 32);
+      c3[l] = stream_;
+    }
+    // the same rounds as philox(), on NLANES counters at once
+    uint32_t k0 = key_[0], k1 = key_[1];
+    for (int r = 0; r < 10; ++r) {
+      for (size_t l = 0; l < NLANES; ++l) {
+        uint64_t p0 = static_cast<uint64_t>(M0) * c0[l];
+        uint64_t p1 = static_cast<uint64_t>(M1) * c2[l];
+        uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1[l] ^ k0;
+        uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3[l] ^ k1;
+        c0[l] = n0;
+        c1[l] = static_cast<uint32_t>(p1);
+        c2[l] = n2;
+        c3[l] = static_cast<uint32_t>(p0);
+      }
+      k0 += W0;
+      k1 += W1;
+    }
+    size_t nl = nblocks - b0 < NLANES ? nblocks - b0 : NLANES;
+    for (size_t l = 0; l < nl; ++l) {
+      size_t i = 2 * (b0 + l);
+      out[i] = toUniform(c0[l], c1[l]);
+      if (i + 1 < dim_)
+        out[i + 1] = toUniform(c2[l], c3[l]);
+    }
+  }
+}
+
+template <typename ITER>
+inline
+void PhiloxURng::next(ITER begin, ITER end)
+{
+  size_t ncomp = 0;
+  for (auto it = begin; it != end; ++it)
+    ncomp++;
+  ORF_ASSERT(ncomp <= dim_, "PhiloxURng::next(), size of range to fill is too large");
+  ORF_ASSERT(dim_ % ncomp == 0, "PhiloxURng::next(), size of range to fill is not a divisor of dim")
+
+  if (curridx_ == dim_) {  // generate a new point
+    fillPoint(in_++, point_.data());
+    curridx_ = 0;
+  }
+  for (auto it = begin; it != end; ++it) {
+    *it = point_[curridx_++];
+  }
+}
+
+inline
+double PhiloxURng::operator()()
+{
+  if (curridx_ == dim_) {  // generate a new point
+    fillPoint(in_++, point_.data());
+    curridx_ = 0;
+  }
+  return point_[curridx_++];
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_PHILOXURNG_HPP
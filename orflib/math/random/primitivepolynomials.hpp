@@ -1,406 +1,406 @@
-/** 
-*   @file  primitivepolynomials.hpp
-*   @brief Encoding of primitive polynomials mod 2
-*          Adapted from Peter Jaeckel's CD from the book "Monte Carlo Methods in Finance"
-*/
-
-#ifndef ORF_PRIMITIVEPOLYNOMIALS_HPP
-#define ORF_PRIMITIVEPOLYNOMIALS_HPP
-
-#define MAX_PRIMITIVEPOLY 3666        // maximum number of polynomials
-#define MAX_PRIMITIVEDEGREE 15        // maximum order
-
-/**
-    Precomputed primitive polynomials mod 2.
-    Adapted from Peter Jaeckel's code in "Monte Carlo Methods in Finance", Wiley 2002
-
-    Encoding scheme:
-    
-    Each polynomial is represented by a base-10 integer, whose binary representation 
-    contains the coefficients of the polynomial, except the first and the last one.
-    The first and last coefficient of every primitive polynomial are equal to 1.
-
-    Example: The coefficients of the primitive polynomial x^4  + x^2  + 1
-    create the binary representation 10101
-    Stripping off the first and last bits we get 010
-    The polynomial is encoded as the base-10 number 2.
-*/
-
-static long PrimitivePolynomialDegree1[] = { 0, -1 };
-
-static long PrimitivePolynomialDegree2[] = { 1, -1 };
-
-static long PrimitivePolynomialDegree3[] = { 1, 2, -1 };
-
-static long PrimitivePolynomialDegree4[] = { 1, 4, -1 };
-
-static long PrimitivePolynomialDegree5[] = { 2, 4, 7, 11, 13, 14, -1 };
-
-static long PrimitivePolynomialDegree6[] = { 1, 13, 16, 19, 22, 25, -1 };
-
-static long PrimitivePolynomialDegree7[] = { 1, 4, 7, 8, 14, 19, 21, 28,
-  31, 32, 37, 41, 42, 50, 55, 56, 59, 62, -1 };
-
-static long PrimitivePolynomialDegree8[] = { 14, 21, 22, 38, 47, 49, 50,
-  52, 56, 67, 70, 84, 97, 103, 115, 122, -1 };
-
-static long PrimitivePolynomialDegree9[] = { 8, 13, 16, 22, 25, 44, 47,
-  52, 55, 59, 62, 67, 74, 81, 82, 87, 91, 94, 103, 104, 109, 122, 124,
-  137, 138, 143, 145, 152, 157, 167, 173, 176, 181, 182, 185, 191,
-  194, 199, 218, 220, 227, 229, 230, 234, 236, 241, 244, 253, -1 };
-
-static long PrimitivePolynomialDegree10[] = { 4, 13, 19, 22, 50, 55, 64,
-  69, 98, 107, 115, 121, 127, 134, 140, 145, 152, 158, 161, 171, 181,
-  194, 199, 203, 208, 227, 242, 251, 253, 265, 266, 274, 283, 289,
-  295, 301, 316, 319, 324, 346, 352, 361, 367, 382, 395, 398, 400,
-  412, 419, 422, 426, 428, 433, 446, 454, 457, 472, 493, 505, 508, -1  };
-
-static long PrimitivePolynomialDegree11[] = { 2, 11, 21, 22, 35, 49, 50,
-  56, 61, 70, 74, 79, 84, 88, 103, 104, 112, 115, 117, 122, 134, 137,
-  146, 148, 157, 158, 162, 164, 168, 173, 185, 186, 191, 193, 199,
-  213, 214, 220, 227, 236, 242, 251, 256, 259, 265, 266, 276, 292,
-  304, 310, 316, 319, 322, 328, 334, 339, 341, 345, 346, 362, 367,
-  372, 375, 376, 381, 385, 388, 392, 409, 415, 416, 421, 428, 431,
-  434, 439, 446, 451, 453, 457, 458, 471, 475, 478, 484, 493, 494,
-  499, 502, 517, 518, 524, 527, 555, 560, 565, 569, 578, 580, 587,
-  589, 590, 601, 607, 611, 614, 617, 618, 625, 628, 635, 641, 647,
-  654, 659, 662, 672, 675, 682, 684, 689, 695, 696, 713, 719, 724,
-  733, 734, 740, 747, 749, 752, 755, 762, 770, 782, 784, 787, 789,
-  793, 796, 803, 805, 810, 815, 824, 829, 830, 832, 841, 847, 849,
-  861, 871, 878, 889, 892, 901, 908, 920, 923, 942, 949, 950, 954,
-  961, 968, 971, 973, 979, 982, 986, 998, 1001, 1010, 1012, -1 };
-
-static long PrimitivePolynomialDegree12[] = { 41, 52, 61, 62, 76, 104,
-  117, 131, 143, 145, 157, 167, 171, 176, 181, 194, 217, 236, 239,
-  262, 283, 286, 307, 313, 319, 348, 352, 357, 391, 398, 400, 412,
-  415, 422, 440, 460, 465, 468, 515, 536, 539, 551, 558, 563, 570,
-  595, 598, 617, 647, 654, 678, 713, 738, 747, 750, 757, 772, 803,
-  810, 812, 850, 862, 906, 908, 929, 930, 954, 964, 982, 985, 991,
-  992, 1067, 1070, 1096, 1099, 1116, 1143, 1165, 1178, 1184, 1202,
-  1213, 1221, 1240, 1246, 1252, 1255, 1267, 1293, 1301, 1305, 1332,
-  1349, 1384, 1392, 1402, 1413, 1417, 1423, 1451, 1480, 1491, 1503,
-  1504, 1513, 1538, 1544, 1547, 1555, 1574, 1603, 1615, 1618, 1629,
-  1634, 1636, 1639, 1657, 1667, 1681, 1697, 1704, 1709, 1722, 1730,
-  1732, 1802, 1804, 1815, 1826, 1832, 1843, 1849, 1863, 1905, 1928,
-  1933, 1939, 1976, 1996, 2013, 2014, 2020, -1 };
-
-static long PrimitivePolynomialDegree13[] = { 13, 19, 26, 41, 50, 55,
- 69, 70, 79, 82, 87, 93, 94, 97, 100, 112, 121, 134, 138, 148, 151,
- 157, 161, 179, 181, 188, 196, 203, 206, 223, 224, 227, 230, 239, 241,
- 248, 253, 268, 274, 283, 286, 289, 301, 302, 316, 319, 324, 331, 333,
- 345, 351, 358, 375, 379, 381, 386, 403, 405, 419, 426, 428, 439, 440,
- 446, 451, 454, 458, 465, 468, 472, 475, 477, 496, 502, 508, 517, 521,
- 527, 530, 532, 542, 552, 555, 560, 566, 575, 577, 589, 590, 602, 607,
- 608, 611, 613, 625, 644, 651, 654, 656, 662, 668, 681, 682, 689, 696,
- 699, 707, 709, 714, 716, 719, 727, 734, 738, 743, 747, 757, 769, 770,
- 776, 790, 799, 805, 809, 812, 820, 827, 829, 835, 841, 844, 856, 859,
- 862, 865, 885, 890, 905, 916, 925, 935, 939, 942, 949, 953, 956, 961,
- 968, 976, 988, 995, 997, 1007, 1015, 1016, 1027, 1036, 1039, 1041,
- 1048, 1053, 1054, 1058, 1075, 1082, 1090, 1109, 1110, 1119, 1126,
- 1130, 1135, 1137, 1140, 1149, 1156, 1159, 1160, 1165, 1173, 1178,
- 1183, 1184, 1189, 1194, 1211, 1214, 1216, 1225, 1231, 1239, 1243,
- 1246, 1249, 1259, 1273, 1274, 1281, 1287, 1294, 1296, 1305, 1306,
- 1318, 1332, 1335, 1336, 1341, 1342, 1362, 1364, 1368, 1378, 1387,
- 1389, 1397, 1401, 1408, 1418, 1425, 1426, 1431, 1435, 1441, 1444,
- 1462, 1471, 1474, 1483, 1485, 1494, 1497, 1516, 1522, 1534, 1543,
- 1552, 1557, 1558, 1567, 1568, 1574, 1592, 1605, 1606, 1610, 1617,
- 1623, 1630, 1634, 1640, 1643, 1648, 1651, 1653, 1670, 1676, 1684,
- 1687, 1691, 1693, 1698, 1709, 1715, 1722, 1732, 1735, 1747, 1749,
- 1754, 1777, 1784, 1790, 1795, 1801, 1802, 1812, 1828, 1831, 1837,
- 1838, 1840, 1845, 1863, 1864, 1867, 1870, 1877, 1881, 1884, 1903,
- 1917, 1918, 1922, 1924, 1928, 1931, 1951, 1952, 1957, 1958, 1964,
- 1967, 1970, 1972, 1994, 2002, 2007, 2008, 2023, 2030, 2035, 2038,
- 2042, 2047, 2051, 2058, 2060, 2071, 2084, 2087, 2099, 2108, 2111,
- 2120, 2128, 2138, 2143, 2144, 2153, 2156, 2162, 2167, 2178, 2183,
- 2202, 2211, 2214, 2223, 2225, 2232, 2237, 2257, 2260, 2267, 2274,
- 2276, 2285, 2288, 2293, 2294, 2297, 2303, 2308, 2311, 2318, 2323,
- 2332, 2341, 2345, 2348, 2354, 2368, 2377, 2380, 2383, 2388, 2395,
- 2397, 2401, 2411, 2413, 2419, 2435, 2442, 2455, 2472, 2478, 2490,
- 2507, 2509, 2517, 2524, 2528, 2531, 2538, 2545, 2546, 2555, 2557,
- 2564, 2573, 2579, 2592, 2598, 2607, 2612, 2619, 2621, 2627, 2633,
- 2636, 2642, 2654, 2660, 2669, 2675, 2684, 2694, 2703, 2706, 2712,
- 2715, 2722, 2727, 2734, 2742, 2745, 2751, 2766, 2768, 2780, 2790,
- 2794, 2796, 2801, 2804, 2807, 2816, 2821, 2831, 2834, 2839, 2845,
- 2852, 2856, 2861, 2873, 2874, 2888, 2893, 2894, 2902, 2917, 2921,
- 2922, 2929, 2935, 2946, 2951, 2957, 2960, 2966, 2972, 2976, 2979,
- 2985, 3000, 3003, 3013, 3018, 3020, 3025, 3042, 3047, 3048, 3051,
- 3054, 3056, 3065, 3073, 3074, 3083, 3086, 3091, 3097, 3109, 3116,
- 3124, 3128, 3153, 3160, 3165, 3172, 3175, 3184, 3193, 3196, 3200,
- 3203, 3205, 3209, 3224, 3239, 3251, 3254, 3265, 3266, 3275, 3280,
- 3283, 3286, 3301, 3302, 3305, 3319, 3323, 3326, 3331, 3348, 3351,
- 3358, 3368, 3374, 3376, 3379, 3385, 3386, 3396, 3420, 3423, 3430,
- 3433, 3434, 3439, 3442, 3444, 3453, 3464, 3477, 3478, 3482, 3487,
- 3497, 3500, 3505, 3506, 3511, 3512, 3515, 3525, 3532, 3538, 3540,
- 3547, 3549, 3560, 3571, 3577, 3583, 3590, 3593, 3594, 3599, 3601,
- 3602, 3613, 3623, 3630, 3638, 3649, 3655, 3662, 3667, 3669, 3676,
- 3683, 3700, 3709, 3710, 3713, 3723, 3725, 3728, 3734, 3737, 3738,
- 3744, 3750, 3762, 3764, 3774, 3776, 3786, 3800, 3803, 3809, 3816,
- 3821, 3827, 3829, 3836, 3842, 3844, 3847, 3853, 3861, 3871, 3872,
- 3881, 3890, 3892, 3909, 3921, 3934, 3938, 3947, 3950, 3952, 3964,
- 3974, 3980, 3983, 3986, 3995, 3998, 4001, 4002, 4004, 4008, 4011,
- 4016, 4033, 4036, 4040, 4053, 4058, 4081, 4091, 4094, -1 };
-
-static long PrimitivePolynomialDegree14[] = { 21, 28, 41, 47, 61, 84,
- 87, 93, 94, 103, 117, 121, 134, 137, 157, 161, 205, 206, 211, 214,
- 218, 234, 236, 248, 262, 299, 304, 319, 322, 334, 355, 357, 358, 369,
- 372, 375, 388, 400, 415, 446, 451, 458, 471, 484, 501, 502, 517, 545,
- 569, 617, 618, 623, 625, 637, 661, 668, 684, 695, 716, 719, 722, 731,
- 738, 747, 755, 761, 767, 775, 782, 787, 794, 803, 812, 817, 824, 829,
- 850, 866, 871, 877, 920, 935, 959, 979, 992, 1010, 1012, 1015, 1033,
- 1036, 1053, 1057, 1069, 1072, 1075, 1087, 1089, 1137, 1166, 1174,
- 1180, 1204, 1211, 1219, 1236, 1255, 1264, 1306, 1330, 1341, 1344,
- 1347, 1349, 1361, 1380, 1390, 1404, 1435, 1444, 1453, 1461, 1462,
- 1465, 1468, 1474, 1483, 1488, 1493, 1500, 1509, 1510, 1514, 1519,
- 1528, 1533, 1540, 1550, 1567, 1571, 1573, 1578, 1598, 1606, 1618,
- 1630, 1634, 1640, 1643, 1654, 1679, 1688, 1698, 1703, 1704, 1722,
- 1735, 1750, 1753, 1760, 1789, 1792, 1802, 1819, 1825, 1828, 1832,
- 1845, 1846, 1857, 1869, 1897, 1906, 1908, 1911, 1934, 1962, 1967,
- 1972, 1975, 1999, 2004, 2011, 2013, 2037, 2051, 2063, 2066, 2094,
- 2128, 2154, 2164, 2198, 2217, 2220, 2223, 2238, 2245, 2252, 2258,
- 2264, 2280, 2285, 2293, 2294, 2298, 2303, 2306, 2311, 2326, 2354,
- 2373, 2380, 2385, 2392, 2401, 2402, 2408, 2419, 2450, 2452, 2477,
- 2509, 2510, 2515, 2524, 2527, 2531, 2552, 2561, 2567, 2571, 2586,
- 2588, 2595, 2607, 2621, 2630, 2639, 2653, 2670, 2672, 2700, 2711,
- 2715, 2748, 2751, 2753, 2754, 2760, 2774, 2784, 2793, 2804, 2811,
- 2822, 2826, 2836, 2839, 2840, 2893, 2901, 2902, 2905, 2912, 2915,
- 2918, 2939, 2965, 2966, 2975, 2988, 2993, 3006, 3017, 3031, 3038,
- 3041, 3042, 3051, 3073, 3088, 3097, 3098, 3103, 3104, 3146, 3148,
- 3153, 3159, 3182, 3187, 3189, 3199, 3239, 3263, 3271, 3275, 3278,
- 3280, 3283, 3290, 3311, 3316, 3343, 3346, 3357, 3358, 3361, 3362,
- 3364, 3386, 3418, 3424, 3433, 3434, 3436, 3463, 3467, 3477, 3484,
- 3505, 3508, 3515, 3532, 3553, 3554, 3568, 3573, 3587, 3589, 3596,
- 3608, 3620, 3630, 3644, 3649, 3664, 3679, 3680, 3685, 3686, 3698,
- 3714, 3726, 3737, 3767, 3782, 3786, 3793, 3796, 3805, 3815, 3841,
- 3847, 3853, 3862, 3875, 3902, 3904, 3916, 3947, 3949, 3955, 3962,
- 3971, 3980, 3985, 3998, 4001, 4002, 4016, 4021, 4026, 4043, 4079,
- 4102, 4106, 4119, 4126, 4147, 4149, 4164, 4174, 4181, 4185, 4188,
- 4202, 4228, 4232, 4246, 4252, 4256, 4286, 4303, 4306, 4311, 4317,
- 4342, 4346, 4377, 4401, 4407, 4414, 4422, 4431, 4434, 4436, 4443,
- 4459, 4461, 4462, 4473, 4497, 4504, 4507, 4525, 4534, 4538, 4548,
- 4552, 4560, 4575, 4599, 4612, 4619, 4640, 4643, 4677, 4687, 4723,
- 4730, 4736, 4741, 4763, 4765, 4770, 4781, 4808, 4822, 4828, 4831,
- 4842, 4855, 4859, 4867, 4870, 4881, 4893, 4910, 4917, 4929, 4939,
- 4947, 4949, 4954, 4972, 4975, 5000, 5005, 5029, 5039, 5044, 5051,
- 5056, 5073, 5096, 5128, 5134, 5161, 5179, 5193, 5199, 5202, 5204,
- 5218, 5247, 5260, 5271, 5301, 5305, 5319, 5326, 5328, 5333, 5364,
- 5376, 5399, 5416, 5421, 5427, 5429, 5430, 5434, 5441, 5451, 5465,
- 5466, 5471, 5477, 5492, 5495, 5505, 5515, 5525, 5529, 5532, 5539,
- 5541, 5556, 5566, 5568, 5574, 5595, 5602, 5611, 5616, 5622, 5628,
- 5655, 5662, 5675, 5689, 5722, 5724, 5728, 5731, 5746, 5764, 5771,
- 5781, 5801, 5809, 5810, 5812, 5841, 5848, 5853, 5854, 5858, 5892,
- 5907, 5910, 5913, 5920, 5929, 5949, 5952, 5955, 5962, 5975, 5985,
- 5997, 5998, 6012, 6016, 6026, 6036, 6040, 6045, 6055, 6059, 6088,
- 6115, 6124, 6127, 6132, 6146, 6158, 6169, 6206, 6228, 6237, 6244,
- 6247, 6256, 6281, 6282, 6284, 6296, 6299, 6302, 6325, 6349, 6352,
- 6362, 6383, 6386, 6395, 6397, 6415, 6424, 6429, 6439, 6451, 6489,
- 6496, 6502, 6511, 6514, 6520, 6523, 6529, 6532, 6547, 6549, 6598,
- 6601, 6610, 6622, 6632, 6655, 6665, 6666, 6695, 6701, 6709, 6710,
- 6741, 6745, 6758, 6767, 6772, 6782, 6797, 6800, 6843, 6845, 6860,
- 6865, 6878, 6887, 6888, 6901, 6906, 6940, 6947, 6953, 6954, 6959,
- 6961, 6964, 6991, 6993, 6999, 7016, 7029, 7036, 7045, 7076, 7083,
- 7094, 7097, 7123, 7130, 7139, 7145, 7146, 7178, 7186, 7192, 7198,
- 7222, 7269, 7270, 7276, 7287, 7307, 7315, 7334, 7340, 7351, 7352,
- 7357, 7360, 7363, 7384, 7396, 7403, 7406, 7425, 7437, 7445, 7450,
- 7455, 7461, 7466, 7488, 7494, 7515, 7517, 7521, 7536, 7546, 7569,
- 7591, 7592, 7598, 7612, 7623, 7632, 7637, 7644, 7657, 7665, 7672,
- 7682, 7699, 7702, 7724, 7749, 7753, 7754, 7761, 7771, 7777, 7784,
- 7804, 7807, 7808, 7818, 7835, 7842, 7865, 7868, 7880, 7883, 7891,
- 7897, 7907, 7910, 7924, 7933, 7934, 7942, 7948, 7959, 7984, 7994,
- 7999, 8014, 8021, 8041, 8049, 8050, 8068, 8080, 8095, 8102, 8106,
- 8120, 8133, 8134, 8143, 8162, 8168, 8179, -1 };
-
-static long PrimitivePolynomialDegree15[] = { 1, 8, 11, 22, 26, 47, 59,
- 64, 67, 73, 82, 97, 103, 110, 115, 122, 128, 138, 146, 171, 174, 176,
- 182, 194, 208, 211, 220, 229, 230, 239, 254, 265, 285, 290, 319, 324,
- 327, 333, 357, 364, 395, 397, 405, 409, 419, 422, 431, 433, 436, 440,
- 453, 460, 471, 478, 482, 488, 524, 529, 535, 536, 539, 563, 566, 572,
- 577, 587, 592, 602, 623, 635, 638, 654, 656, 659, 665, 675, 677, 687,
- 696, 701, 704, 710, 721, 728, 738, 740, 749, 758, 761, 772, 776, 782,
- 789, 810, 812, 818, 830, 832, 852, 855, 859, 865, 877, 895, 901, 902,
- 906, 916, 920, 949, 962, 964, 967, 981, 982, 985, 991, 1007, 1016,
- 1024, 1051, 1060, 1070, 1072, 1084, 1089, 1095, 1114, 1123, 1132,
- 1154, 1156, 1163, 1171, 1202, 1228, 1239, 1255, 1256, 1262, 1270,
- 1279, 1308, 1322, 1329, 1330, 1336, 1341, 1347, 1349, 1359, 1367,
- 1368, 1390, 1413, 1414, 1437, 1441, 1462, 1465, 1480, 1486, 1504,
- 1509, 1514, 1522, 1528, 1552, 1555, 1571, 1578, 1585, 1588, 1603,
- 1609, 1617, 1620, 1629, 1636, 1648, 1667, 1669, 1682, 1697, 1704,
- 1709, 1727, 1730, 1732, 1741, 1744, 1759, 1765, 1766, 1778, 1780,
- 1783, 1797, 1807, 1821, 1832, 1835, 1849, 1850, 1863, 1867, 1869,
- 1872, 1887, 1888, 1897, 1906, 1917, 1927, 1939, 1941, 1948, 1970,
- 1979, 1982, 2002, 2020, 2024, 2032, 2053, 2060, 2063, 2066, 2075,
- 2078, 2081, 2091, 2096, 2102, 2106, 2116, 2120, 2125, 2134, 2178,
- 2180, 2187, 2189, 2190, 2208, 2214, 2237, 2252, 2257, 2260, 2264,
- 2270, 2279, 2288, 2305, 2312, 2317, 2323, 2329, 2335, 2342, 2345,
- 2365, 2371, 2378, 2385, 2395, 2404, 2414, 2426, 2428, 2441, 2456,
- 2466, 2468, 2475, 2489, 2495, 2497, 2510, 2512, 2522, 2533, 2543,
- 2551, 2552, 2557, 2567, 2581, 2586, 2597, 2601, 2622, 2633, 2636,
- 2642, 2644, 2653, 2667, 2669, 2672, 2675, 2682, 2687, 2691, 2698,
- 2708, 2712, 2718, 2722, 2736, 2741, 2756, 2765, 2774, 2799, 2804,
- 2825, 2826, 2840, 2843, 2846, 2849, 2867, 2876, 2891, 2902, 2912,
- 2917, 2927, 2941, 2965, 2970, 2982, 2993, 3018, 3023, 3025, 3026,
- 3028, 3032, 3053, 3054, 3065, 3071, 3076, 3088, 3107, 3146, 3148,
- 3159, 3165, 3170, 3179, 3182, 3205, 3212, 3218, 3220, 3223, 3227,
- 3233, 3234, 3254, 3263, 3268, 3272, 3277, 3292, 3295, 3296, 3301,
- 3306, 3313, 3346, 3367, 3371, 3373, 3374, 3376, 3382, 3388, 3391,
- 3403, 3406, 3413, 3420, 3427, 3441, 3453, 3464, 3469, 3481, 3488,
- 3497, 3503, 3511, 3515, 3525, 3529, 3547, 3550, 3573, 3583, 3594,
- 3607, 3613, 3624, 3630, 3635, 3642, 3644, 3650, 3679, 3690, 3698,
- 3704, 3707, 3713, 3754, 3756, 3761, 3776, 3781, 3788, 3791, 3794,
- 3806, 3841, 3848, 3851, 3856, 3868, 3875, 3882, 3884, 3889, 3892,
- 3919, 3921, 3958, 3961, 3973, 3977, 3985, 3991, 4004, 4007, 4019,
- 4045, 4054, 4057, 4058, 4070, 4101, 4113, 4114, 4119, 4129, 4141,
- 4142, 4147, 4149, 4150, 4164, 4168, 4186, 4198, 4207, 4221, 4225,
- 4231, 4238, 4243, 4249, 4250, 4252, 4259, 4279, 4285, 4288, 4303,
- 4312, 4322, 4327, 4336, 4359, 4384, 4387, 4401, 4407, 4428, 4436,
- 4450, 4452, 4459, 4461, 4470, 4483, 4485, 4486, 4492, 4497, 4514,
- 4533, 4537, 4546, 4551, 4555, 4560, 4569, 4576, 4582, 4586, 4609,
- 4610, 4612, 4649, 4652, 4672, 4677, 4684, 4690, 4695, 4696, 4702,
- 4705, 4717, 4726, 4736, 4753, 4754, 4756, 4775, 4801, 4819, 4828,
- 4838, 4852, 4856, 4873, 4887, 4891, 4904, 4912, 4921, 4936, 4941,
- 4942, 4963, 4984, 4990, 5005, 5013, 5020, 5039, 5048, 5062, 5080,
- 5085, 5086, 5095, 5096, 5102, 5107, 5141, 5145, 5148, 5157, 5158,
- 5162, 5172, 5182, 5184, 5193, 5199, 5201, 5204, 5211, 5223, 5230,
- 5232, 5253, 5257, 5260, 5284, 5306, 5331, 5334, 5364, 5367, 5371,
- 5382, 5386, 5399, 5400, 5409, 5415, 5416, 5424, 5436, 5454, 5462,
- 5468, 5481, 5505, 5511, 5518, 5530, 5532, 5539, 5553, 5573, 5580,
- 5597, 5602, 5608, 5611, 5613, 5625, 5632, 5635, 5638, 5652, 5659,
- 5677, 5686, 5689, 5698, 5703, 5707, 5731, 5738, 5743, 5748, 5758,
- 5762, 5768, 5773, 5776, 5815, 5841, 5847, 5860, 5870, 5875, 5877,
- 5884, 5892, 5902, 5910, 5916, 5919, 5935, 5937, 5944, 5947, 5958,
- 5962, 5969, 5981, 5995, 5998, 6003, 6010, 6016, 6025, 6031, 6036,
- 6039, 6045, 6049, 6052, 6067, 6074, 6087, 6101, 6121, 6129, 6142,
- 6151, 6157, 6166, 6170, 6175, 6186, 6203, 6217, 6231, 6241, 6242,
- 6248, 6256, 6265, 6275, 6277, 6302, 6315, 6318, 6330, 6343, 6347,
- 6350, 6352, 6371, 6383, 6386, 6405, 6409, 6410, 6433, 6436, 6439,
- 6463, 6468, 6477, 6496, 6511, 6516, 6519, 6523, 6530, 6539, 6547,
- 6589, 6592, 6601, 6610, 6616, 6619, 6626, 6635, 6637, 6638, 6652,
- 6656, 6662, 6689, 6699, 6710, 6714, 6719, 6739, 6751, 6775, 6779,
- 6788, 6798, 6815, 6819, 6825, 6826, 6836, 6843, 6845, 6858, 6868,
- 6877, 6881, 6891, 6896, 6899, 6901, 6908, 6914, 6916, 6923, 6925,
- 6928, 6931, 6934, 6937, 6938, 6949, 6956, 6973, 6976, 6981, 6988,
- 6999, 7016, 7027, 7029, 7055, 7058, 7074, 7083, 7093, 7100, 7105,
- 7112, 7118, 7120, 7129, 7166, 7207, 7216, 7226, 7234, 7236, 7246,
- 7248, 7254, 7263, 7273, 7274, 7293, 7297, 7310, 7315, 7317, 7331,
- 7338, 7340, 7346, 7355, 7366, 7383, 7389, 7393, 7396, 7400, 7414,
- 7417, 7426, 7432, 7452, 7468, 7488, 7491, 7494, 7497, 7515, 7531,
- 7552, 7562, 7564, 7569, 7582, 7585, 7588, 7592, 7597, 7603, 7610,
- 7624, 7642, 7647, 7653, 7654, 7666, 7668, 7684, 7705, 7732, 7741,
- 7749, 7750, 7759, 7764, 7777, 7790, 7817, 7826, 7831, 7859, 7871,
- 7873, 7876, 7900, 7904, 7913, 7916, 7922, 7946, 7953, 7956, 7963,
- 7979, 7981, 7984, 7989, 7999, 8001, 8021, 8056, 8080, 8083, 8089,
- 8090, 8114, 8128, 8133, 8145, 8155, 8161, 8182, 8186, 8191, 8192,
- 8195, 8201, 8207, 8210, 8228, 8249, 8252, 8258, 8267, 8270, 8275,
- 8284, 8293, 8298, 8305, 8317, 8328, 8336, 8345, 8351, 8367, 8379,
- 8381, 8382, 8393, 8402, 8414, 8417, 8420, 8429, 8435, 8438, 8450,
- 8452, 8459, 8470, 8486, 8490, 8500, 8524, 8536, 8552, 8558, 8570,
- 8576, 8582, 8594, 8606, 8619, 8621, 8624, 8633, 8641, 8653, 8654,
- 8662, 8675, 8689, 8695, 8702, 8706, 8720, 8729, 8739, 8741, 8751,
- 8759, 8766, 8777, 8783, 8786, 8795, 8802, 8814, 8821, 8828, 8831,
- 8837, 8842, 8855, 8856, 8868, 8877, 8890, 8892, 8900, 8909, 8912,
- 8921, 8922, 8927, 8943, 8948, 8951, 8958, 8984, 8994, 9000, 9013,
- 9018, 9020, 9031, 9035, 9045, 9052, 9056, 9059, 9066, 9076, 9089,
- 9129, 9132, 9147, 9164, 9167, 9185, 9195, 9197, 9210, 9217, 9229,
- 9248, 9254, 9263, 9266, 9268, 9290, 9310, 9316, 9338, 9340, 9343,
- 9344, 9350, 9354, 9359, 9361, 9364, 9368, 9371, 9373, 9389, 9390,
- 9409, 9443, 9445, 9446, 9452, 9490, 9492, 9495, 9508, 9523, 9543,
- 9558, 9567, 9580, 9585, 9591, 9611, 9613, 9614, 9621, 9631, 9642,
- 9656, 9661, 9667, 9694, 9715, 9722, 9738, 9745, 9758, 9764, 9782,
- 9791, 9793, 9794, 9805, 9808, 9811, 9817, 9824, 9836, 9851, 9853,
- 9854, 9877, 9881, 9923, 9935, 9937, 9954, 9959, 9963, 9968, 9973,
- 9974, 9980, 9983, 9985, 10003, 10010, 10034, 10040, 10063, 10077,
- 10081, 10082, 10084, 10088, 10091, 10105, 10111, 10118, 10127, 10135,
- 10169, 10172, 10183, 10190, 10192, 10211, 10218, 10228, 10235, 10242,
- 10244, 10271, 10278, 10296, 10299, 10307, 10309, 10310, 10314, 10316,
- 10321, 10328, 10338, 10343, 10344, 10347, 10352, 10364, 10373, 10386,
- 10391, 10398, 10408, 10413, 10422, 10445, 10460, 10463, 10464, 10474,
- 10476, 10487, 10494, 10499, 10506, 10513, 10516, 10523, 10539, 10549,
- 10550, 10567, 10576, 10625, 10635, 10643, 10656, 10671, 10676, 10683,
- 10685, 10688, 10697, 10700, 10712, 10724, 10728, 10734, 10739, 10762,
- 10772, 10781, 10800, 10805, 10827, 10830, 10837, 10841, 10847, 10848,
- 10857, 10866, 10868, 10872, 10887, 10899, 10901, 10915, 10924, 10929,
- 10942, 10971, 10992, 10995, 11002, 11010, 11027, 11029, 11045, 11057,
- 11070, 11092, 11099, 11106, 11115, 11120, 11126, 11153, 11190, 11199,
- 11222, 11225, 11226, 11231, 11244, 11259, 11261, 11270, 11273, 11300,
- 11307, 11318, 11332, 11335, 11341, 11347, 11354, 11360, 11369, 11372,
- 11378, 11396, 11405, 11417, 11424, 11427, 11430, 11439, 11442, 11448,
- 11461, 11468, 11471, 11473, 11476, 11480, 11489, 11499, 11516, 11522,
- 11531, 11539, 11546, 11551, 11564, 11582, 11589, 11593, 11601, 11608,
- 11617, 11630, 11663, 11666, 11668, 11677, 11682, 11687, 11696, 11713,
- 11728, 11747, 11750, 11754, 11759, 11761, 11764, 11767, 11797, 11804,
- 11808, 11831, 11832, 11849, 11855, 11863, 11880, 11883, 11885, 11898,
- 11916, 11924, 11928, 11947, 11955, 11961, 11962, 11982, 11990, 12010,
- 12018, 12027, 12029, 12035, 12055, 12062, 12068, 12071, 12072, 12086,
- 12097, 12098, 12100, 12112, 12118, 12133, 12134, 12137, 12161, 12162,
- 12171, 12174, 12185, 12204, 12212, 12215, 12216, 12253, 12260, 12277,
- 12289, 12295, 12314, 12323, 12325, 12335, 12349, 12358, 12372, 12376,
- 12379, 12386, 12395, 12416, 12421, 12440, 12452, 12455, 12456, 12462,
- 12467, 12479, 12505, 12521, 12535, 12547, 12556, 12561, 12568, 12578,
- 12583, 12595, 12604, 12610, 12621, 12622, 12624, 12629, 12630, 12639,
- 12640, 12650, 12679, 12680, 12698, 12716, 12721, 12722, 12731, 12742,
- 12745, 12751, 12759, 12763, 12769, 12781, 12793, 12799, 12815, 12824,
- 12836, 12845, 12853, 12854, 12857, 12866, 12872, 12875, 12878, 12880,
- 12885, 12901, 12902, 12920, 12926, 12929, 12939, 12941, 12950, 12953,
- 12992, 13002, 13010, 13058, 13072, 13084, 13087, 13091, 13097, 13108,
- 13123, 13149, 13150, 13163, 13166, 13178, 13180, 13184, 13204, 13238,
- 13242, 13249, 13255, 13269, 13270, 13274, 13285, 13289, 13298, 13307,
- 13312, 13335, 13345, 13357, 13366, 13372, 13380, 13384, 13395, 13407,
- 13408, 13413, 13414, 13417, 13437, 13441, 13447, 13456, 13459, 13461,
- 13466, 13484, 13487, 13489, 13492, 13496, 13510, 13531, 13538, 13543,
- 13547, 13572, 13581, 13590, 13605, 13612, 13624, 13630, 13632, 13638,
- 13661, 13665, 13668, 13686, 13699, 13701, 13708, 13716, 13725, 13730,
- 13742, 13747, 13749, 13753, 13754, 13771, 13773, 13782, 13785, 13798,
- 13802, 13809, 13828, 13832, 13840, 13850, 13861, 13874, 13876, 13886,
- 13897, 13900, 13915, 13927, 13951, 13955, 13962, 13969, 13979, 13988,
- 13998, 14000, 14005, 14027, 14037, 14051, 14054, 14060, 14063, 14071,
- 14078, 14080, 14085, 14086, 14095, 14138, 14145, 14158, 14166, 14179,
- 14181, 14188, 14193, 14200, 14203, 14215, 14224, 14230, 14233, 14236,
- 14246, 14267, 14282, 14287, 14301, 14323, 14325, 14329, 14339, 14342,
- 14351, 14356, 14359, 14370, 14402, 14411, 14421, 14431, 14435, 14442,
- 14447, 14456, 14459, 14472, 14477, 14490, 14496, 14501, 14505, 14513,
- 14520, 14534, 14562, 14576, 14579, 14585, 14586, 14606, 14627, 14630,
- 14634, 14636, 14647, 14653, 14659, 14671, 14674, 14701, 14716, 14719,
- 14720, 14725, 14730, 14743, 14747, 14786, 14788, 14792, 14795, 14809,
- 14831, 14834, 14850, 14855, 14859, 14864, 14876, 14889, 14890, 14898,
- 14909, 14917, 14924, 14929, 14942, 14951, 14969, 14970, 14972, 14982,
- 14988, 14994, 15005, 15016, 15024, 15030, 15048, 15054, 15066, 15071,
- 15072, 15075, 15119, 15121, 15133, 15138, 15143, 15170, 15194, 15212,
- 15223, 15229, 15254, 15263, 15270, 15273, 15287, 15299, 15301, 15306,
- 15313, 15320, 15323, 15329, 15332, 15341, 15359, 15361, 15364, 15367,
- 15379, 15391, 15415, 15416, 15419, 15433, 15469, 15478, 15481, 15482,
- 15498, 15505, 15517, 15518, 15527, 15528, 15545, 15548, 15554, 15565,
- 15577, 15580, 15587, 15601, 15604, 15611, 15616, 15619, 15625, 15633,
- 15674, 15681, 15691, 15693, 15696, 15712, 15717, 15724, 15727, 15730,
- 15746, 15751, 15760, 15770, 15782, 15791, 15796, 15808, 15814, 15825,
- 15828, 15835, 15844, 15847, 15853, 15856, 15877, 15878, 15887, 15908,
- 15917, 15923, 15930, 15937, 15958, 15977, 15991, 16007, 16011, 16014,
- 16021, 16022, 16028, 16035, 16041, 16056, 16069, 16076, 16081, 16087,
- 16088, 16110, 16112, 16117, 16150, 16153, 16160, 16166, 16172, 16190,
- 16195, 16204, 16216, 16222, 16228, 16245, 16255, 16265, 16273, 16276,
- 16283, 16295, 16304, 16313, 16319, 16328, 16345, 16355, 16364, 16372,
- 16375, 16382, -1 };
-
-
-/** Array with all the precomputed primitive polynomials in this file.
-    The user can add more if needed, by also updating the macros MAX_PRIMITIVEPOLY
-    and MAX_PRIMITIVEDEGREE
-*/
-static long* PrimitivePolynomials[] = 
-{
-	PrimitivePolynomialDegree1,
-	PrimitivePolynomialDegree2,
-	PrimitivePolynomialDegree3,
-	PrimitivePolynomialDegree4,
-	PrimitivePolynomialDegree5,
-	PrimitivePolynomialDegree6,
-	PrimitivePolynomialDegree7,
-	PrimitivePolynomialDegree8,
-	PrimitivePolynomialDegree9,
-	PrimitivePolynomialDegree10,
-	PrimitivePolynomialDegree11,
-	PrimitivePolynomialDegree12,
-	PrimitivePolynomialDegree13,
-	PrimitivePolynomialDegree14,
-	PrimitivePolynomialDegree15
-};
-
-#endif  //  ORF_PRIMITIVEPOLYNOMIALS_HPP
+/** 
+*   @file  primitivepolynomials.hpp
+*   @brief Encoding of primitive polynomials mod 2
+*          Adapted from Peter Jaeckel's CD from the book "Monte Carlo Methods in Finance"
+*/
+
+#ifndef ORF_PRIMITIVEPOLYNOMIALS_HPP
+#define ORF_PRIMITIVEPOLYNOMIALS_HPP
+
+#define MAX_PRIMITIVEPOLY 3666        // maximum number of polynomials
+#define MAX_PRIMITIVEDEGREE 15        // maximum order
+
+/**
+    Precomputed primitive polynomials mod 2.
+    Adapted from Peter Jaeckel's code in "Monte Carlo Methods in Finance", Wiley 2002
+
+    Encoding scheme:
+    
+    Each polynomial is represented by a base-10 integer, whose binary representation 
+    contains the coefficients of the polynomial, except the first and the last one.
+    The first and last coefficient of every primitive polynomial are equal to 1.
+
+    Example: The coefficients of the primitive polynomial x^4  + x^2  + 1
+    create the binary representation 10101
+    Stripping off the first and last bits we get 010
+    The polynomial is encoded as the base-10 number 2.
+*/
+
+static long PrimitivePolynomialDegree1[] = { 0, -1 };
+
+static long PrimitivePolynomialDegree2[] = { 1, -1 };
+
+static long PrimitivePolynomialDegree3[] = { 1, 2, -1 };
+
+static long PrimitivePolynomialDegree4[] = { 1, 4, -1 };
+
+static long PrimitivePolynomialDegree5[] = { 2, 4, 7, 11, 13, 14, -1 };
+
+static long PrimitivePolynomialDegree6[] = { 1, 13, 16, 19, 22, 25, -1 };
+
+static long PrimitivePolynomialDegree7[] = { 1, 4, 7, 8, 14, 19, 21, 28,
+  31, 32, 37, 41, 42, 50, 55, 56, 59, 62, -1 };
+
+static long PrimitivePolynomialDegree8[] = { 14, 21, 22, 38, 47, 49, 50,
+  52, 56, 67, 70, 84, 97, 103, 115, 122, -1 };
+
+static long PrimitivePolynomialDegree9[] = { 8, 13, 16, 22, 25, 44, 47,
+  52, 55, 59, 62, 67, 74, 81, 82, 87, 91, 94, 103, 104, 109, 122, 124,
+  137, 138, 143, 145, 152, 157, 167, 173, 176, 181, 182, 185, 191,
+  194, 199, 218, 220, 227, 229, 230, 234, 236, 241, 244, 253, -1 };
+
+static long PrimitivePolynomialDegree10[] = { 4, 13, 19, 22, 50, 55, 64,
+  69, 98, 107, 115, 121, 127, 134, 140, 145, 152, 158, 161, 171, 181,
+  194, 199, 203, 208, 227, 242, 251, 253, 265, 266, 274, 283, 289,
+  295, 301, 316, 319, 324, 346, 352, 361, 367, 382, 395, 398, 400,
+  412, 419, 422, 426, 428, 433, 446, 454, 457, 472, 493, 505, 508, -1  };
+
+static long PrimitivePolynomialDegree11[] = { 2, 11, 21, 22, 35, 49, 50,
+  56, 61, 70, 74, 79, 84, 88, 103, 104, 112, 115, 117, 122, 134, 137,
+  146, 148, 157, 158, 162, 164, 168, 173, 185, 186, 191, 193, 199,
+  213, 214, 220, 227, 236, 242, 251, 256, 259, 265, 266, 276, 292,
+  304, 310, 316, 319, 322, 328, 334, 339, 341, 345, 346, 362, 367,
+  372, 375, 376, 381, 385, 388, 392, 409, 415, 416, 421, 428, 431,
+  434, 439, 446, 451, 453, 457, 458, 471, 475, 478, 484, 493, 494,
+  499, 502, 517, 518, 524, 527, 555, 560, 565, 569, 578, 580, 587,
+  589, 590, 601, 607, 611, 614, 617, 618, 625, 628, 635, 641, 647,
+  654, 659, 662, 672, 675, 682, 684, 689, 695, 696, 713, 719, 724,
+  733, 734, 740, 747, 749, 752, 755, 762, 770, 782, 784, 787, 789,
+  793, 796, 803, 805, 810, 815, 824, 829, 830, 832, 841, 847, 849,
+  861, 871, 878, 889, 892, 901, 908, 920, 923, 942, 949, 950, 954,
+  961, 968, 971, 973, 979, 982, 986, 998, 1001, 1010, 1012, -1 };
+
+static long PrimitivePolynomialDegree12[] = { 41, 52, 61, 62, 76, 104,
+  117, 131, 143, 145, 157, 167, 171, 176, 181, 194, 217, 236, 239,
+  262, 283, 286, 307, 313, 319, 348, 352, 357, 391, 398, 400, 412,
+  415, 422, 440, 460, 465, 468, 515, 536, 539, 551, 558, 563, 570,
+  595, 598, 617, 647, 654, 678, 713, 738, 747, 750, 757, 772, 803,
+  810, 812, 850, 862, 906, 908, 929, 930, 954, 964, 982, 985, 991,
+  992, 1067, 1070, 1096, 1099, 1116, 1143, 1165, 1178, 1184, 1202,
+  1213, 1221, 1240, 1246, 1252, 1255, 1267, 1293, 1301, 1305, 1332,
+  1349, 1384, 1392, 1402, 1413, 1417, 1423, 1451, 1480, 1491, 1503,
+  1504, 1513, 1538, 1544, 1547, 1555, 1574, 1603, 1615, 1618, 1629,
+  1634, 1636, 1639, 1657, 1667, 1681, 1697, 1704, 1709, 1722, 1730,
+  1732, 1802, 1804, 1815, 1826, 1832, 1843, 1849, 1863, 1905, 1928,
+  1933, 1939, 1976, 1996, 2013, 2014, 2020, -1 };
+
+static long PrimitivePolynomialDegree13[] = { 13, 19, 26, 41, 50, 55,
+ 69, 70, 79, 82, 87, 93, 94, 97, 100, 112, 121, 134, 138, 148, 151,
+ 157, 161, 179, 181, 188, 196, 203, 206, 223, 224, 227, 230, 239, 241,
+ 248, 253, 268, 274, 283, 286, 289, 301, 302, 316, 319, 324, 331, 333,
+ 345, 351, 358, 375, 379, 381, 386, 403, 405, 419, 426, 428, 439, 440,
+ 446, 451, 454, 458, 465, 468, 472, 475, 477, 496, 502, 508, 517, 521,
+ 527, 530, 532, 542, 552, 555, 560, 566, 575, 577, 589, 590, 602, 607,
+ 608, 611, 613, 625, 644, 651, 654, 656, 662, 668, 681, 682, 689, 696,
+ 699, 707, 709, 714, 716, 719, 727, 734, 738, 743, 747, 757, 769, 770,
+ 776, 790, 799, 805, 809, 812, 820, 827, 829, 835, 841, 844, 856, 859,
+ 862, 865, 885, 890, 905, 916, 925, 935, 939, 942, 949, 953, 956, 961,
+ 968, 976, 988, 995, 997, 1007, 1015, 1016, 1027, 1036, 1039, 1041,
+ 1048, 1053, 1054, 1058, 1075, 1082, 1090, 1109, 1110, 1119, 1126,
+ 1130, 1135, 1137, 1140, 1149, 1156, 1159, 1160, 1165, 1173, 1178,
+ 1183, 1184, 1189, 1194, 1211, 1214, 1216, 1225, 1231, 1239, 1243,
+ 1246, 1249, 1259, 1273, 1274, 1281, 1287, 1294, 1296, 1305, 1306,
+ 1318, 1332, 1335, 1336, 1341, 1342, 1362, 1364, 1368, 1378, 1387,
+ 1389, 1397, 1401, 1408, 1418, 1425, 1426, 1431, 1435, 1441, 1444,
+ 1462, 1471, 1474, 1483, 1485, 1494, 1497, 1516, 1522, 1534, 1543,
+ 1552, 1557, 1558, 1567, 1568, 1574, 1592, 1605, 1606, 1610, 1617,
+ 1623, 1630, 1634, 1640, 1643, 1648, 1651, 1653, 1670, 1676, 1684,
+ 1687, 1691, 1693, 1698, 1709, 1715, 1722, 1732, 1735, 1747, 1749,
+ 1754, 1777, 1784, 1790, 1795, 1801, 1802, 1812, 1828, 1831, 1837,
+ 1838, 1840, 1845, 1863, 1864, 1867, 1870, 1877, 1881, 1884, 1903,
+ 1917, 1918, 1922, 1924, 1928, 1931, 1951, 1952, 1957, 1958, 1964,
+ 1967, 1970, 1972, 1994, 2002, 2007, 2008, 2023, 2030, 2035, 2038,
+ 2042, 2047, 2051, 2058, 2060, 2071, 2084, 2087, 2099, 2108, 2111,
+ 2120, 2128, 2138, 2143, 2144, 2153, 2156, 2162, 2167, 2178, 2183,
+ 2202, 2211, 2214, 2223, 2225, 2232, 2237, 2257, 2260, 2267, 2274,
+ 2276, 2285, 2288, 2293, 2294, 2297, 2303, 2308, 2311, 2318, 2323,
+ 2332, 2341, 2345, 2348, 2354, 2368, 2377, 2380, 2383, 2388, 2395,
+ 2397, 2401, 2411, 2413, 2419, 2435, 2442, 2455, 2472, 2478, 2490,
+ 2507, 2509, 2517, 2524, 2528, 2531, 2538, 2545, 2546, 2555, 2557,
+ 2564, 2573, 2579, 2592, 2598, 2607, 2612, 2619, 2621, 2627, 2633,
+ 2636, 2642, 2654, 2660, 2669, 2675, 2684, 2694, 2703, 2706, 2712,
+ 2715, 2722, 2727, 2734, 2742, 2745, 2751, 2766, 2768, 2780, 2790,
+ 2794, 2796, 2801, 2804, 2807, 2816, 2821, 2831, 2834, 2839, 2845,
+ 2852, 2856, 2861, 2873, 2874, 2888, 2893, 2894, 2902, 2917, 2921,
+ 2922, 2929, 2935, 2946, 2951, 2957, 2960, 2966, 2972, 2976, 2979,
+ 2985, 3000, 3003, 3013, 3018, 3020, 3025, 3042, 3047, 3048, 3051,
+ 3054, 3056, 3065, 3073, 3074, 3083, 3086, 3091, 3097, 3109, 3116,
+ 3124, 3128, 3153, 3160, 3165, 3172, 3175, 3184, 3193, 3196, 3200,
+ 3203, 3205, 3209, 3224, 3239, 3251, 3254, 3265, 3266, 3275, 3280,
+ 3283, 3286, 3301, 3302, 3305, 3319, 3323, 3326, 3331, 3348, 3351,
+ 3358, 3368, 3374, 3376, 3379, 3385, 3386, 3396, 3420, 3423, 3430,
+ 3433, 3434, 3439, 3442, 3444, 3453, 3464, 3477, 3478, 3482, 3487,
+ 3497, 3500, 3505, 3506, 3511, 3512, 3515, 3525, 3532, 3538, 3540,
+ 3547, 3549, 3560, 3571, 3577, 3583, 3590, 3593, 3594, 3599, 3601,
+ 3602, 3613, 3623, 3630, 3638, 3649, 3655, 3662, 3667, 3669, 3676,
+ 3683, 3700, 3709, 3710, 3713, 3723, 3725, 3728, 3734, 3737, 3738,
+ 3744, 3750, 3762, 3764, 3774, 3776, 3786, 3800, 3803, 3809, 3816,
+ 3821, 3827, 3829, 3836, 3842, 3844, 3847, 3853, 3861, 3871, 3872,
+ 3881, 3890, 3892, 3909, 3921, 3934, 3938, 3947, 3950, 3952, 3964,
+ 3974, 3980, 3983, 3986, 3995, 3998, 4001, 4002, 4004, 4008, 4011,
+ 4016, 4033, 4036, 4040, 4053, 4058, 4081, 4091, 4094, -1 };
+
+static long PrimitivePolynomialDegree14[] = { 21, 28, 41, 47, 61, 84,
+ 87, 93, 94, 103, 117, 121, 134, 137, 157, 161, 205, 206, 211, 214,
+ 218, 234, 236, 248, 262, 299, 304, 319, 322, 334, 355, 357, 358, 369,
+ 372, 375, 388, 400, 415, 446, 451, 458, 471, 484, 501, 502, 517, 545,
+ 569, 617, 618, 623, 625, 637, 661, 668, 684, 695, 716, 719, 722, 731,
+ 738, 747, 755, 761, 767, 775, 782, 787, 794, 803, 812, 817, 824, 829,
+ 850, 866, 871, 877, 920, 935, 959, 979, 992, 1010, 1012, 1015, 1033,
+ 1036, 1053, 1057, 1069, 1072, 1075, 1087, 1089, 1137, 1166, 1174,
+ 1180, 1204, 1211, 1219, 1236, 1255, 1264, 1306, 1330, 1341, 1344,
+ 1347, 1349, 1361, 1380, 1390, 1404, 1435, 1444, 1453, 1461, 1462,
+ 1465, 1468, 1474, 1483, 1488, 1493, 1500, 1509, 1510, 1514, 1519,
+ 1528, 1533, 1540, 1550, 1567, 1571, 1573, 1578, 1598, 1606, 1618,
+ 1630, 1634, 1640, 1643, 1654, 1679, 1688, 1698, 1703, 1704, 1722,
+ 1735, 1750, 1753, 1760, 1789, 1792, 1802, 1819, 1825, 1828, 1832,
+ 1845, 1846, 1857, 1869, 1897, 1906, 1908, 1911, 1934, 1962, 1967,
+ 1972, 1975, 1999, 2004, 2011, 2013, 2037, 2051, 2063, 2066, 2094,
+ 2128, 2154, 2164, 2198, 2217, 2220, 2223, 2238, 2245, 2252, 2258,
+ 2264, 2280, 2285, 2293, 2294, 2298, 2303, 2306, 2311, 2326, 2354,
+ 2373, 2380, 2385, 2392, 2401, 2402, 2408, 2419, 2450, 2452, 2477,
+ 2509, 2510, 2515, 2524, 2527, 2531, 2552, 2561, 2567, 2571, 2586,
+ 2588, 2595, 2607, 2621, 2630, 2639, 2653, 2670, 2672, 2700, 2711,
+ 2715, 2748, 2751, 2753, 2754, 2760, 2774, 2784, 2793, 2804, 2811,
+ 2822, 2826, 2836, 2839, 2840, 2893, 2901, 2902, 2905, 2912, 2915,
+ 2918, 2939, 2965, 2966, 2975, 2988, 2993, 3006, 3017, 3031, 3038,
+ 3041, 3042, 3051, 3073, 3088, 3097, 3098, 3103, 3104, 3146, 3148,
+ 3153, 3159, 3182, 3187, 3189, 3199, 3239, 3263, 3271, 3275, 3278,
+ 3280, 3283, 3290, 3311, 3316, 3343, 3346, 3357, 3358, 3361, 3362,
+ 3364, 3386, 3418, 3424, 3433, 3434, 3436, 3463, 3467, 3477, 3484,
+ 3505, 3508, 3515, 3532, 3553, 3554, 3568, 3573, 3587, 3589, 3596,
+ 3608, 3620, 3630, 3644, 3649, 3664, 3679, 3680, 3685, 3686, 3698,
+ 3714, 3726, 3737, 3767, 3782, 3786, 3793, 3796, 3805, 3815, 3841,
+ 3847, 3853, 3862, 3875, 3902, 3904, 3916, 3947, 3949, 3955, 3962,
+ 3971, 3980, 3985, 3998, 4001, 4002, 4016, 4021, 4026, 4043, 4079,
+ 4102, 4106, 4119, 4126, 4147, 4149, 4164, 4174, 4181, 4185, 4188,
+ 4202, 4228, 4232, 4246, 4252, 4256, 4286, 4303, 4306, 4311, 4317,
+ 4342, 4346, 4377, 4401, 4407, 4414, 4422, 4431, 4434, 4436, 4443,
+ 4459, 4461, 4462, 4473, 4497, 4504, 4507, 4525, 4534, 4538, 4548,
+ 4552, 4560, 4575, 4599, 4612, 4619, 4640, 4643, 4677, 4687, 4723,
+ 4730, 4736, 4741, 4763, 4765, 4770, 4781, 4808, 4822, 4828, 4831,
+ 4842, 4855, 4859, 4867, 4870, 4881, 4893, 4910, 4917, 4929, 4939,
+ 4947, 4949, 4954, 4972, 4975, 5000, 5005, 5029, 5039, 5044, 5051,
+ 5056, 5073, 5096, 5128, 5134, 5161, 5179, 5193, 5199, 5202, 5204,
+ 5218, 5247, 5260, 5271, 5301, 5305, 5319, 5326, 5328, 5333, 5364,
+ 5376, 5399, 5416, 5421, 5427, 5429, 5430, 5434, 5441, 5451, 5465,
+ 5466, 5471, 5477, 5492, 5495, 5505, 5515, 5525, 5529, 5532, 5539,
+ 5541, 5556, 5566, 5568, 5574, 5595, 5602, 5611, 5616, 5622, 5628,
+ 5655, 5662, 5675, 5689, 5722, 5724, 5728, 5731, 5746, 5764, 5771,
+ 5781, 5801, 5809, 5810, 5812, 5841, 5848, 5853, 5854, 5858, 5892,
+ 5907, 5910, 5913, 5920, 5929, 5949, 5952, 5955, 5962, 5975, 5985,
+ 5997, 5998, 6012, 6016, 6026, 6036, 6040, 6045, 6055, 6059, 6088,
+ 6115, 6124, 6127, 6132, 6146, 6158, 6169, 6206, 6228, 6237, 6244,
+ 6247, 6256, 6281, 6282, 6284, 6296, 6299, 6302, 6325, 6349, 6352,
+ 6362, 6383, 6386, 6395, 6397, 6415, 6424, 6429, 6439, 6451, 6489,
+ 6496, 6502, 6511, 6514, 6520, 6523, 6529, 6532, 6547, 6549, 6598,
+ 6601, 6610, 6622, 6632, 6655, 6665, 6666, 6695, 6701, 6709, 6710,
+ 6741, 6745, 6758, 6767, 6772, 6782, 6797, 6800, 6843, 6845, 6860,
+ 6865, 6878, 6887, 6888, 6901, 6906, 6940, 6947, 6953, 6954, 6959,
+ 6961, 6964, 6991, 6993, 6999, 7016, 7029, 7036, 7045, 7076, 7083,
+ 7094, 7097, 7123, 7130, 7139, 7145, 7146, 7178, 7186, 7192, 7198,
+ 7222, 7269, 7270, 7276, 7287, 7307, 7315, 7334, 7340, 7351, 7352,
+ 7357, 7360, 7363, 7384, 7396, 7403, 7406, 7425, 7437, 7445, 7450,
+ 7455, 7461, 7466, 7488, 7494, 7515, 7517, 7521, 7536, 7546, 7569,
+ 7591, 7592, 7598, 7612, 7623, 7632, 7637, 7644, 7657, 7665, 7672,
+ 7682, 7699, 7702, 7724, 7749, 7753, 7754, 7761, 7771, 7777, 7784,
+ 7804, 7807, 7808, 7818, 7835, 7842, 7865, 7868, 7880, 7883, 7891,
+ 7897, 7907, 7910, 7924, 7933, 7934, 7942, 7948, 7959, 7984, 7994,
+ 7999, 8014, 8021, 8041, 8049, 8050, 8068, 8080, 8095, 8102, 8106,
+ 8120, 8133, 8134, 8143, 8162, 8168, 8179, -1 };
+
+static long PrimitivePolynomialDegree15[] = { 1, 8, 11, 22, 26, 47, 59,
+ 64, 67, 73, 82, 97, 103, 110, 115, 122, 128, 138, 146, 171, 174, 176,
+ 182, 194, 208, 211, 220, 229, 230, 239, 254, 265, 285, 290, 319, 324,
+ 327, 333, 357, 364, 395, 397, 405, 409, 419, 422, 431, 433, 436, 440,
+ 453, 460, 471, 478, 482, 488, 524, 529, 535, 536, 539, 563, 566, 572,
+ 577, 587, 592, 602, 623, 635, 638, 654, 656, 659, 665, 675, 677, 687,
+ 696, 701, 704, 710, 721, 728, 738, 740, 749, 758, 761, 772, 776, 782,
+ 789, 810, 812, 818, 830, 832, 852, 855, 859, 865, 877, 895, 901, 902,
+ 906, 916, 920, 949, 962, 964, 967, 981, 982, 985, 991, 1007, 1016,
+ 1024, 1051, 1060, 1070, 1072, 1084, 1089, 1095, 1114, 1123, 1132,
+ 1154, 1156, 1163, 1171, 1202, 1228, 1239, 1255, 1256, 1262, 1270,
+ 1279, 1308, 1322, 1329, 1330, 1336, 1341, 1347, 1349, 1359, 1367,
+ 1368, 1390, 1413, 1414, 1437, 1441, 1462, 1465, 1480, 1486, 1504,
+ 1509, 1514, 1522, 1528, 1552, 1555, 1571, 1578, 1585, 1588, 1603,
+ 1609, 1617, 1620, 1629, 1636, 1648, 1667, 1669, 1682, 1697, 1704,
+ 1709, 1727, 1730, 1732, 1741, 1744, 1759, 1765, 1766, 1778, 1780,
+ 1783, 1797, 1807, 1821, 1832, 1835, 1849, 1850, 1863, 1867, 1869,
+ 1872, 1887, 1888, 1897, 1906, 1917, 1927, 1939, 1941, 1948, 1970,
+ 1979, 1982, 2002, 2020, 2024, 2032, 2053, 2060, 2063, 2066, 2075,
+ 2078, 2081, 2091, 2096, 2102, 2106, 2116, 2120, 2125, 2134, 2178,
+ 2180, 2187, 2189, 2190, 2208, 2214, 2237, 2252, 2257, 2260, 2264,
+ 2270, 2279, 2288, 2305, 2312, 2317, 2323, 2329, 2335, 2342, 2345,
+ 2365, 2371, 2378, 2385, 2395, 2404, 2414, 2426, 2428, 2441, 2456,
+ 2466, 2468, 2475, 2489, 2495, 2497, 2510, 2512, 2522, 2533, 2543,
+ 2551, 2552, 2557, 2567, 2581, 2586, 2597, 2601, 2622, 2633, 2636,
+ 2642, 2644, 2653, 2667, 2669, 2672, 2675, 2682, 2687, 2691, 2698,
+ 2708, 2712, 2718, 2722, 2736, 2741, 2756, 2765, 2774, 2799, 2804,
+ 2825, 2826, 2840, 2843, 2846, 2849, 2867, 2876, 2891, 2902, 2912,
+ 2917, 2927, 2941, 2965, 2970, 2982, 2993, 3018, 3023, 3025, 3026,
+ 3028, 3032, 3053, 3054, 3065, 3071, 3076, 3088, 3107, 3146, 3148,
+ 3159, 3165, 3170, 3179, 3182, 3205, 3212, 3218, 3220, 3223, 3227,
+ 3233, 3234, 3254, 3263, 3268, 3272, 3277, 3292, 3295, 3296, 3301,
+ 3306, 3313, 3346, 3367, 3371, 3373, 3374, 3376, 3382, 3388, 3391,
+ 3403, 3406, 3413, 3420, 3427, 3441, 3453, 3464, 3469, 3481, 3488,
+ 3497, 3503, 3511, 3515, 3525, 3529, 3547, 3550, 3573, 3583, 3594,
+ 3607, 3613, 3624, 3630, 3635, 3642, 3644, 3650, 3679, 3690, 3698,
+ 3704, 3707, 3713, 3754, 3756, 3761, 3776, 3781, 3788, 3791, 3794,
+ 3806, 3841, 3848, 3851, 3856, 3868, 3875, 3882, 3884, 3889, 3892,
+ 3919, 3921, 3958, 3961, 3973, 3977, 3985, 3991, 4004, 4007, 4019,
+ 4045, 4054, 4057, 4058, 4070, 4101, 4113, 4114, 4119, 4129, 4141,
+ 4142, 4147, 4149, 4150, 4164, 4168, 4186, 4198, 4207, 4221, 4225,
+ 4231, 4238, 4243, 4249, 4250, 4252, 4259, 4279, 4285, 4288, 4303,
+ 4312, 4322, 4327, 4336, 4359, 4384, 4387, 4401, 4407, 4428, 4436,
+ 4450, 4452, 4459, 4461, 4470, 4483, 4485, 4486, 4492, 4497, 4514,
+ 4533, 4537, 4546, 4551, 4555, 4560, 4569, 4576, 4582, 4586, 4609,
+ 4610, 4612, 4649, 4652, 4672, 4677, 4684, 4690, 4695, 4696, 4702,
+ 4705, 4717, 4726, 4736, 4753, 4754, 4756, 4775, 4801, 4819, 4828,
+ 4838, 4852, 4856, 4873, 4887, 4891, 4904, 4912, 4921, 4936, 4941,
+ 4942, 4963, 4984, 4990, 5005, 5013, 5020, 5039, 5048, 5062, 5080,
+ 5085, 5086, 5095, 5096, 5102, 5107, 5141, 5145, 5148, 5157, 5158,
+ 5162, 5172, 5182, 5184, 5193, 5199, 5201, 5204, 5211, 5223, 5230,
+ 5232, 5253, 5257, 5260, 5284, 5306, 5331, 5334, 5364, 5367, 5371,
+ 5382, 5386, 5399, 5400, 5409, 5415, 5416, 5424, 5436, 5454, 5462,
+ 5468, 5481, 5505, 5511, 5518, 5530, 5532, 5539, 5553, 5573, 5580,
+ 5597, 5602, 5608, 5611, 5613, 5625, 5632, 5635, 5638, 5652, 5659,
+ 5677, 5686, 5689, 5698, 5703, 5707, 5731, 5738, 5743, 5748, 5758,
+ 5762, 5768, 5773, 5776, 5815, 5841, 5847, 5860, 5870, 5875, 5877,
+ 5884, 5892, 5902, 5910, 5916, 5919, 5935, 5937, 5944, 5947, 5958,
+ 5962, 5969, 5981, 5995, 5998, 6003, 6010, 6016, 6025, 6031, 6036,
+ 6039, 6045, 6049, 6052, 6067, 6074, 6087, 6101, 6121, 6129, 6142,
+ 6151, 6157, 6166, 6170, 6175, 6186, 6203, 6217, 6231, 6241, 6242,
+ 6248, 6256, 6265, 6275, 6277, 6302, 6315, 6318, 6330, 6343, 6347,
+ 6350, 6352, 6371, 6383, 6386, 6405, 6409, 6410, 6433, 6436, 6439,
+ 6463, 6468, 6477, 6496, 6511, 6516, 6519, 6523, 6530, 6539, 6547,
+ 6589, 6592, 6601, 6610, 6616, 6619, 6626, 6635, 6637, 6638, 6652,
+ 6656, 6662, 6689, 6699, 6710, 6714, 6719, 6739, 6751, 6775, 6779,
+ 6788, 6798, 6815, 6819, 6825, 6826, 6836, 6843, 6845, 6858, 6868,
+ 6877, 6881, 6891, 6896, 6899, 6901, 6908, 6914, 6916, 6923, 6925,
+ 6928, 6931, 6934, 6937, 6938, 6949, 6956, 6973, 6976, 6981, 6988,
+ 6999, 7016, 7027, 7029, 7055, 7058, 7074, 7083, 7093, 7100, 7105,
+ 7112, 7118, 7120, 7129, 7166, 7207, 7216, 7226, 7234, 7236, 7246,
+ 7248, 7254, 7263, 7273, 7274, 7293, 7297, 7310, 7315, 7317, 7331,
+ 7338, 7340, 7346, 7355, 7366, 7383, 7389, 7393, 7396, 7400, 7414,
+ 7417, 7426, 7432, 7452, 7468, 7488, 7491, 7494, 7497, 7515, 7531,
+ 7552, 7562, 7564, 7569, 7582, 7585, 7588, 7592, 7597, 7603, 7610,
+ 7624, 7642, 7647, 7653, 7654, 7666, 7668, 7684, 7705, 7732, 7741,
+ 7749, 7750, 7759, 7764, 7777, 7790, 7817, 7826, 7831, 7859, 7871,
+ 7873, 7876, 7900, 7904, 7913, 7916, 7922, 7946, 7953, 7956, 7963,
+ 7979, 7981, 7984, 7989, 7999, 8001, 8021, 8056, 8080, 8083, 8089,
+ 8090, 8114, 8128, 8133, 8145, 8155, 8161, 8182, 8186, 8191, 8192,
+ 8195, 8201, 8207, 8210, 8228, 8249, 8252, 8258, 8267, 8270, 8275,
+ 8284, 8293, 8298, 8305, 8317, 8328, 8336, 8345, 8351, 8367, 8379,
+ 8381, 8382, 8393, 8402, 8414, 8417, 8420, 8429, 8435, 8438, 8450,
+ 8452, 8459, 8470, 8486, 8490, 8500, 8524, 8536, 8552, 8558, 8570,
+ 8576, 8582, 8594, 8606, 8619, 8621, 8624, 8633, 8641, 8653, 8654,
+ 8662, 8675, 8689, 8695, 8702, 8706, 8720, 8729, 8739, 8741, 8751,
+ 8759, 8766, 8777, 8783, 8786, 8795, 8802, 8814, 8821, 8828, 8831,
+ 8837, 8842, 8855, 8856, 8868, 8877, 8890, 8892, 8900, 8909, 8912,
+ 8921, 8922, 8927, 8943, 8948, 8951, 8958, 8984, 8994, 9000, 9013,
+ 9018, 9020, 9031, 9035, 9045, 9052, 9056, 9059, 9066, 9076, 9089,
+ 9129, 9132, 9147, 9164, 9167, 9185, 9195, 9197, 9210, 9217, 9229,
+ 9248, 9254, 9263, 9266, 9268, 9290, 9310, 9316, 9338, 9340, 9343,
+ 9344, 9350, 9354, 9359, 9361, 9364, 9368, 9371, 9373, 9389, 9390,
+ 9409, 9443, 9445, 9446, 9452, 9490, 9492, 9495, 9508, 9523, 9543,
+ 9558, 9567, 9580, 9585, 9591, 9611, 9613, 9614, 9621, 9631, 9642,
+ 9656, 9661, 9667, 9694, 9715, 9722, 9738, 9745, 9758, 9764, 9782,
+ 9791, 9793, 9794, 9805, 9808, 9811, 9817, 9824, 9836, 9851, 9853,
+ 9854, 9877, 9881, 9923, 9935, 9937, 9954, 9959, 9963, 9968, 9973,
+ 9974, 9980, 9983, 9985, 10003, 10010, 10034, 10040, 10063, 10077,
+ 10081, 10082, 10084, 10088, 10091, 10105, 10111, 10118, 10127, 10135,
+ 10169, 10172, 10183, 10190, 10192, 10211, 10218, 10228, 10235, 10242,
+ 10244, 10271, 10278, 10296, 10299, 10307, 10309, 10310, 10314, 10316,
+ 10321, 10328, 10338, 10343, 10344, 10347, 10352, 10364, 10373, 10386,
+ 10391, 10398, 10408, 10413, 10422, 10445, 10460, 10463, 10464, 10474,
+ 10476, 10487, 10494, 10499, 10506, 10513, 10516, 10523, 10539, 10549,
+ 10550, 10567, 10576, 10625, 10635, 10643, 10656, 10671, 10676, 10683,
+ 10685, 10688, 10697, 10700, 10712, 10724, 10728, 10734, 10739, 10762,
+ 10772, 10781, 10800, 10805, 10827, 10830, 10837, 10841, 10847, 10848,
+ 10857, 10866, 10868, 10872, 10887, 10899, 10901, 10915, 10924, 10929,
+ 10942, 10971, 10992, 10995, 11002, 11010, 11027, 11029, 11045, 11057,
+ 11070, 11092, 11099, 11106, 11115, 11120, 11126, 11153, 11190, 11199,
+ 11222, 11225, 11226, 11231, 11244, 11259, 11261, 11270, 11273, 11300,
+ 11307, 11318, 11332, 11335, 11341, 11347, 11354, 11360, 11369, 11372,
+ 11378, 11396, 11405, 11417, 11424, 11427, 11430, 11439, 11442, 11448,
+ 11461, 11468, 11471, 11473, 11476, 11480, 11489, 11499, 11516, 11522,
+ 11531, 11539, 11546, 11551, 11564, 11582, 11589, 11593, 11601, 11608,
+ 11617, 11630, 11663, 11666, 11668, 11677, 11682, 11687, 11696, 11713,
+ 11728, 11747, 11750, 11754, 11759, 11761, 11764, 11767, 11797, 11804,
+ 11808, 11831, 11832, 11849, 11855, 11863, 11880, 11883, 11885, 11898,
+ 11916, 11924, 11928, 11947, 11955, 11961, 11962, 11982, 11990, 12010,
+ 12018, 12027, 12029, 12035, 12055, 12062, 12068, 12071, 12072, 12086,
+ 12097, 12098, 12100, 12112, 12118, 12133, 12134, 12137, 12161, 12162,
+ 12171, 12174, 12185, 12204, 12212, 12215, 12216, 12253, 12260, 12277,
+ 12289, 12295, 12314, 12323, 12325, 12335, 12349, 12358, 12372, 12376,
+ 12379, 12386, 12395, 12416, 12421, 12440, 12452, 12455, 12456, 12462,
+ 12467, 12479, 12505, 12521, 12535, 12547, 12556, 12561, 12568, 12578,
+ 12583, 12595, 12604, 12610, 12621, 12622, 12624, 12629, 12630, 12639,
+ 12640, 12650, 12679, 12680, 12698, 12716, 12721, 12722, 12731, 12742,
+ 12745, 12751, 12759, 12763, 12769, 12781, 12793, 12799, 12815, 12824,
+ 12836, 12845, 12853, 12854, 12857, 12866, 12872, 12875, 12878, 12880,
+ 12885, 12901, 12902, 12920, 12926, 12929, 12939, 12941, 12950, 12953,
+ 12992, 13002, 13010, 13058, 13072, 13084, 13087, 13091, 13097, 13108,
+ 13123, 13149, 13150, 13163, 13166, 13178, 13180, 13184, 13204, 13238,
+ 13242, 13249, 13255, 13269, 13270, 13274, 13285, 13289, 13298, 13307,
+ 13312, 13335, 13345, 13357, 13366, 13372, 13380, 13384, 13395, 13407,
+ 13408, 13413, 13414, 13417, 13437, 13441, 13447, 13456, 13459, 13461,
+ 13466, 13484, 13487, 13489, 13492, 13496, 13510, 13531, 13538, 13543,
+ 13547, 13572, 13581, 13590, 13605, 13612, 13624, 13630, 13632, 13638,
+ 13661, 13665, 13668, 13686, 13699, 13701, 13708, 13716, 13725, 13730,
+ 13742, 13747, 13749, 13753, 13754, 13771, 13773, 13782, 13785, 13798,
+ 13802, 13809, 13828, 13832, 13840, 13850, 13861, 13874, 13876, 13886,
+ 13897, 13900, 13915, 13927, 13951, 13955, 13962, 13969, 13979, 13988,
+ 13998, 14000, 14005, 14027, 14037, 14051, 14054, 14060, 14063, 14071,
+ 14078, 14080, 14085, 14086, 14095, 14138, 14145, 14158, 14166, 14179,
+ 14181, 14188, 14193, 14200, 14203, 14215, 14224, 14230, 14233, 14236,
+ 14246, 14267, 14282, 14287, 14301, 14323, 14325, 14329, 14339, 14342,
+ 14351, 14356, 14359, 14370, 14402, 14411, 14421, 14431, 14435, 14442,
+ 14447, 14456, 14459, 14472, 14477, 14490, 14496, 14501, 14505, 14513,
+ 14520, 14534, 14562, 14576, 14579, 14585, 14586, 14606, 14627, 14630,
+ 14634, 14636, 14647, 14653, 14659, 14671, 14674, 14701, 14716, 14719,
+ 14720, 14725, 14730, 14743, 14747, 14786, 14788, 14792, 14795, 14809,
+ 14831, 14834, 14850, 14855, 14859, 14864, 14876, 14889, 14890, 14898,
+ 14909, 14917, 14924, 14929, 14942, 14951, 14969, 14970, 14972, 14982,
+ 14988, 14994, 15005, 15016, 15024, 15030, 15048, 15054, 15066, 15071,
+ 15072, 15075, 15119, 15121, 15133, 15138, 15143, 15170, 15194, 15212,
+ 15223, 15229, 15254, 15263, 15270, 15273, 15287, 15299, 15301, 15306,
+ 15313, 15320, 15323, 15329, 15332, 15341, 15359, 15361, 15364, 15367,
+ 15379, 15391, 15415, 15416, 15419, 15433, 15469, 15478, 15481, 15482,
+ 15498, 15505, 15517, 15518, 15527, 15528, 15545, 15548, 15554, 15565,
+ 15577, 15580, 15587, 15601, 15604, 15611, 15616, 15619, 15625, 15633,
+ 15674, 15681, 15691, 15693, 15696, 15712, 15717, 15724, 15727, 15730,
+ 15746, 15751, 15760, 15770, 15782, 15791, 15796, 15808, 15814, 15825,
+ 15828, 15835, 15844, 15847, 15853, 15856, 15877, 15878, 15887, 15908,
+ 15917, 15923, 15930, 15937, 15958, 15977, 15991, 16007, 16011, 16014,
+ 16021, 16022, 16028, 16035, 16041, 16056, 16069, 16076, 16081, 16087,
+ 16088, 16110, 16112, 16117, 16150, 16153, 16160, 16166, 16172, 16190,
+ 16195, 16204, 16216, 16222, 16228, 16245, 16255, 16265, 16273, 16276,
+ 16283, 16295, 16304, 16313, 16319, 16328, 16345, 16355, 16364, 16372,
+ 16375, 16382, -1 };
+
+
+/** Array with all the precomputed primitive polynomials in this file.
+    The user can add more if needed, by also updating the macros MAX_PRIMITIVEPOLY
+    and MAX_PRIMITIVEDEGREE
+*/
+static long* PrimitivePolynomials[] = 
+{
+	PrimitivePolynomialDegree1,
+	PrimitivePolynomialDegree2,
+	PrimitivePolynomialDegree3,
+	PrimitivePolynomialDegree4,
+	PrimitivePolynomialDegree5,
+	PrimitivePolynomialDegree6,
+	PrimitivePolynomialDegree7,
+	PrimitivePolynomialDegree8,
+	PrimitivePolynomialDegree9,
+	PrimitivePolynomialDegree10,
+	PrimitivePolynomialDegree11,
+	PrimitivePolynomialDegree12,
+	PrimitivePolynomialDegree13,
+	PrimitivePolynomialDegree14,
+	PrimitivePolynomialDegree15
+};
+
+#endif  //  ORF_PRIMITIVEPOLYNOMIALS_HPP
@@ -1,31 +1,42 @@
-/** 
-@file  rng.hpp
-@brief Type definitions for common random number generators
-*/
-
-#ifndef ORF_RNG_HPP
-#define ORF_RNG_HPP
-
-#include <orflib/math/random/normalrng.hpp>
-#include <orflib/math/random/sobolurng.hpp>
-
-BEGIN_NAMESPACE(orf)
-
-/** Linear congruential */
-using NormalRngMinStdRand = NormalRng<std::minstd_rand>;
-
-/** Mersenne Twister */
-using NormalRngMt19937 = NormalRng<std::mt19937>;
-
-/** RanLux level 3 */
-using NormalRngRanLux3 = NormalRng<std::ranlux24>;
-
-/** RanLux level 4 */
-using NormalRngRanLux4 = NormalRng<std::ranlux48>;
-
-/** Sobol */
-using NormalRngSobol = NormalRng<orf::SobolURng>;
-
-END_NAMESPACE(orf)
-
-#endif // ORF_RNG_HPP
+/** 
+@file  rng.hpp
+@brief Type definitions for common random number generators
+*/
+
+#ifndef ORF_RNG_HPP
+#define ORF_RNG_HPP
+
+#include <orflib/math/random/normalrng.hpp>
+#include <orflib/math/random/sobolurng.hpp>
+#include <orflib/math/random/philoxurng.hpp>
+#include <orflib/math/random/latinhypercubeurng.hpp>
+
+BEGIN_NAMESPACE(orf)
+
+/** Linear congruential */
+using NormalRngMinStdRand = NormalRng<std::minstd_rand>;
+
+/** Mersenne Twister */
+using NormalRngMt19937 = NormalRng<std::mt19937>;
+
+/** RanLux level 3 */
+using NormalRngRanLux3 = NormalRng<std::ranlux24>;
+
+/** RanLux level 4 */
+using NormalRngRanLux4 = NormalRng<std::ranlux48>;
+
+/** Sobol */
+using NormalRngSobol = NormalRng<orf::SobolURng>;
+
+/** Philox4x32-10, counter-based */
+using NormalRngPhilox = NormalRng<orf::PhiloxURng>;
+
+/** Stratified first component */
+using NormalRngStratified = NormalRng<orf::StratifiedURng>;
+
+/** Latin hypercube */
+using NormalRngLatinHypercube = NormalRng<orf::LatinHypercubeURng>;
+
+END_NAMESPACE(orf)
+
+#endif // ORF_RNG_HPP
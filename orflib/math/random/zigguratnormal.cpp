@@ -0,0 +1,55 @@
+/**
+    @file  zigguratnormal.cpp
+    @brief Implementation of the ziggurat tables
+*/
+
+#include <orflib/math/random/zigguratnormal.hpp>
+
+BEGIN_NAMESPACE(orf)
+
+// Doornik's constants for 128 layers
+const double ZigguratNormal::R_ = 3.442619855899;
+const double ZigguratNormal::V_ = 9.91256303526217e-3;
+
+namespace {
+
+/** The layer tables, built once by the ctor of a function-local static */
+struct ZigguratTables
+{
+  ZigguratTables(double r, double v, size_t nlayers);
+
+  double x[129];      // the right ends of the layers
+  double ratio[128];  // the ratios x[i + 1] / x[i]
+};
+
+ZigguratTables::ZigguratTables(double r, double v, size_t nlayers)
+{
+  double f = std::exp(-0.5 * r * r);
+  x[0] = v / f;       // the base layer is a box of area v including the tail
+  x[1] = r;
+  x[nlayers] = 0.0;
+  for (size_t i = 2; i < nlayers; ++i) {
+    x[i] = std::sqrt(-2.0 * std::log(v / x[i - 1] + f));
+    f = std::exp(-0.5 * x[i] * x[i]);
+  }
+  for (size_t i = 0; i < nlayers; ++i)
+    ratio[i] = x[i + 1] / x[i];
+}
+
+} // anonymous namespace
+
+ZigguratNormal::ZigguratNormal(double mean, double stdev)
+: mean_(mean), stdev_(stdev)
+{
+  ORF_ASSERT(stdev > 0.0, "the standard deviation must be positive!");
+  layerTables(x_, r_);
+}
+
+void ZigguratNormal::layerTables(double const*& x, double const*& r)
+{
+  static const ZigguratTables tables(R_, V_, NLAYERS);
+  x = tables.x;
+  r = tables.ratio;
+}
+
+END_NAMESPACE(orf)
@@ -0,0 +1,173 @@
+/**
+@file  zigguratnormal.hpp
+@brief Ziggurat sampler of normal deviates
+*/
+
+#ifndef ORF_ZIGGURATNORMAL_HPP
+#define ORF_ZIGGURATNORMAL_HPP
+
+
+#include <orflib/defines.hpp>
+#include <orflib/exception.hpp>
+#include <cmath>
+
+BEGIN_NAMESPACE(orf)
+
+/** Sampler of normal deviates with the ziggurat method, in the ZIGNOR variant of
+    J.A. Doornik, "An improved ziggurat method to generate normal random samples" (2005).
+    It uses 128 layers; about 99% of the deviates cost one word of random bits,
+    a multiplication and a comparison. The word takes one draw from ranlux48, two draws
+    from the 24 to 32 bit generators; the layer index and the uniform use disjoint bits.
+    Unlike std::normal_distribution the algorithm, and the conversion of the raw URNG output
+    to uniforms, are fixed here, so the same URNG gives the same deviates with any compiler.
+    The sampler caches no deviates, so it needs no reset when the URNG is reseeded.
+*/
+class ZigguratNormal
+{
+public:
+  /** Ctor from distribution parameters */
+  explicit ZigguratNormal(double mean = 0.0, double stdev = 1.0);
+
+  /** Returns the next normal deviate */
+  template <typename URNG>
+  double operator()(URNG& urng) const;
+
+  /** Fills the range [begin, end) with normal deviates */
+  template <typename URNG, typename ITER>
+  void next(URNG& urng, ITER begin, ITER end) const;
+
+  /** Returns a uniform deviate in [0, 1), with between 39 and 53 random bits */
+  template <typename URNG>
+  static double uniform(URNG& urng);
+
+protected:
+  /** Number of random bits in a word drawn by randomWord() */
+  template <typename URNG>
+  static constexpr int wordBits();
+
+  /** Returns wordBits<URNG>() random bits, concatenating as many URNG draws as needed
+      for at least 39 bits: 7 for the layer and 32 for the uniform.
+  */
+  template <typename URNG>
+  static unsigned long long randomWord(URNG& urng);
+
+  /** Returns a standard normal deviate */
+  template <typename URNG>
+  double stdNormal(URNG& urng) const;
+
+  /** Samples from the tail beyond the base layer, by Marsaglia's method */
+  template <typename URNG>
+  double stdNormalTail(URNG& urng, bool negative) const;
+
+  /** Builds the layer tables on first use and returns pointers to them */
+  static void layerTables(double const*& x, double const*& r);
+
+  enum { NLAYERS = 128, LAYERBITS = 7, MINWORDBITS = 39 };
+  static const double R_;       // the start of the tail, right end of the base layer
+  static const double V_;       // the area of each layer
+
+private:
+  // state
+  double mean_, stdev_;
+  double const* x_;             // the right ends of the layers, NLAYERS + 1 values
+  double const* r_;             // the ratios x_[i + 1] / x_[i], NLAYERS values
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+/** The number of full random bits in each draw of URNG, at most 64 */
+template <typename URNG>
+constexpr int urngBits()
+{
+  unsigned long long span = static_cast<unsigned long long>(URNG::max() - URNG::min());
+  int nbits = 0;
+  while (nbits < 64 && (span >> nbits) > 0ULL && ((span >> nbits) & 1ULL))
+    ++nbits;
+  // a range that is not a power of two: use only the bits below its highest bit
+  if (nbits < 64 && (span >> nbits) != 0ULL) {
+    nbits = 0;
+    while ((span >> (nbits + 1)) != 0ULL)
+      ++nbits;
+  }
+  return nbits;
+}
+
+template <typename URNG>
+inline constexpr int ZigguratNormal::wordBits()
+{
+  return ((MINWORDBITS + urngBits<URNG>() - 1) / urngBits<URNG>()) * urngBits<URNG>() > 64
+    ? 64
+    : ((MINWORDBITS + urngBits<URNG>() - 1) / urngBits<URNG>()) * urngBits<URNG>();
+}
+
+template <typename URNG>
+inline unsigned long long ZigguratNormal::randomWord(URNG& urng)
+{
+  const int nbits = urngBits<URNG>();
+  const unsigned long long mask = nbits == 64 ? ~0ULL : (1ULL << nbits) - 1;
+  unsigned long long word = static_cast<unsigned long long>(urng() - URNG::min()) & mask;
+  for (int drawn = nbits; drawn < MINWORDBITS; drawn += nbits)
+    word = (word << nbits) | (static_cast<unsigned long long>(urng() - URNG::min()) & mask);
+  return word;
+}
+
+template <typename URNG>
+inline double ZigguratNormal::uniform(URNG& urng)
+{
+  const int ubits = wordBits<URNG>() > 53 ? 53 : wordBits<URNG>();
+  return static_cast<double>(randomWord(urng) >> (wordBits<URNG>() - ubits)) * std::ldexp(1.0, -ubits);
+}
+
+template <typename URNG>
+inline double ZigguratNormal::stdNormalTail(URNG& urng, bool negative) const
+{
+  double x, y;
+  do {
+    x = std::log(uniform(urng)) / R_;
+    y = std::log(uniform(urng));
+  } while (-2.0 * y < x * x);
+  return negative ? x - R_ : R_ - x;
+}
+
+template <typename URNG>
+inline double ZigguratNormal::stdNormal(URNG& urng) const
+{
+  // the uniform takes the high bits of the word, at most 53, the layer the lowest 7 bits
+  const int ubits = wordBits<URNG>() - LAYERBITS > 53 ? 53 : wordBits<URNG>() - LAYERBITS;
+  const double uscale = 2.0 / static_cast<double>(1ULL << ubits);
+  for (;;) {
+    unsigned long long word = randomWord(urng);
+    unsigned int i = static_cast<unsigned int>(word) & (NLAYERS - 1);
+    double u = static_cast<double>(word >> (wordBits<URNG>() - ubits)) * uscale - 1.0;
+    // inside the rectangle of layer i
+    if (std::fabs(u) < r_[i])
+      return u * x_[i];
+    // base layer: sample from the tail
+    if (i == 0)
+      return stdNormalTail(urng, u < 0.0);
+    // in the wedge of layer i, accept if under the density
+    double x = u * x_[i];
+    double f0 = std::exp(-0.5 * (x_[i] * x_[i] - x * x));
+    double f1 = std::exp(-0.5 * (x_[i + 1] * x_[i + 1] - x * x));
+    if (f1 + uniform(urng) * (f0 - f1) < 1.0)
+      return x;
+  }
+}
+
+template <typename URNG>
+inline double ZigguratNormal::operator()(URNG& urng) const
+{
+  return mean_ + stdev_ * stdNormal(urng);
+}
+
+template <typename URNG, typename ITER>
+inline void ZigguratNormal::next(URNG& urng, ITER begin, ITER end) const
+{
+  for (ITER it = begin; it != end; ++it)
+    *it = mean_ + stdev_ * stdNormal(urng);
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_ZIGGURATNORMAL_HPP
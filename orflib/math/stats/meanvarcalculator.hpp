@@ -1,94 +1,151 @@
-/**
-@file  meanvarcalculator.hpp
-@brief Calculates the mean and variance of a set of samples
-*/
-
-#ifndef ORF_MEANVARCALCULATOR_HPP
-#define ORF_MEANVARCALCULATOR_HPP
-
-#include <orflib/math/stats/statisticscalculator.hpp>
-#include <orflib/exception.hpp>
-
-BEGIN_NAMESPACE(orf)
-
-/** Statistics calculator base class */
-template <typename ITER>
-class MeanVarCalculator : public StatisticsCalculator < ITER >
-{
-  using StatisticsCalculator<ITER>::nVariables;
-  using StatisticsCalculator<ITER>::nsamples_;
-  using StatisticsCalculator<ITER>::results_;
-
-public:
-
-  MeanVarCalculator(size_t nvars);
-
-  virtual ~MeanVarCalculator() {}
-
-  virtual void addSample(ITER begin, ITER end) override;
-
-  virtual void reset() override;
-
-  virtual Matrix const & results() override;
-
-protected:
-
-  // state
-  Vector runningSum_;
-  Vector runningSum2_;
-
-};
-
-///////////////////////////////////////////////////////////////////////////////
-// Inline definitions
-
-template <typename ITER>
-MeanVarCalculator<ITER>::MeanVarCalculator(size_t nvars)
-  : StatisticsCalculator<ITER>(nvars, 2), runningSum_(nvars), runningSum2_(nvars)
-{
-  for (size_t j = 0; j < nvars; ++j) {
-    runningSum2_(j) = runningSum_(j) = 0.0;
-  }
-}
-
-template <typename ITER>
-void MeanVarCalculator<ITER>::addSample(ITER begin, ITER end)
-{
-  ORF_ASSERT(end - begin == nVariables(), "missing variable values!");
-
-  ITER it = begin;
-  for (size_t j = 0; j < nVariables(); ++j, ++it) {
-    runningSum_(j) += *it;
-    runningSum2_(j) += (*it) * (*it);
-  }
-
-  ++nsamples_;
-}
-
-template <typename ITER>
-Matrix const & MeanVarCalculator<ITER>::results()
-{
-  for (size_t j = 0; j < nVariables(); ++j) {
-    results_(0, j) = runningSum_(j) / nsamples_;
-    double mean = results_(0, j);
-    results_(1, j) = runningSum2_(j) / nsamples_ - mean * mean;
-    results_(1, j) *= nsamples_;
-    results_(1, j) /= (nsamples_ - 1);
-  }
-
-  return results_;
-}
-
-template <typename ITER>
-void MeanVarCalculator<ITER>::reset()
-{
-  StatisticsCalculator<ITER>::reset();
-  for (size_t j = 0; j < nVariables(); ++j) {
-    runningSum_(j) = 0.0;
-    runningSum2_(j) = 0.0;
-  }
-}
-
-END_NAMESPACE(orf)
-
-#endif // ORF_MEANVARCALCULATOR_HPP
+/**
+@file  meanvarcalculator.hpp
+@brief Calculates the mean and variance of a set of samples
+*/
+
+#ifndef ORF_MEANVARCALCULATOR_HPP
+#define ORF_MEANVARCALCULATOR_HPP
+
+#include <orflib/math/stats/statisticscalculator.hpp>
+#include <orflib/exception.hpp>
+
+BEGIN_NAMESPACE(orf)
+
+/** Calculates the mean (results row 0) and the unbiased variance (results row 1) of each variable.
+    It keeps the running means and sums of squared deviations from them (Welford), rather than the
+    sums of the samples and of their squares, so the variance does not lose precision to
+    cancellation when the mean is large relative to the standard deviation.
+    Batches of samples and other calculators are combined with the pairwise update of Chan et al.,
+    so partial results, e.g. of separate threads or processes, can be merged.
+*/
+template <typename ITER>
+class MeanVarCalculator : public StatisticsCalculator < ITER >
+{
+  using StatisticsCalculator<ITER>::nVariables;
+  using StatisticsCalculator<ITER>::nsamples_;
+  using StatisticsCalculator<ITER>::results_;
+
+public:
+
+  using StatisticsCalculator<ITER>::addSamples;
+
+  MeanVarCalculator(size_t nvars);
+
+  virtual ~MeanVarCalculator() {}
+
+  virtual void addSample(ITER begin, ITER end) override;
+
+  /** Adds a batch of samples, one per row, one column per variable */
+  virtual void addSamples(Matrix const& samples, size_t firstRow, size_t nRows) override;
+
+  /** Adds the samples of another calculator tracking the same variables */
+  void merge(MeanVarCalculator const& other);
+
+  virtual void reset() override;
+
+  virtual Matrix const & results() override;
+
+protected:
+
+  /** Combines the statistics of n samples with means mean and sums of squared deviations m2 */
+  void combine(size_t n, Vector const& mean, Vector const& m2);
+
+  // state
+  Vector mean_;       // the running means
+  Vector m2_;         // the running sums of squared deviations from the means
+  Vector batchMean_;  // scratch array with the means of a batch
+  Vector batchM2_;    // scratch array with the sums of squared deviations of a batch
+
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+template <typename ITER>
+MeanVarCalculator<ITER>::MeanVarCalculator(size_t nvars)
+  : StatisticsCalculator<ITER>(nvars, 2), mean_(nvars, arma::fill::zeros), m2_(nvars, arma::fill::zeros),
+  batchMean_(nvars), batchM2_(nvars)
+{}
+
+template <typename ITER>
+void MeanVarCalculator<ITER>::addSample(ITER begin, ITER end)
+{
+  ORF_ASSERT(end - begin == nVariables(), "missing variable values!");
+
+  ++nsamples_;
+  ITER it = begin;
+  for (size_t j = 0; j < nVariables(); ++j, ++it) {
+    double delta = *it - mean_(j);
+    mean_(j) += delta / nsamples_;
+    m2_(j) += delta * (*it - mean_(j));
+  }
+}
+
+template <typename ITER>
+void MeanVarCalculator<ITER>::addSamples(Matrix const& samples, size_t firstRow, size_t nRows)
+{
+  ORF_ASSERT(samples.n_cols == nVariables(), "missing variable values!");
+  ORF_ASSERT(firstRow + nRows <= samples.n_rows, "not enough samples!");
+  if (nRows == 0)
+    return;
+
+  // two passes over each column of the batch, then one update of the running statistics
+  for (size_t j = 0; j < nVariables(); ++j) {
+    double const* x = samples.colptr(j) + firstRow;
+    double sum = 0.0;
+    for (size_t i = 0; i < nRows; ++i)
+      sum += x[i];
+    double mean = sum / nRows;
+    double m2 = 0.0;
+    for (size_t i = 0; i < nRows; ++i)
+      m2 += (x[i] - mean) * (x[i] - mean);
+    batchMean_(j) = mean;
+    batchM2_(j) = m2;
+  }
+  combine(nRows, batchMean_, batchM2_);
+}
+
+template <typename ITER>
+void MeanVarCalculator<ITER>::merge(MeanVarCalculator const& other)
+{
+  ORF_ASSERT(other.nVariables() == nVariables(), "cannot merge calculators of different variables!");
+  if (other.nsamples_ > 0)
+    combine(other.nsamples_, other.mean_, other.m2_);
+}
+
+template <typename ITER>
+void MeanVarCalculator<ITER>::combine(size_t n, Vector const& mean, Vector const& m2)
+{
+  double na = static_cast<double>(nsamples_);
+  double nb = static_cast<double>(n);
+  double nab = na + nb;
+  for (size_t j = 0; j < nVariables(); ++j) {
+    double delta = mean(j) - mean_(j);
+    mean_(j) += delta * (nb / nab);
+    m2_(j) += m2(j) + delta * delta * (na * nb / nab);
+  }
+  nsamples_ += n;
+}
+
+template <typename ITER>
+Matrix const & MeanVarCalculator<ITER>::results()
+{
+  for (size_t j = 0; j < nVariables(); ++j) {
+    results_(0, j) = mean_(j);
+    results_(1, j) = m2_(j) / (nsamples_ - 1.0);
+  }
+
+  return results_;
+}
+
+template <typename ITER>
+void MeanVarCalculator<ITER>::reset()
+{
+  StatisticsCalculator<ITER>::reset();
+  mean_.zeros();
+  m2_.zeros();
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_MEANVARCALCULATOR_HPP
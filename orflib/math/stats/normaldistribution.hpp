@@ -1,52 +1,164 @@
-/**
-@file  normaldistribution.hpp
-@brief The normal distribution and its inverse
-*/
-
-#ifndef ORF_NORMALDISTRIBUTION_HPP
-#define ORF_NORMALDISTRIBUTION_HPP
-
-#include <orflib/defines.hpp>
-#include <orflib/exception.hpp>
-#include <orflib/math/stats/univariatedistribution.hpp>
-#include <orflib/math/stats/errorfunction.hpp>
-
-BEGIN_NAMESPACE(orf)
-
-/** The normal distribution */
-class NormalDistribution : public UnivariateDistribution
-{
-public:
-  /** Initializing ctor */
-  NormalDistribution(double mu = 0.0, double sigma = 1.0) : mu_(mu), sig_(sigma)
-  {
-    ORF_ASSERT(sig_ > 0, "error: sigma must be positive");
-  }
-
-  /** Probalbility density function */
-  double pdf(double x) const override
-  {
-    return (M_1_SQRT2PI / sig_) *
-           std::exp(-0.5 * std::pow((x - mu_) / sig_, 2));
-  }
-
-  /** Cumulative distribution function */
-  double cdf(double x) const override
-  {
-    return 0.5 * ErrorFunction::erfc(-M_SQRT1_2 * (x - mu_) / sig_);
-  }
-
-  /** Inverse cumulative distribution function */
-  double invcdf(double p) const override
-  {
-    ORF_ASSERT(p > 0 && p < 1, "error: prob. must be in (0,1)");
-    return -M_SQRT2 * sig_ * ErrorFunction::inverfc(2.0 * p) + mu_;
-  }
-
-protected:
-  double mu_, sig_;
-};
-
-END_NAMESPACE(orf)
-
-#endif // ORF_NORMALDISTRIBUTION_HPP
+/**
+@file  normaldistribution.hpp
+@brief The normal distribution and its inverse
+*/
+
+#ifndef ORF_NORMALDISTRIBUTION_HPP
+#define ORF_NORMALDISTRIBUTION_HPP
+
+#include <orflib/defines.hpp>
+#include <orflib/exception.hpp>
+#include <orflib/math/stats/univariatedistribution.hpp>
+#include <orflib/math/stats/errorfunction.hpp>
+#include <cmath>
+
+BEGIN_NAMESPACE(orf)
+
+/** The normal distribution */
+class NormalDistribution : public UnivariateDistribution
+{
+public:
+  /** Initializing ctor */
+  NormalDistribution(double mu = 0.0, double sigma = 1.0) : mu_(mu), sig_(sigma)
+  {
+    ORF_ASSERT(sig_ > 0, "error: sigma must be positive");
+  }
+
+  /** Probalbility density function */
+  double pdf(double x) const override
+  {
+    return (M_1_SQRT2PI / sig_) *
+           std::exp(-0.5 * std::pow((x - mu_) / sig_, 2));
+  }
+
+  /** Cumulative distribution function */
+  double cdf(double x) const override
+  {
+    return 0.5 * ErrorFunction::erfc(-M_SQRT1_2 * (x - mu_) / sig_);
+  }
+
+  /** Inverse cumulative distribution function */
+  double invcdf(double p) const override
+  {
+    ORF_ASSERT(p > 0 && p < 1, "error: prob. must be in (0,1)");
+    return -M_SQRT2 * sig_ * ErrorFunction::inverfc(2.0 * p) + mu_;
+  }
+
+  /** Inverse cumulative distribution function applied in-place to a range of probabilities.
+      It uses Wichura's algorithm AS241 (relative accuracy about 1e-16). The range is processed
+      in chunks: a branch-free pass evaluates the central rational approximation on the whole
+      chunk, so that it can be vectorized, and a second pass fixes up the few tail values.
+  */
+  template <typename ITER>
+  void invcdf(ITER begin, ITER end) const;
+
+protected:
+  /** AS241 approximation of the standard normal quantile for |q| <= 0.425, where q = p - 0.5 */
+  static double invcdfCentral(double q);
+  /** AS241 approximation of the standard normal quantile for |p - 0.5| > 0.425 */
+  static double invcdfTail(double p);
+
+  enum { INVCDFCHUNK = 64 };  // the number of probabilities processed per chunk
+
+  double mu_, sig_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+template <typename ITER>
+inline void NormalDistribution::invcdf(ITER begin, ITER end) const
+{
+  double probs[INVCDFCHUNK];
+  double quants[INVCDFCHUNK];
+  ITER it = begin;
+  while (it != end) {
+    // copy the next chunk of probabilities
+    size_t n = 0;
+    for (ITER jt = it; jt != end && n < INVCDFCHUNK; ++jt, ++n)
+      probs[n] = *jt;
+    // central region for all values, no branches
+    for (size_t k = 0; k < n; ++k)
+      quants[k] = invcdfCentral(probs[k] - 0.5);
+    // tail region, also catching NaN and values outside (0, 1)
+    for (size_t k = 0; k < n; ++k) {
+      if (!(std::fabs(probs[k] - 0.5) <= 0.425))
+        quants[k] = invcdfTail(probs[k]);
+    }
+    for (size_t k = 0; k < n; ++k, ++it)
+      *it = mu_ + sig_ * quants[k];
+  }
+}
+
+inline double NormalDistribution::invcdfCentral(double q)
+{
+  double r = 0.180625 - q * q;
+  double num = ((((((( 2.5090809287301226727e+3 * r
+                     + 3.3430575583588128105e+4) * r
+                     + 6.7265770927008700853e+4) * r
+                     + 4.5921953931549871457e+4) * r
+                     + 1.3731693765509461125e+4) * r
+                     + 1.9715909503065514427e+3) * r
+                     + 1.3314166789178437745e+2) * r
+                     + 3.3871328727963666080e+0);
+  double den = ((((((( 5.2264952788528545610e+3 * r
+                     + 2.8729085735721942674e+4) * r
+                     + 3.9307895800092710610e+4) * r
+                     + 2.1213794301586595867e+4) * r
+                     + 5.3941960214247511077e+3) * r
+                     + 6.8718700749205790830e+2) * r
+                     + 4.2313330701600911252e+1) * r
+                     + 1.0);
+  return q * num / den;
+}
+
+inline double NormalDistribution::invcdfTail(double p)
+{
+  ORF_ASSERT(p > 0 && p < 1, "error: prob. must be in (0,1)");
+  double q = p - 0.5;
+  double r = std::sqrt(-std::log(q < 0.0 ? p : 1.0 - p));
+  double x;
+  if (r <= 5.0) {
+    r -= 1.6;
+    x = ((((((( 7.74545014278341407640e-4 * r
+              + 2.27238449892691845833e-2) * r
+              + 2.41780725177450611770e-1) * r
+              + 1.27045825245236838258e+0) * r
+              + 3.64784832476320460504e+0) * r
+              + 5.76949722146069140550e+0) * r
+              + 4.63033784615654529590e+0) * r
+              + 1.42343711074968357734e+0)
+      / ((((((( 1.05075007164441684324e-9 * r
+              + 5.47593808499534494600e-4) * r
+              + 1.51986665636164571966e-2) * r
+              + 1.48103976427480074590e-1) * r
+              + 6.89767334985100004550e-1) * r
+              + 1.67638483018380384940e+0) * r
+              + 2.05319162663775882187e+0) * r
+              + 1.0);
+  }
+  else {
+    r -= 5.0;
+    x = ((((((( 2.01033439929228813265e-7 * r
+              + 2.71155556874348757815e-5) * r
+              + 1.24266094738807843860e-3) * r
+              + 2.65321895265761230930e-2) * r
+              + 2.96560571828504891230e-1) * r
+              + 1.78482653991729133580e+0) * r
+              + 5.46378491116411436990e+0) * r
+              + 6.65790464350110377720e+0)
+      / ((((((( 2.04426310338993978564e-15 * r
+              + 1.42151175831644588870e-7) * r
+              + 1.84631831751005468180e-5) * r
+              + 7.86869131145613259100e-4) * r
+              + 1.48753612908506148525e-2) * r
+              + 1.36929880922735805310e-1) * r
+              + 5.99832206555887937690e-1) * r
+              + 1.0);
+  }
+  return q < 0.0 ? -x : x;
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_NORMALDISTRIBUTION_HPP
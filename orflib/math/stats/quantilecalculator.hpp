@@ -0,0 +1,366 @@
+/**
+@file  quantilecalculator.hpp
+@brief Calculates quantiles of a set of samples in bounded memory
+*/
+
+#ifndef ORF_QUANTILECALCULATOR_HPP
+#define ORF_QUANTILECALCULATOR_HPP
+
+#include <orflib/math/stats/statisticscalculator.hpp>
+#include <orflib/exception.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+BEGIN_NAMESPACE(orf)
+
+/** Calculates the quantiles of each variable at the given probabilities, one results row per
+    probability, without storing the samples.
+    Each variable is summarized by a t-digest (Dunning and Ertl): a sorted list of centroids,
+    each the mean and number of a run of neighbouring samples. The centroids are small in the tails
+    and large in the middle of the distribution, so the tail quantiles, e.g. for VaR and expected
+    shortfall, are the most accurate. The number of centroids is of the order of the compression
+    parameter, whatever the number of samples.
+    The quantile function is interpolated linearly between the centroids and the smallest and
+    largest samples. Calculators with the same variables can be merged, e.g. across threads.
+    Optionally it also counts the samples in a histogram with fixed bins.
+*/
+template <typename ITER>
+class QuantileCalculator : public StatisticsCalculator < ITER >
+{
+  using StatisticsCalculator<ITER>::nVariables;
+  using StatisticsCalculator<ITER>::nsamples_;
+  using StatisticsCalculator<ITER>::results_;
+
+public:
+
+  using StatisticsCalculator<ITER>::addSamples;
+
+  /** Initializing ctor. The results are the quantiles at the probabilities probs.
+      Larger compressions give more accurate quantiles, for more memory and time.
+  */
+  QuantileCalculator(size_t nvars, Vector const& probs, double compression = 200.0);
+
+  virtual ~QuantileCalculator() {}
+
+  virtual void addSample(ITER begin, ITER end) override;
+
+  /** Adds a batch of samples, one per row, one column per variable */
+  virtual void addSamples(Matrix const& samples, size_t firstRow, size_t nRows) override;
+
+  /** Adds the samples of another calculator tracking the same variables, with the same histogram bins */
+  void merge(QuantileCalculator const& other);
+
+  virtual void reset() override;
+
+  /** Returns the quantiles, one row per probability, one column per variable */
+  virtual Matrix const & results() override;
+
+  /** Returns the quantile of variable var at probability p */
+  double quantile(double p, size_t var);
+
+  /** Returns the mean of variable var below its quantile at probability p, the expected shortfall of a PnL */
+  double lowerTailMean(double p, size_t var);
+
+  /** Returns the mean of variable var above its quantile at probability p */
+  double upperTailMean(double p, size_t var);
+
+  /** Returns the number of centroids kept for variable var */
+  size_t nCentroids(size_t var);
+
+  /** Also counts the samples in nBins equal bins over [lo, hi). It clears the samples. */
+  void setHistogram(double lo, double hi, size_t nBins);
+
+  /** Returns the histogram counts, one column per variable.
+      Row 0 counts the samples below lo, rows 1 to nBins the bins, row nBins + 1 the samples at or above hi.
+  */
+  Matrix const& histogram() const;
+
+protected:
+
+  /** A centroid of a t-digest */
+  struct Centroid
+  {
+    double mean;
+    double weight;
+  };
+
+  /** The t-digest of one variable */
+  struct Digest
+  {
+    std::vector<Centroid> centroids;  // the merged centroids, sorted by mean
+    std::vector<Centroid> buffer;     // the centroids and samples not merged yet
+    double min;                       // the smallest sample
+    double max;                       // the largest sample
+  };
+
+  /** Adds sample x of variable var */
+  void add(size_t var, double x);
+
+  /** Merges the buffer of the digest into its centroids */
+  void compress(Digest& digest);
+
+  /** Returns the integral of the quantile function of variable var from 0 to u */
+  double quantileIntegral(double u, size_t var);
+
+  // state
+  Vector probs_;                 // the probabilities of the quantiles in the results
+  double compression_;           // the t-digest compression, the scale of the number of centroids
+  size_t bufferSize_;            // the number of buffered centroids that triggers a compression
+  std::vector<Digest> digests_;  // the digests, one per variable
+  double histLo_;                // the lower bound of the histogram
+  double histHi_;                // the upper bound of the histogram
+  Matrix histogram_;             // the histogram counts, empty if there is no histogram
+  std::vector<Centroid> merged_; // scratch array for the compressions
+
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+template <typename ITER>
+QuantileCalculator<ITER>::QuantileCalculator(size_t nvars, Vector const& probs, double compression)
+  : StatisticsCalculator<ITER>(nvars, probs.n_elem), probs_(probs), compression_(compression),
+  bufferSize_(static_cast<size_t>(5.0 * compression)), digests_(nvars), histLo_(0.0), histHi_(0.0)
+{
+  ORF_ASSERT(probs.n_elem > 0, "need at least one probability!");
+  ORF_ASSERT(probs.min() >= 0.0 && probs.max() <= 1.0, "the probabilities must be between 0 and 1!");
+  ORF_ASSERT(compression >= 10.0, "the compression must be at least 10!");
+  reset();
+}
+
+template <typename ITER>
+void QuantileCalculator<ITER>::addSample(ITER begin, ITER end)
+{
+  ORF_ASSERT(end - begin == nVariables(), "missing variable values!");
+
+  ITER it = begin;
+  for (size_t j = 0; j < nVariables(); ++j, ++it)
+    add(j, *it);
+  ++nsamples_;
+}
+
+template <typename ITER>
+void QuantileCalculator<ITER>::addSamples(Matrix const& samples, size_t firstRow, size_t nRows)
+{
+  ORF_ASSERT(samples.n_cols == nVariables(), "missing variable values!");
+  ORF_ASSERT(firstRow + nRows <= samples.n_rows, "not enough samples!");
+
+  for (size_t j = 0; j < nVariables(); ++j) {
+    double const* x = samples.colptr(j) + firstRow;
+    for (size_t i = 0; i < nRows; ++i)
+      add(j, x[i]);
+  }
+  nsamples_ += nRows;
+}
+
+template <typename ITER>
+void QuantileCalculator<ITER>::add(size_t var, double x)
+{
+  Digest& digest = digests_[var];
+  digest.buffer.push_back(Centroid{ x, 1.0 });
+  digest.min = std::min(digest.min, x);
+  digest.max = std::max(digest.max, x);
+  if (digest.buffer.size() >= bufferSize_)
+    compress(digest);
+
+  if (!histogram_.is_empty()) {
+    size_t nbins = histogram_.n_rows - 2;
+    size_t row;
+    if (x < histLo_)
+      row = 0;
+    else if (x >= histHi_)
+      row = nbins + 1;
+    else
+      row = 1 + std::min(nbins - 1, static_cast<size_t>((x - histLo_) / (histHi_ - histLo_) * nbins));
+    histogram_(row, var) += 1.0;
+  }
+}
+
+template <typename ITER>
+void QuantileCalculator<ITER>::compress(Digest& digest)
+{
+  if (digest.buffer.empty())
+    return;
+  merged_.assign(digest.centroids.begin(), digest.centroids.end());
+  merged_.insert(merged_.end(), digest.buffer.begin(), digest.buffer.end());
+  std::sort(merged_.begin(), merged_.end(),
+            [](Centroid const& a, Centroid const& b) { return a.mean < b.mean; });
+  double total = 0.0;
+  for (Centroid const& c : merged_)
+    total += c.weight;
+
+  // greedy merge of neighbours, each centroid spanning at most one unit of the scale function
+  // k(q) = compression / z log(q / (1 - q)), with z = 4 log(n / compression) + 24,
+  // so the centroids shrink geometrically towards the tails
+  double z = 4.0 * std::log(std::max(total / compression_, 1.0)) + 24.0;
+  auto kscale = [&](double q) { return compression_ / z * std::log(q / (1.0 - q)); };
+  auto kinverse = [&](double k) { return 1.0 / (1.0 + std::exp(-k * z / compression_)); };
+
+  digest.centroids.clear();
+  Centroid cur = merged_[0];
+  double wsofar = 0.0;
+  double wlimit = total * kinverse(kscale(0.0) + 1.0);
+  for (size_t i = 1; i < merged_.size(); ++i) {
+    Centroid const& next = merged_[i];
+    if (wsofar + cur.weight + next.weight <= wlimit) {
+      cur.weight += next.weight;
+      cur.mean += (next.mean - cur.mean) * next.weight / cur.weight;
+    }
+    else {
+      wsofar += cur.weight;
+      digest.centroids.push_back(cur);
+      wlimit = total * kinverse(kscale(wsofar / total) + 1.0);
+      cur = next;
+    }
+  }
+  digest.centroids.push_back(cur);
+  digest.buffer.clear();
+}
+
+template <typename ITER>
+void QuantileCalculator<ITER>::merge(QuantileCalculator const& other)
+{
+  ORF_ASSERT(other.nVariables() == nVariables(), "cannot merge calculators of different variables!");
+  ORF_ASSERT(other.histogram_.n_rows == histogram_.n_rows && other.histLo_ == histLo_ && other.histHi_ == histHi_,
+             "cannot merge calculators with different histograms!");
+  for (size_t j = 0; j < nVariables(); ++j) {
+    Digest& digest = digests_[j];
+    Digest const& odigest = other.digests_[j];
+    digest.buffer.insert(digest.buffer.end(), odigest.centroids.begin(), odigest.centroids.end());
+    digest.buffer.insert(digest.buffer.end(), odigest.buffer.begin(), odigest.buffer.end());
+    digest.min = std::min(digest.min, odigest.min);
+    digest.max = std::max(digest.max, odigest.max);
+    compress(digest);
+  }
+  if (!histogram_.is_empty())
+    histogram_ += other.histogram_;
+  nsamples_ += other.nsamples_;
+}
+
+template <typename ITER>
+void QuantileCalculator<ITER>::reset()
+{
+  StatisticsCalculator<ITER>::reset();
+  for (Digest& digest : digests_) {
+    digest.centroids.clear();
+    digest.buffer.clear();
+    digest.buffer.reserve(bufferSize_);
+    digest.min = std::numeric_limits<double>::infinity();
+    digest.max = -std::numeric_limits<double>::infinity();
+  }
+  histogram_.zeros();
+}
+
+template <typename ITER>
+Matrix const & QuantileCalculator<ITER>::results()
+{
+  for (size_t j = 0; j < nVariables(); ++j)
+    for (size_t i = 0; i < probs_.n_elem; ++i)
+      results_(i, j) = quantile(probs_(i), j);
+
+  return results_;
+}
+
+template <typename ITER>
+double QuantileCalculator<ITER>::quantile(double p, size_t var)
+{
+  ORF_ASSERT(nsamples_ > 0, "no samples!");
+  ORF_ASSERT(p >= 0.0 && p <= 1.0, "the probability must be between 0 and 1!");
+  Digest& digest = digests_[var];
+  compress(digest);
+  std::vector<Centroid> const& cs = digest.centroids;
+
+  // the quantile function goes through (0, min), the centroid means at the middle of their
+  // cumulative weights, and (1, max)
+  double total = static_cast<double>(nsamples_);
+  double target = p * total;
+  double uprev = 0.0;
+  double qprev = digest.min;
+  double cum = 0.0;
+  for (Centroid const& c : cs) {
+    double u = cum + 0.5 * c.weight;
+    if (target < u)
+      return qprev + (c.mean - qprev) * (target - uprev) / (u - uprev);
+    uprev = u;
+    qprev = c.mean;
+    cum += c.weight;
+  }
+  return uprev < total ? qprev + (digest.max - qprev) * (target - uprev) / (total - uprev) : digest.max;
+}
+
+template <typename ITER>
+double QuantileCalculator<ITER>::quantileIntegral(double u, size_t var)
+{
+  Digest& digest = digests_[var];
+  compress(digest);
+  std::vector<Centroid> const& cs = digest.centroids;
+
+  // trapezoids on the linear pieces of the quantile function, in units of cumulative weight
+  double total = static_cast<double>(nsamples_);
+  double target = u * total;
+  double uprev = 0.0;
+  double qprev = digest.min;
+  double cum = 0.0;
+  double area = 0.0;
+  for (size_t i = 0; i <= cs.size(); ++i) {
+    double unext = i < cs.size() ? cum + 0.5 * cs[i].weight : total;
+    double qnext = i < cs.size() ? cs[i].mean : digest.max;
+    if (target <= unext) {
+      double qend = unext > uprev ? qprev + (qnext - qprev) * (target - uprev) / (unext - uprev) : qnext;
+      area += 0.5 * (qprev + qend) * (target - uprev);
+      return area / total;
+    }
+    area += 0.5 * (qprev + qnext) * (unext - uprev);
+    uprev = unext;
+    qprev = qnext;
+    if (i < cs.size())
+      cum += cs[i].weight;
+  }
+  return area / total;
+}
+
+template <typename ITER>
+double QuantileCalculator<ITER>::lowerTailMean(double p, size_t var)
+{
+  ORF_ASSERT(nsamples_ > 0, "no samples!");
+  ORF_ASSERT(p > 0.0 && p <= 1.0, "the probability must be positive and at most 1!");
+  return quantileIntegral(p, var) / p;
+}
+
+template <typename ITER>
+double QuantileCalculator<ITER>::upperTailMean(double p, size_t var)
+{
+  ORF_ASSERT(nsamples_ > 0, "no samples!");
+  ORF_ASSERT(p >= 0.0 && p < 1.0, "the probability must be at least 0 and less than 1!");
+  return (quantileIntegral(1.0, var) - quantileIntegral(p, var)) / (1.0 - p);
+}
+
+template <typename ITER>
+size_t QuantileCalculator<ITER>::nCentroids(size_t var)
+{
+  compress(digests_[var]);
+  return digests_[var].centroids.size();
+}
+
+template <typename ITER>
+void QuantileCalculator<ITER>::setHistogram(double lo, double hi, size_t nBins)
+{
+  ORF_ASSERT(hi > lo, "the upper bound of the histogram must be above the lower bound!");
+  ORF_ASSERT(nBins > 0, "the histogram needs at least one bin!");
+  histLo_ = lo;
+  histHi_ = hi;
+  histogram_.set_size(nBins + 2, nVariables());
+  reset();
+}
+
+template <typename ITER>
+Matrix const& QuantileCalculator<ITER>::histogram() const
+{
+  return histogram_;
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_QUANTILECALCULATOR_HPP
@@ -1,61 +1,121 @@
-/**
-@file  antitheticpathgenerator.hpp
-@brief Adds antithetic sampling to an existing path generator
-*/
-
-#ifndef ORF_ANTITHETICPATHGENERATOR_HPP
-#define ORF_ANTITHETICPATHGENERATOR_HPP
-
-#include <orflib/methods/montecarlo/pathgenerator.hpp>
-
-BEGIN_NAMESPACE(orf)
-
-/** This class adds antithetic sampling capability to any path generator
-*/
-class AntitheticPathGenerator : public PathGenerator
-{
-public:
-  /** Dtor */
-  virtual ~AntitheticPathGenerator() {}
-
-  /** Initializing ctor */
-  AntitheticPathGenerator(SPtrPathGenerator pg);
-
-  /** Returns the next price path.
-      The Matrix is resized to size ntimesteps * nfactors
-  */
-  virtual void next(Matrix & pricePath) override;
-
-protected:
-  AntitheticPathGenerator() {}        // default ctor
-
-  // state
-  SPtrPathGenerator innerpathgen_;    // pointer to the inner path generator
-  bool dogenerate_;                   // when dogenerate_ is true a new path must be generated
-  Matrix pricePath_;                  // the cached generated path
-};
-
-
-///////////////////////////////////////////////////////////////////////////////
-// Inline definitions
-inline
-AntitheticPathGenerator::AntitheticPathGenerator(SPtrPathGenerator pg)
-: PathGenerator(*pg), innerpathgen_(pg), dogenerate_(true) {}
-
-inline void
-AntitheticPathGenerator::next(Matrix & pricePath)
-{
-  if (dogenerate_) {
-    innerpathgen_->next(pricePath_);
-    dogenerate_ = false;
-  }
-  else {
-    pricePath_ *= -1.0;
-    dogenerate_ = true;
-  }
-  pricePath = pricePath_;
-}
-
-END_NAMESPACE(orf)
-
-#endif // ORF_ANTITHETICPATHGENERATOR_HPP
+/**
+@file  antitheticpathgenerator.hpp
+@brief Adds antithetic sampling to an existing path generator
+*/
+
+#ifndef ORF_ANTITHETICPATHGENERATOR_HPP
+#define ORF_ANTITHETICPATHGENERATOR_HPP
+
+#include <orflib/methods/montecarlo/pathgenerator.hpp>
+
+BEGIN_NAMESPACE(orf)
+
+/** This class adds antithetic sampling capability to any path generator
+*/
+class AntitheticPathGenerator : public PathGenerator
+{
+public:
+  /** Dtor */
+  virtual ~AntitheticPathGenerator() {}
+
+  /** Initializing ctor */
+  AntitheticPathGenerator(SPtrPathGenerator pg);
+
+  /** Returns the next price path.
+      The Matrix is resized to size ntimesteps * nfactors
+  */
+  virtual void next(Matrix & pricePath) override;
+
+  /** Returns a batch of npaths paths, in the same order as next().
+      The pairs are drawn in one batch from the inner path generator.
+  */
+  virtual void nextBatch(size_t npaths, Cube& paths) override;
+
+  /** Positions the generator at the beginning of the random stream of a block of paths.
+      The block must start with a new antithetic pair, i.e. firstPath must be even.
+  */
+  virtual void setStream(unsigned long seed, size_t blockIdx, size_t firstPath) override;
+
+protected:
+  AntitheticPathGenerator() {}        // default ctor
+
+  // state
+  SPtrPathGenerator innerpathgen_;    // pointer to the inner path generator
+  bool dogenerate_;                   // when dogenerate_ is true a new path must be generated
+  Matrix pricePath_;                  // the cached generated path
+  Cube innerPaths_;                   // scratch cube with a batch of paths of the inner generator
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+inline
+AntitheticPathGenerator::AntitheticPathGenerator(SPtrPathGenerator pg)
+: PathGenerator(*pg), innerpathgen_(pg), dogenerate_(true) {}
+
+inline void
+AntitheticPathGenerator::next(Matrix & pricePath)
+{
+  if (dogenerate_) {
+    innerpathgen_->next(pricePath);
+    pricePath_ = pricePath;
+    dogenerate_ = false;
+  }
+  else {
+    pricePath = -pricePath_;
+    dogenerate_ = true;
+  }
+}
+
+inline void
+AntitheticPathGenerator::nextBatch(size_t npaths, Cube& paths)
+{
+  paths.set_size(npaths, nfactors_, ntimesteps_);
+  if (npaths == 0)
+    return;
+  // the first path may complete the pair of the last path of the previous batch
+  size_t first = 0;
+  if (!dogenerate_) {
+    for (size_t i = 0; i < ntimesteps_; ++i)
+      for (size_t j = 0; j < nfactors_; ++j)
+        paths(0, j, i) = -pricePath_(i, j);
+    dogenerate_ = true;
+    first = 1;
+  }
+  // then the pairs of each inner path and its mirror image
+  size_t npairs = (npaths - first + 1) / 2;
+  innerpathgen_->nextBatch(npairs, innerPaths_);
+  size_t nmirrors = (npaths - first) / 2;
+  for (size_t i = 0; i < ntimesteps_; ++i) {
+    for (size_t j = 0; j < nfactors_; ++j) {
+      double const* inner = innerPaths_.slice_colptr(i, j);
+      double* outer = paths.slice_colptr(i, j) + first;
+      for (size_t k = 0; k < nmirrors; ++k) {
+        outer[2 * k] = inner[k];
+        outer[2 * k + 1] = -inner[k];
+      }
+    }
+  }
+  // an odd path left over is completed by the next call
+  if (nmirrors < npairs) {
+    size_t k = npairs - 1;
+    pricePath_.set_size(ntimesteps_, nfactors_);
+    for (size_t i = 0; i < ntimesteps_; ++i)
+      for (size_t j = 0; j < nfactors_; ++j)
+        paths(first + 2 * k, j, i) = pricePath_(i, j) = innerPaths_(k, j, i);
+    dogenerate_ = false;
+  }
+}
+
+inline void
+AntitheticPathGenerator::setStream(unsigned long seed, size_t blockIdx, size_t firstPath)
+{
+  ORF_ASSERT(firstPath % 2 == 0, "AntitheticPathGenerator: a block of paths must start at an even path index!");
+  // each antithetic pair consumes one path of the inner generator
+  innerpathgen_->setStream(seed, blockIdx, firstPath / 2);
+  dogenerate_ = true;
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_ANTITHETICPATHGENERATOR_HPP
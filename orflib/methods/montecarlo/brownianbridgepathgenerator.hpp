@@ -0,0 +1,187 @@
+/**
+@file  brownianbridgepathgenerator.hpp
+@brief Definition of Monte Carlo path generator with Brownian bridge construction
+*/
+
+#ifndef ORF_BROWNIANBRIDGEPATHGENERATOR_HPP
+#define ORF_BROWNIANBRIDGEPATHGENERATOR_HPP
+
+#include <orflib/methods/montecarlo/pathgenerator.hpp>
+#include <orflib/math/random/rng.hpp>
+#include <vector>
+
+BEGIN_NAMESPACE(orf)
+
+/** Creates standard normal increments by Brownian bridge construction.
+    The first deviates of each point build the terminal value of the Brownian motion,
+    the following ones the midpoints of successively finer subintervals.
+    With low discrepancy sequences this assigns the best dimensions to the coarse
+    features of the path. For each bridge step the deviates of all factors are
+    adjacent in the point.
+    It is templetized on the underlying normal deviate generator.
+*/
+template <typename NRNG>
+class BrownianBridgePathGenerator : public PathGenerator
+{
+public:
+
+  /** Ctor for generating increments for correlated factors.
+      If the correlation matrix is not passed in, it assumes independent factors
+  */
+  template<typename ITER>
+  BrownianBridgePathGenerator(ITER timestepsBegin, ITER timestepsEnd, size_t nfactors,
+                              Matrix const & correlMat = Matrix());
+
+  /** Returns the dimension of the generator */
+  size_t dim() const;
+
+  /** Returns the next price path */
+  virtual void next(Matrix& pricePath) override;
+
+  /** Returns the next npaths price paths, one slice per time step */
+  virtual void nextBatch(size_t npaths, Cube& paths) override;
+
+  /** Positions the generator at the beginning of the random stream of a block of paths */
+  virtual void setStream(unsigned long seed, size_t blockIdx, size_t firstPath) override;
+
+protected:
+  /** Builds the standardized increments of factor j from the deviates in normalDevs_ */
+  void buildIncrements(size_t j);
+
+  NRNG nrng_;
+  Vector sqrtDeltaT_;              // sqrt(T1), sqrt(T2-T1), ...
+  std::vector<size_t> bridgeIdx_;  // the time step built by each bridge step
+  std::vector<size_t> leftIdx_;    // 1 + time step of the left end of each bridge step, 0 if it is time 0
+  std::vector<size_t> rightIdx_;   // time step of the right end of each bridge step
+  Vector leftWgt_;                 // weight of the left end value for each bridge step
+  Vector rightWgt_;                // weight of the right end value for each bridge step
+  Vector stdDev_;                  // conditional standard deviation for each bridge step
+  Vector normalDevs_;              // scratch array with one point of deviates
+  Vector increments_;              // scratch array with the increments of one factor
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+template <typename NRNG>
+template <typename ITER>
+inline BrownianBridgePathGenerator<NRNG>::BrownianBridgePathGenerator(ITER timestepsBegin,
+                                            ITER timestepsEnd,
+                                            size_t nfactors,
+                                            Matrix const& correlMat)
+  : PathGenerator((timestepsEnd - timestepsBegin), nfactors, correlMat),
+  nrng_((timestepsEnd - timestepsBegin) * nfactors, 0.0, 1.0)
+{
+  ORF_ASSERT(ntimesteps_ > 0, "no time steps!");
+  Vector times(ntimesteps_);
+  sqrtDeltaT_.resize(ntimesteps_);
+  ITER it = timestepsBegin;
+  for (size_t i = 0; it != timestepsEnd; ++it, ++i) {
+    times[i] = *it;
+    double deltaT = i == 0 ? times[0] : times[i] - times[i - 1];
+    ORF_ASSERT(deltaT > 0.0 || (i == 0 && deltaT == 0.0),
+      "time steps are negative, not unique or not in increasing order!");
+    sqrtDeltaT_[i] = sqrt(deltaT);
+  }
+
+  // precompute the bridge construction order and weights
+  bridgeIdx_.resize(ntimesteps_);
+  leftIdx_.resize(ntimesteps_);
+  rightIdx_.resize(ntimesteps_);
+  leftWgt_.zeros(ntimesteps_);
+  rightWgt_.zeros(ntimesteps_);
+  stdDev_.resize(ntimesteps_);
+  std::vector<bool> built(ntimesteps_, false);
+  // the first step builds the terminal value
+  built[ntimesteps_ - 1] = true;
+  bridgeIdx_[0] = ntimesteps_ - 1;
+  leftIdx_[0] = 0;
+  rightIdx_[0] = ntimesteps_ - 1;
+  stdDev_[0] = sqrt(times[ntimesteps_ - 1]);
+  // the following steps build the midpoints of the gaps, sweeping the time line repeatedly
+  for (size_t i = 1, j = 0; i < ntimesteps_; ++i) {
+    while (built[j]) ++j;          // j: first point of the gap
+    size_t k = j;
+    while (!built[k]) ++k;         // k: built point at the right end of the gap
+    size_t l = j + ((k - 1 - j) >> 1);
+    built[l] = true;
+    bridgeIdx_[i] = l;
+    leftIdx_[i] = j;
+    rightIdx_[i] = k;
+    double tleft = j == 0 ? 0.0 : times[j - 1];
+    double span = times[k] - tleft;
+    leftWgt_[i] = (times[k] - times[l]) / span;
+    rightWgt_[i] = (times[l] - tleft) / span;
+    stdDev_[i] = sqrt((times[l] - tleft) * (times[k] - times[l]) / span);
+    j = k + 1;
+    if (j >= ntimesteps_) j = 0;
+  }
+
+  normalDevs_.resize(ntimesteps_ * nfactors_);
+  increments_.resize(ntimesteps_);
+}
+
+template <typename NRNG>
+inline size_t BrownianBridgePathGenerator<NRNG>::dim() const
+{
+  return nrng_.dim();
+}
+
+template <typename NRNG>
+inline void BrownianBridgePathGenerator<NRNG>::buildIncrements(size_t j)
+{
+  // build the Brownian path at the time steps
+  increments_[ntimesteps_ - 1] = stdDev_[0] * normalDevs_[j];
+  for (size_t i = 1; i < ntimesteps_; ++i) {
+    size_t l = bridgeIdx_[i];
+    size_t left = leftIdx_[i];
+    double wl = left == 0 ? 0.0 : leftWgt_[i] * increments_[left - 1];
+    increments_[l] = wl + rightWgt_[i] * increments_[rightIdx_[i]]
+                   + stdDev_[i] * normalDevs_[i * nfactors_ + j];
+  }
+  // take the differences and standardize them
+  for (size_t i = ntimesteps_ - 1; i > 0; --i)
+    increments_[i] = (increments_[i] - increments_[i - 1]) / sqrtDeltaT_[i];
+  increments_[0] = sqrtDeltaT_[0] > 0.0 ? increments_[0] / sqrtDeltaT_[0] : 0.0;
+}
+
+template <typename NRNG>
+inline void BrownianBridgePathGenerator<NRNG>::next(Matrix& pricePath)
+{
+  pricePath.resize(ntimesteps_, nfactors_);
+  nrng_.next(normalDevs_.begin(), normalDevs_.end());
+  for (size_t j = 0; j < nfactors_; ++j) {
+    buildIncrements(j);
+    for (size_t i = 0; i < ntimesteps_; ++i)
+      pricePath(i, j) = increments_[i];
+  }
+  // finally apply the Cholesky factor if not empty
+  correlate(pricePath);
+}
+
+template <typename NRNG>
+inline void BrownianBridgePathGenerator<NRNG>::nextBatch(size_t npaths, Cube& paths)
+{
+  paths.set_size(npaths, nfactors_, ntimesteps_);
+  for (size_t p = 0; p < npaths; ++p) {
+    nrng_.next(normalDevs_.begin(), normalDevs_.end());
+    for (size_t j = 0; j < nfactors_; ++j) {
+      buildIncrements(j);
+      for (size_t i = 0; i < ntimesteps_; ++i)
+        paths(p, j, i) = increments_[i];
+    }
+  }
+  // apply the Cholesky factor to all paths of each time step at once
+  correlate(paths);
+}
+
+template <typename NRNG>
+inline void BrownianBridgePathGenerator<NRNG>::setStream(unsigned long seed, size_t blockIdx, size_t firstPath)
+{
+  // each path consumes one point of dimension ntimesteps * nfactors
+  nrng_.setStream(seed, blockIdx, firstPath);
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_BROWNIANBRIDGEPATHGENERATOR_HPP
@@ -0,0 +1,164 @@
+/**
+@file  controlvariate.hpp
+@brief Control variates with regression coefficients estimated during the simulation
+*/
+
+#ifndef ORF_CONTROLVARIATE_HPP
+#define ORF_CONTROLVARIATE_HPP
+
+#include <orflib/defines.hpp>
+#include <orflib/exception.hpp>
+#include <orflib/math/matrix.hpp>
+
+BEGIN_NAMESPACE(orf)
+
+/** Adjusts Monte Carlo samples with control variates of known expectation.
+    Each sample y is replaced by y - beta' (c - mu), where c are the controls on the same path
+    and mu their expectations. The coefficients beta are the least squares regression coefficients
+    of y on c, estimated from all the previous batches only. They are thus independent of the batch
+    they are applied to, and the adjusted samples remain unbiased. The first batch is not adjusted.
+*/
+class ControlVariate
+{
+public:
+  /** Ctor from the expectations of the controls */
+  explicit ControlVariate(Vector const& means);
+
+  /** Returns the number of controls */
+  size_t nControls() const;
+
+  /** Returns the current regression coefficients */
+  Vector const& beta() const;
+
+  /** Adjusts the npaths samples in pvs in place. The controls are the rows
+      [firstRow, firstRow + npaths) of controls, one column per control.
+      The unadjusted batch is then added to the regression.
+  */
+  void adjust(size_t npaths, double* pvs, Matrix const& controls, size_t firstRow = 0);
+
+  /** Clears the regression; the next batch is not adjusted */
+  void reset();
+
+private:
+  // state
+  Vector means_;          // the expectations of the controls
+  Vector beta_;           // the regression coefficients
+  size_t nsamples_;       // the number of samples in the regression
+  double sumy_;           // sum of the samples
+  Vector sumd_;           // sum of the controls less their means
+  Vector sumdy_;          // sum of the controls less their means, times the samples
+  Matrix sumdd_;          // sum of the outer products of the controls less their means
+  Matrix devs_;           // scratch matrix with the controls less their means
+  Vector adj_;            // scratch vector with the adjustments of the batch
+  Matrix cov_;            // scratch matrix with the covariance of the controls
+};
+
+/** Mean and variance of the log of the geometric average of S(t_i, j) / S(0, j) over all
+    fixings i and assets j, for lognormal assets. The log increments from fixing to fixing have
+    means drifts(i, j) and standard deviations stdevs(i, j), and are correlated across assets
+    with the matrix correl.
+*/
+void geometricAverageMoments(Matrix const& drifts, Matrix const& stdevs, Matrix const& correl,
+                             double& mean, double& variance);
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+inline
+ControlVariate::ControlVariate(Vector const& means)
+: means_(means)
+{
+  ORF_ASSERT(means.n_elem > 0, "ControlVariate: need at least one control!");
+  reset();
+}
+
+inline
+size_t ControlVariate::nControls() const
+{
+  return means_.n_elem;
+}
+
+inline
+Vector const& ControlVariate::beta() const
+{
+  return beta_;
+}
+
+inline
+void ControlVariate::reset()
+{
+  size_t nctrls = means_.n_elem;
+  beta_.zeros(nctrls);
+  nsamples_ = 0;
+  sumy_ = 0.0;
+  sumd_.zeros(nctrls);
+  sumdy_.zeros(nctrls);
+  sumdd_.zeros(nctrls, nctrls);
+}
+
+inline
+void ControlVariate::adjust(size_t npaths, double* pvs, Matrix const& controls, size_t firstRow)
+{
+  ORF_ASSERT(controls.n_cols == nControls(), "ControlVariate: wrong number of controls!");
+  ORF_ASSERT(firstRow + npaths <= controls.n_rows, "ControlVariate: not enough rows of controls!");
+  if (npaths == 0)
+    return;
+  devs_ = controls.rows(firstRow, firstRow + npaths - 1);
+  devs_.each_row() -= means_.t();
+  // the adjustments use the coefficients of the previous batches
+  bool adjusting = nsamples_ > 0;
+  if (adjusting)
+    adj_ = devs_ * beta_;
+
+  // add the unadjusted batch to the regression, viewing the samples in place
+  {
+    const Vector y(pvs, npaths, false, true);
+    sumy_ += arma::accu(y);
+    sumd_ += arma::sum(devs_, 0).t();
+    sumdy_ += devs_.t() * y;
+    sumdd_ += devs_.t() * devs_;
+  }
+  nsamples_ += npaths;
+  if (adjusting) {
+    for (size_t p = 0; p < npaths; ++p)
+      pvs[p] -= adj_[p];
+  }
+
+  // update the coefficients
+  if (nsamples_ < 2)
+    return;
+  double n = static_cast<double>(nsamples_);
+  cov_ = (sumdd_ - sumd_ * sumd_.t() / n) / (n - 1.0);
+  Vector covdy = (sumdy_ - sumd_ * (sumy_ / n)) / (n - 1.0);
+  Vector beta;
+  // keep the previous coefficients if the controls are degenerate so far
+  if (arma::solve(beta, cov_, covdy, arma::solve_opts::no_approx))
+    beta_ = beta;
+}
+
+inline
+void geometricAverageMoments(Matrix const& drifts, Matrix const& stdevs, Matrix const& correl,
+                             double& mean, double& variance)
+{
+  ORF_ASSERT(drifts.n_rows == stdevs.n_rows && drifts.n_cols == stdevs.n_cols,
+    "geometricAverageMoments: drifts and stdevs must have the same size!");
+  ORF_ASSERT(correl.n_rows == stdevs.n_cols && correl.is_square(),
+    "geometricAverageMoments: need one row of the correlation matrix per asset!");
+  size_t nfix = drifts.n_rows;
+  double wgt = 1.0 / static_cast<double>(nfix * drifts.n_cols);
+  mean = 0.0;
+  variance = 0.0;
+  // the increment from fixing i - 1 to i enters the nfix - i fixings from i onwards
+  for (size_t i = 0; i < nfix; ++i) {
+    double nlater = static_cast<double>(nfix - i);
+    RowVector sd = stdevs.row(i);
+    mean += nlater * arma::accu(drifts.row(i));
+    variance += nlater * nlater * arma::as_scalar(sd * correl * sd.t());
+  }
+  mean *= wgt;
+  variance *= wgt * wgt;
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_CONTROLVARIATE_HPP
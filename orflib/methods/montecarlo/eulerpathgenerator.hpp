@@ -1,99 +1,261 @@
-/**
-@file  pathgenerator.hpp
-@brief Definition of Monte Carlo path generator with Euler time stepping
-*/
-
-#ifndef ORF_EULERPATHGENERATOR_HPP
-#define ORF_EULERPATHGENERATOR_HPP
-
-#include <orflib/methods/montecarlo/pathgenerator.hpp>
-#include <orflib/math/random/rng.hpp>
-
-BEGIN_NAMESPACE(orf)
-
-/** Creates standard normal increments populating the time line sequentially.
-    It is templetized on the underlying normal deviate generator.
-*/
-template <typename NRNG>
-class EulerPathGenerator : public PathGenerator
-{
-public:
-
-  /** Ctor for generating increments for correlated factors.
-      If the correlation matrix is not passed in, it assumes independent factors
-  */
-  template<typename ITER>
-  EulerPathGenerator(ITER timestepsBegin, ITER timestepsEnd, size_t nfactors,
-                     Matrix const & correlMat = Matrix());
-
-  /** Returns the dimension of the generator */
-  size_t dim() const;
-
-  /** Returns the next price path */
-  virtual void next(Matrix& pricePath) override;
-
-protected:
-  NRNG nrng_;
-  Vector sqrtDeltaT_;              // sqrt(T1), sqrt(T2-T1), ...
-  Vector normalDevs_;              // scratch array
-
-};
-
-///////////////////////////////////////////////////////////////////////////////
-// Inline definitions
-
-template <typename NRNG>
-template <typename ITER>
-inline EulerPathGenerator<NRNG>::EulerPathGenerator(ITER timestepsBegin,
-                          ITER timestepsEnd,
-                          size_t nfactors,
-                          Matrix const& correlMat)
-  : PathGenerator((timestepsEnd - timestepsBegin), nfactors, correlMat),
-  nrng_((timestepsEnd - timestepsBegin) * nfactors, 0.0, 1.0)
-{
-  ORF_ASSERT(ntimesteps_ > 0, "no time steps!");
-  normalDevs_.resize(ntimesteps_);
-  sqrtDeltaT_.resize(ntimesteps_);
-  sqrtDeltaT_[0] = sqrt(*timestepsBegin);
-  ITER it = ++timestepsBegin;
-  size_t i = 1;
-  for (; it != timestepsEnd; ++it, ++i) {
-    double deltaT = *it - *(it - 1);
-    ORF_ASSERT(deltaT > 0.0, "time steps are not unique or not in increasing order!");
-    sqrtDeltaT_(i) = sqrt(deltaT);
-  }
-}
-
-template <typename NRNG>
-inline size_t EulerPathGenerator<NRNG>::dim() const
-{
-  return nrng_.dim();
-}
-
-template <typename NRNG>
-inline void EulerPathGenerator<NRNG>::next(Matrix& pricePath)
-{
-  pricePath.resize(ntimesteps_, nfactors_);
-  // iterate over columns; the matrix will be filled column by column
-  for (size_t j = 0; j < nfactors_; ++j) {
-    nrng_.next(normalDevs_.begin(), normalDevs_.end());
-    for (size_t i = 0; i < ntimesteps_; ++i)
-      pricePath(i, j) = normalDevs_(i);
-  }
-  // finally apply the Cholesky factor if not empty
-  if (sqrtCorrel_.n_rows != 0) {
-    for (size_t i = 0; i < ntimesteps_; ++i) {
-      for (size_t j = 0; j < nfactors_; ++j) {
-        double sum = 0.0;
-        for (size_t k = 0; k < nfactors_; ++k) {
-          sum += sqrtCorrel_(nfactors_ - j - 1, k) * pricePath(i, k);
-        }
-        pricePath(i, nfactors_ - j - 1) = sum;
-      }
-    }
-  }
-}
-
-END_NAMESPACE(orf)
-
-#endif // ORF_EULERPATHGENERATOR_HPP
+/**
+@file  pathgenerator.hpp
+@brief Definition of Monte Carlo path generator with Euler time stepping
+*/
+
+#ifndef ORF_EULERPATHGENERATOR_HPP
+#define ORF_EULERPATHGENERATOR_HPP
+
+#include <orflib/methods/montecarlo/pathgenerator.hpp>
+#include <orflib/math/random/rng.hpp>
+
+BEGIN_NAMESPACE(orf)
+
+/** Creates standard normal increments populating the time line sequentially.
+    It is templetized on the underlying normal deviate generator.
+*/
+template <typename NRNG>
+class EulerPathGenerator : public PathGenerator
+{
+public:
+
+  /** Ctor for generating increments for correlated factors.
+      If the correlation matrix is not passed in, it assumes independent factors
+  */
+  template<typename ITER>
+  EulerPathGenerator(ITER timestepsBegin, ITER timestepsEnd, size_t nfactors,
+                     Matrix const & correlMat = Matrix());
+
+  /** Returns the dimension of the generator */
+  size_t dim() const;
+
+  /** Returns the next price path */
+  virtual void next(Matrix& pricePath) override;
+
+  /** Returns the next npaths price paths, one slice per time step */
+  virtual void nextBatch(size_t npaths, Cube& paths) override;
+
+  /** Starts the lazy generation of a batch of npaths paths.
+      With normal rngs that map each uniform deviate to a normal one by the inverse cdf, it draws
+      only the uniform deviates of the batch, and nextStep() maps those of the active paths.
+  */
+  virtual void beginBatch(size_t npaths) override;
+
+  /** Writes time step i of the lazy batch into devs, for the active paths only */
+  virtual void nextStep(size_t i, std::vector<size_t> const& active, Matrix& devs) override;
+
+  /** Positions the generator at the beginning of the random stream of a block of paths */
+  virtual void setStream(unsigned long seed, size_t blockIdx, size_t firstPath) override;
+
+  /** Importance sampling: shifts the independent deviates by shift, of size ntimesteps * nfactors */
+  virtual void setDriftShift(Matrix const& shift) override;
+
+protected:
+  /** Shifts the deviates of factor j in normalDevs_ and adds their terms of the log likelihood
+      ratio, -shift(i, j) * dev(i), to logw
+  */
+  void shiftDevs(size_t j, double& logw);
+
+  /** Draws the uniform deviates of a lazy batch into lazyPaths_, in the order of nextBatch() */
+  template <typename URNG>
+  void beginLazyBatch(NormalRng<URNG, true>& nrng, size_t npaths);
+
+  /** Other normal rngs generate the whole batch, see PathGenerator::beginBatch() */
+  template <typename RNG>
+  void beginLazyBatch(RNG& nrng, size_t npaths);
+
+  /** Maps the uniform deviates of time step i of the active paths to correlated normal deviates */
+  template <typename URNG>
+  void nextLazyStep(NormalRng<URNG, true>& nrng, size_t i, std::vector<size_t> const& active, Matrix& devs);
+
+  /** Other normal rngs copy the deviates, see PathGenerator::nextStep() */
+  template <typename RNG>
+  void nextLazyStep(RNG& nrng, size_t i, std::vector<size_t> const& active, Matrix& devs);
+
+  NRNG nrng_;
+  Vector sqrtDeltaT_;              // sqrt(T1), sqrt(T2-T1), ...
+  Vector normalDevs_;              // scratch array
+  Vector stepDevs_;                // scratch array with the deviates of the active paths of one time step
+  double shiftHalfNorm2_ = 0.0;    // half the squared norm of the drift shift, the constant term of the log weights
+
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+template <typename NRNG>
+template <typename ITER>
+inline EulerPathGenerator<NRNG>::EulerPathGenerator(ITER timestepsBegin,
+                          ITER timestepsEnd,
+                          size_t nfactors,
+                          Matrix const& correlMat)
+  : PathGenerator((timestepsEnd - timestepsBegin), nfactors, correlMat),
+  nrng_((timestepsEnd - timestepsBegin) * nfactors, 0.0, 1.0)
+{
+  ORF_ASSERT(ntimesteps_ > 0, "no time steps!");
+  normalDevs_.resize(ntimesteps_);
+  sqrtDeltaT_.resize(ntimesteps_);
+  sqrtDeltaT_[0] = sqrt(*timestepsBegin);
+  ITER it = ++timestepsBegin;
+  size_t i = 1;
+  for (; it != timestepsEnd; ++it, ++i) {
+    double deltaT = *it - *(it - 1);
+    ORF_ASSERT(deltaT > 0.0, "time steps are not unique or not in increasing order!");
+    sqrtDeltaT_(i) = sqrt(deltaT);
+  }
+}
+
+template <typename NRNG>
+inline size_t EulerPathGenerator<NRNG>::dim() const
+{
+  return nrng_.dim();
+}
+
+template <typename NRNG>
+inline void EulerPathGenerator<NRNG>::next(Matrix& pricePath)
+{
+  pricePath.resize(ntimesteps_, nfactors_);
+  // iterate over columns; the matrix will be filled column by column
+  bool shifted = !shift_.is_empty();
+  double logw = shiftHalfNorm2_;
+  for (size_t j = 0; j < nfactors_; ++j) {
+    nrng_.next(normalDevs_.begin(), normalDevs_.end());
+    if (shifted)
+      shiftDevs(j, logw);
+    for (size_t i = 0; i < ntimesteps_; ++i)
+      pricePath(i, j) = normalDevs_(i);
+  }
+  if (shifted)
+    logWeights_.set_size(1)[0] = logw;
+  // finally apply the Cholesky factor if not empty
+  correlate(pricePath);
+}
+
+template <typename NRNG>
+inline void EulerPathGenerator<NRNG>::nextBatch(size_t npaths, Cube& paths)
+{
+  paths.set_size(npaths, nfactors_, ntimesteps_);
+  bool shifted = !shift_.is_empty();
+  if (shifted)
+    logWeights_.set_size(npaths);
+  // draw the deviates path by path, in the same order as next()
+  for (size_t p = 0; p < npaths; ++p) {
+    double logw = shiftHalfNorm2_;
+    for (size_t j = 0; j < nfactors_; ++j) {
+      nrng_.next(normalDevs_.begin(), normalDevs_.end());
+      if (shifted)
+        shiftDevs(j, logw);
+      for (size_t i = 0; i < ntimesteps_; ++i)
+        paths(p, j, i) = normalDevs_(i);
+    }
+    if (shifted)
+      logWeights_[p] = logw;
+  }
+  // apply the Cholesky factor to all paths of each time step at once
+  correlate(paths);
+}
+
+template <typename NRNG>
+inline void EulerPathGenerator<NRNG>::beginBatch(size_t npaths)
+{
+  beginLazyBatch(nrng_, npaths);
+}
+
+template <typename NRNG>
+inline void EulerPathGenerator<NRNG>::nextStep(size_t i, std::vector<size_t> const& active, Matrix& devs)
+{
+  nextLazyStep(nrng_, i, active, devs);
+}
+
+template <typename NRNG>
+template <typename URNG>
+inline void EulerPathGenerator<NRNG>::beginLazyBatch(NormalRng<URNG, true>& nrng, size_t npaths)
+{
+  // the whole batch is drawn, so the stream stays aligned, but the inverse cdf is deferred
+  lazyPaths_.set_size(npaths, nfactors_, ntimesteps_);
+  if (!shift_.is_empty())
+    logWeights_.zeros(npaths);
+  for (size_t p = 0; p < npaths; ++p) {
+    for (size_t j = 0; j < nfactors_; ++j) {
+      nrng.nextUniform(normalDevs_.begin(), normalDevs_.end());
+      for (size_t i = 0; i < ntimesteps_; ++i)
+        lazyPaths_(p, j, i) = normalDevs_(i);
+    }
+  }
+}
+
+template <typename NRNG>
+template <typename RNG>
+inline void EulerPathGenerator<NRNG>::beginLazyBatch(RNG& nrng, size_t npaths)
+{
+  PathGenerator::beginBatch(npaths);
+}
+
+template <typename NRNG>
+template <typename URNG>
+inline void EulerPathGenerator<NRNG>::nextLazyStep(NormalRng<URNG, true>& nrng, size_t i,
+                                                   std::vector<size_t> const& active, Matrix& devs)
+{
+  devs.set_size(lazyPaths_.n_rows, nfactors_);
+  stepDevs_.set_size(active.size());
+  for (size_t j = 0; j < nfactors_; ++j) {
+    double const* uniforms = lazyPaths_.slice_colptr(i, j);
+    double* dst = devs.colptr(j);
+    for (size_t k = 0; k < active.size(); ++k)
+      stepDevs_[k] = uniforms[active[k]];
+    nrng.toNormal(stepDevs_.begin(), stepDevs_.end());
+    for (size_t k = 0; k < active.size(); ++k)
+      dst[active[k]] = stepDevs_[k];
+    if (!shift_.is_empty()) {
+      // the terms of time step i of the log likelihood ratios, as in shiftDevs()
+      double theta = shift_(i, j);
+      for (size_t p : active) {
+        dst[p] += theta;
+        logWeights_[p] += theta * (0.5 * theta - dst[p]);
+      }
+    }
+  }
+  // the same dense product as nextBatch(), row by row, so the active rows get the same values
+  correlate(devs);
+}
+
+template <typename NRNG>
+template <typename RNG>
+inline void EulerPathGenerator<NRNG>::nextLazyStep(RNG& nrng, size_t i,
+                                                   std::vector<size_t> const& active, Matrix& devs)
+{
+  PathGenerator::nextStep(i, active, devs);
+}
+
+template <typename NRNG>
+inline void EulerPathGenerator<NRNG>::setStream(unsigned long seed, size_t blockIdx, size_t firstPath)
+{
+  // each path consumes one point of dimension ntimesteps * nfactors
+  nrng_.setStream(seed, blockIdx, firstPath);
+}
+
+template <typename NRNG>
+inline void EulerPathGenerator<NRNG>::setDriftShift(Matrix const& shift)
+{
+  if (!shift.is_empty())
+    ORF_ASSERT(shift.n_rows == ntimesteps_ && shift.n_cols == nfactors_,
+               "the drift shift must have one row per time step and one column per factor!");
+  shift_ = shift;
+  shiftHalfNorm2_ = 0.5 * arma::accu(arma::square(shift_));
+  logWeights_.reset();
+}
+
+template <typename NRNG>
+inline void EulerPathGenerator<NRNG>::shiftDevs(size_t j, double& logw)
+{
+  // the density ratio of N(0, 1) to N(theta, 1) at dev is exp(-theta * dev + theta^2 / 2)
+  double const* theta = shift_.colptr(j);
+  for (size_t i = 0; i < ntimesteps_; ++i) {
+    normalDevs_[i] += theta[i];
+    logw -= theta[i] * normalDevs_[i];
+  }
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_EULERPATHGENERATOR_HPP
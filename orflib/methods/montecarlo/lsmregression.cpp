@@ -0,0 +1,149 @@
+/**
+@file  lsmregression.cpp
+@brief Implementation of the Longstaff-Schwartz regression
+*/
+
+#include <orflib/methods/montecarlo/lsmregression.hpp>
+
+BEGIN_NAMESPACE(orf)
+
+LsmRegression::LsmRegression(Vector const& spots, size_t degree)
+: scales_(1.0 / spots), spots_(spots.n_elem)
+{
+  size_t nvars = spots.n_elem;
+  ORF_ASSERT(nvars > 0, "LsmRegression: need at least one asset!");
+  ORF_ASSERT(spots.min() > 0.0, "LsmRegression: the spots must be positive!");
+
+  // the monomials of each degree multiply those of the previous degree by a regressor,
+  // taking each regressor no earlier than the last one of the monomial to avoid duplicates
+  std::vector<size_t> lastvar(1, 0);
+  parent_.assign(1, 0);
+  var_.assign(1, 0);
+  size_t begin = 0;
+  for (size_t d = 1; d <= degree; ++d) {
+    size_t end = parent_.size();
+    for (size_t k = begin; k < end; ++k) {
+      for (size_t v = lastvar[k]; v < nvars; ++v) {
+        parent_.push_back(k);
+        var_.push_back(v);
+        lastvar.push_back(v);
+      }
+    }
+    begin = end;
+  }
+  basis_.set_size(parent_.size());
+}
+
+void LsmRegression::calibrate(Product& prod, Cube const& paths, Vector const& discFactors)
+{
+  size_t npaths = paths.n_rows;
+  size_t nassets = paths.n_cols;
+  size_t nfix = paths.n_slices;
+  ORF_ASSERT(npaths > 0, "LsmRegression: no paths to regress on!");
+  ORF_ASSERT(nassets == spots_.n_elem, "LsmRegression: need one column of the paths per asset!");
+  ORF_ASSERT(prod.fixTimes().n_elem == nfix, "LsmRegression: need one slice of the paths per fixing time!");
+  ORF_ASSERT(discFactors.n_elem == nfix, "LsmRegression: need one discount factor per fixing time!");
+  coeffs_.assign(nfix, Vector());
+
+  // the PVs of the payments at the last fixing time
+  Vector pvs(npaths);
+  for (size_t p = 0; p < npaths; ++p) {
+    for (size_t j = 0; j < nassets; ++j)
+      spots_[j] = paths(p, j, nfix - 1);
+    prod.eval(nfix - 1, spots_, 0.0);
+    pvs[p] = discFactors[nfix - 1] * prod.payAmounts()[nfix - 1];
+  }
+
+  // backwards over the fixing times, updating the PVs of the paths that exercise
+  std::vector<size_t> itm;
+  Matrix regressors;
+  Vector values;
+  for (size_t i = nfix - 1; i-- > 0;) {
+    // the in the money paths, where the product pays something with no continuation value
+    itm.clear();
+    for (size_t p = 0; p < npaths; ++p) {
+      for (size_t j = 0; j < nassets; ++j)
+        spots_[j] = paths(p, j, i);
+      prod.eval(i, spots_, 0.0);
+      if (prod.payAmounts()[i] > 0.0)
+        itm.push_back(p);
+    }
+    if (itm.empty())
+      continue;         // never exercised at this fixing time
+
+    size_t nitm = itm.size();
+    regressors.set_size(nitm, nBasis());
+    values.set_size(nitm);
+    for (size_t k = 0; k < nitm; ++k) {
+      for (size_t j = 0; j < nassets; ++j)
+        spots_[j] = paths(itm[k], j, i);
+      evalBasis();
+      regressors.row(k) = basis_.t();
+      values[k] = pvs[itm[k]];
+    }
+    // with too few or identical spots, e.g. at time 0, regress on the constant only
+    Vector& beta = coeffs_[i];
+    if (!arma::solve(beta, regressors, values, arma::solve_opts::no_approx)) {
+      beta.zeros(nBasis());
+      beta[0] = arma::mean(values);
+    }
+
+    // the continuation values are paid at this fixing time
+    Vector contvals = regressors * beta / discFactors[i];
+    for (size_t k = 0; k < nitm; ++k) {
+      for (size_t j = 0; j < nassets; ++j)
+        spots_[j] = paths(itm[k], j, i);
+      if (exercises(prod, i, contvals[k]))
+        pvs[itm[k]] = discFactors[i] * prod.payAmounts()[i];
+    }
+  }
+}
+
+double LsmRegression::exercisePV(Product& prod, Matrix const& pricePath, Vector const& discFactors)
+{
+  size_t nfix = pricePath.n_rows;
+  ORF_ASSERT(coeffs_.size() == nfix, "LsmRegression: the regression is not calibrated for this product!");
+  double pv = 0.0;
+  size_t i = 0;
+  while (!exerciseStep(prod, i, pricePath, i, discFactors, pv))
+    ++i;
+  return pv;
+}
+
+double LsmRegression::exercisePV(Product& prod, Matrix const& pricePath, Vector const& discFactors,
+                                 std::vector<size_t> const& fixIdx)
+{
+  size_t nfix = pricePath.n_rows;
+  ORF_ASSERT(coeffs_.size() == nfix, "LsmRegression: the regression is not calibrated for this product!");
+  ORF_ASSERT(!fixIdx.empty() && fixIdx.back() == nfix - 1, "LsmRegression: the last fixing time must be an exercise time!");
+  // the other fixing times are skipped, the product is always exercised at the last one
+  double pv = 0.0;
+  size_t k = 0;
+  while (!exerciseStep(prod, fixIdx[k], pricePath, fixIdx[k], discFactors, pv))
+    ++k;
+  return pv;
+}
+
+bool LsmRegression::exerciseStep(Product& prod, size_t idx, Matrix const& spots, size_t row,
+                                 Vector const& discFactors, double& pv)
+{
+  bool last = idx + 1 == coeffs_.size();
+  if (!last && coeffs_[idx].is_empty())
+    return false;       // never exercised at this fixing time
+  for (size_t j = 0; j < spots.n_cols; ++j)
+    spots_[j] = spots(row, j);
+  if (last) {
+    // not exercised early, the product pays at the last fixing time
+    prod.eval(idx, spots_, 0.0);
+  }
+  else {
+    evalBasis();
+    double contval = arma::dot(basis_, coeffs_[idx]) / discFactors[idx];
+    if (!exercises(prod, idx, contval))
+      return false;
+  }
+  pv = discFactors[idx] * prod.payAmounts()[idx];
+  return true;
+}
+
+END_NAMESPACE(orf)
@@ -0,0 +1,103 @@
+/**
+@file  lsmregression.hpp
+@brief Longstaff-Schwartz regression of continuation values, for products with early exercise
+*/
+
+#ifndef ORF_LSMREGRESSION_HPP
+#define ORF_LSMREGRESSION_HPP
+
+#include <orflib/products/product.hpp>
+#include <vector>
+
+BEGIN_NAMESPACE(orf)
+
+/** Estimates the exercise policy of a product with early exercise by least squares Monte Carlo
+    (Longstaff-Schwartz). Going backwards over the fixing times, the PVs of the payments that follow
+    the policy from the next fixing time onwards are regressed on polynomials in the spots, over the
+    in-the-money paths only. The regressors are the spots relative to their initial values, and the
+    basis holds all their monomials up to a given total degree.
+    The exercise decisions are taken by the product, through eval(idx, spots, contValue).
+    Pricing on paths independent of those used in the regression gives a low biased estimate.
+*/
+class LsmRegression
+{
+public:
+  /** Ctor from the initial spots, one per asset, and the total degree of the polynomials */
+  LsmRegression(Vector const& spots, size_t degree);
+
+  /** Returns the number of basis functions */
+  size_t nBasis() const;
+
+  /** Estimates the regression coefficients on a batch of price paths, with one row per path,
+      one column per asset and one slice per fixing time of the product.
+      The discount factors are to the fixing times, where the exercise payments are made.
+  */
+  void calibrate(Product& prod, Cube const& paths, Vector const& discFactors);
+
+  /** Evaluates the product on a price path, one row per fixing time and one column per asset,
+      exercising at the first fixing time where the product prefers its intrinsic value to the
+      estimated continuation value. It returns the PV of the exercise payment.
+  */
+  double exercisePV(Product& prod, Matrix const& pricePath, Vector const& discFactors);
+
+  /** Like exercisePV(), but the product can only be exercised at the fixing times with indices
+      in fixIdx, in increasing order and ending with the last one. The other rows of pricePath
+      are not used.
+  */
+  double exercisePV(Product& prod, Matrix const& pricePath, Vector const& discFactors,
+                    std::vector<size_t> const& fixIdx);
+
+  /** Evaluates the product at fixing time idx on the spots in the given row of spots, one column
+      per asset. It returns true if the product is exercised there, as it always is at the last
+      fixing time, and then writes the PV of the exercise payment into pv.
+      So paths can be evaluated one fixing time at a time, and stopped once exercised.
+  */
+  bool exerciseStep(Product& prod, size_t idx, Matrix const& spots, size_t row,
+                    Vector const& discFactors, double& pv);
+
+private:
+  /** Writes the basis functions of the spots in spots_ into basis_ */
+  void evalBasis();
+
+  /** Evaluates the product at fixing time idx for the spots in spots_, with the given continuation
+      value, and returns true if it exercises, i.e. pays more than the continuation value.
+  */
+  bool exercises(Product& prod, size_t idx, double contValue);
+
+  // state
+  Vector scales_;                   // the inverses of the initial spots
+  std::vector<size_t> parent_;      // basis function k is basis function parent_[k]
+  std::vector<size_t> var_;         // times the regressor var_[k], for k > 0
+  std::vector<Vector> coeffs_;      // the coefficients at each fixing time, empty if never exercised
+  Vector spots_;                    // scratch array with the spots of one path at one fixing time
+  Vector basis_;                    // scratch array with the basis functions of spots_
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+inline
+size_t LsmRegression::nBasis() const
+{
+  return parent_.size();
+}
+
+inline
+void LsmRegression::evalBasis()
+{
+  basis_[0] = 1.0;
+  for (size_t k = 1; k < parent_.size(); ++k)
+    basis_[k] = basis_[parent_[k]] * spots_[var_[k]] * scales_[var_[k]];
+}
+
+inline
+bool LsmRegression::exercises(Product& prod, size_t idx, double contValue)
+{
+  prod.eval(idx, spots_, contValue);
+  double value = prod.payAmounts()[idx];
+  return value > 0.0 && value > contValue;
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_LSMREGRESSION_HPP
@@ -1,62 +1,152 @@
-/**
-@file  mcparams.hpp
-@brief Monte Carlo parameters
-*/
-
-#ifndef ORF_MCPARAMS_HPP
-#define ORF_MCPARAMS_HPP
-
-#include <orflib/defines.hpp>
-#include <orflib/exception.hpp>
-
-BEGIN_NAMESPACE(orf)
-
-
-/** Monte Carlo parameters
-*/
-struct McParams
-{
-  /** The known URNG types */
-  enum class UrngType
-  {
-    MINSTDRAND,
-    MT19937,
-    RANLUX3,
-    RANLUX4,
-    SOBOL
-  };
-
-  /** The known path generator types */
-  enum class PathGenType
-  {
-    EULER
-  };
-
-  /** Control variate types */
-  enum class ControlVarType
-  {
-    NONE,
-    ANTITHETIC
-  };
-
-  /** Default ctor */
-  McParams(UrngType u = UrngType::MT19937, PathGenType p = PathGenType::EULER, 
-    ControlVarType c = ControlVarType::NONE);
-
-  // state
-  UrngType urngType;
-  PathGenType pathGenType;
-  ControlVarType controlVarType;
-};
-
-///////////////////////////////////////////////////////////////////////////////
-// Inline definitions
-
-inline
-McParams::McParams(UrngType u, PathGenType p, ControlVarType c)
-: urngType(u), pathGenType(p), controlVarType(c)
-{}
-
-END_NAMESPACE(orf)
-
-#endif // ORF_MCPARAMS_HPP
+/**
+@file  mcparams.hpp
+@brief Monte Carlo parameters
+*/
+
+#ifndef ORF_MCPARAMS_HPP
+#define ORF_MCPARAMS_HPP
+
+#include <orflib/defines.hpp>
+#include <orflib/exception.hpp>
+#include <cmath>
+
+BEGIN_NAMESPACE(orf)
+
+
+/** Monte Carlo parameters
+*/
+struct McParams
+{
+  /** The known URNG types.
+      STRATIFIED: stratifies the first component of each point over blocks of PATHBLOCKSIZE paths,
+      the terminal value with the BROWNIANBRIDGE path generator. With the EULER path generator the
+      first component is the first increment, so it needs a single time step.
+      LATINHYPERCUBE: stratifies all the components over blocks of PATHBLOCKSIZE paths.
+      The stratified paths of a block are not independent: the standard error from their sample
+      variance can overstate the actual one many times over, so the simulations to a target
+      error reject these two types.
+  */
+  enum class UrngType
+  {
+    MINSTDRAND,
+    MT19937,
+    RANLUX3,
+    RANLUX4,
+    SOBOL,
+    PHILOX,
+    STRATIFIED,
+    LATINHYPERCUBE
+  };
+
+  /** The known path generator types */
+  enum class PathGenType
+  {
+    EULER,
+    BROWNIANBRIDGE
+  };
+
+  /** Control variate types.
+      CONTROLVARIATE: regression-adjusted control variates priced in closed form,
+      with the coefficients estimated from the previous blocks of paths
+      CONDITIONAL: conditional Monte Carlo, the expected payoff over the last time step is
+      computed in closed form, which smooths digital payoffs; see Product::finalizeConditional()
+  */
+  enum class ControlVarType
+  {
+    NONE,
+    ANTITHETIC,
+    CONTROLVARIATE,
+    CONDITIONAL
+  };
+
+  /** The number of paths in each block of a block-partitioned simulation.
+      It must be even, so that antithetic pairs are not split across blocks.
+  */
+  enum { PATHBLOCKSIZE = 1024 };
+
+  /** Default ctor */
+  McParams(UrngType u = UrngType::MT19937, PathGenType p = PathGenType::EULER, 
+    ControlVarType c = ControlVarType::NONE, size_t nthreads = 0, unsigned long seed = 0,
+    bool greeks = false, unsigned long lsmpaths = 32 * PATHBLOCKSIZE);
+
+  /** Returns true if the paths of a block are stratified, with the STRATIFIED and LATINHYPERCUBE
+      urng types, so that their sample variance does not estimate the error of the mean
+  */
+  bool hasStratifiedPaths() const;
+
+  // state
+  UrngType urngType;
+  PathGenType pathGenType;
+  ControlVarType controlVarType;
+  size_t nThreads;        // 0: serial simulation on a single random stream;
+                          // n > 0: block-partitioned simulation on n worker threads, supported
+                          // by BsMcPricer only; the other pricers reject it
+  unsigned long seed;     // seeds the random streams of the block-partitioned simulation
+  bool computeGreeks;     // if true, the pricers that support it also estimate the Greeks
+  unsigned long nLsmPaths;  // the number of paths of the Longstaff-Schwartz regression, for
+                            // products with early exercise; they are simulated before the pricing paths
+};
+
+/** Stopping criteria of a simulation that runs until a target standard error.
+    The simulation stops at the end of the first block of paths where the standard error of the
+    mean is at most absTol, or at most relTol times the absolute mean, provided it has simulated
+    at least minPaths paths. Tolerances of zero are not used. It also stops after maxPaths paths,
+    or after the block where the time elapsed exceeds maxSeconds, if positive.
+*/
+struct McErrorTarget
+{
+  /** Initializing ctor */
+  explicit McErrorTarget(double absTol, double relTol = 0.0, unsigned long maxPaths = 10000000,
+    double maxSeconds = 0.0, unsigned long minPaths = 4 * McParams::PATHBLOCKSIZE);
+
+  /** Returns true if the simulation can stop, after npaths paths and the given number of seconds,
+      with the given mean and standard error. It does not check maxPaths.
+  */
+  bool isDone(double mean, double stdErr, unsigned long npaths, double seconds) const;
+
+  // state
+  double absTol;            // absolute tolerance on the standard error
+  double relTol;            // tolerance on the standard error relative to the mean
+  unsigned long maxPaths;   // the maximum number of paths
+  double maxSeconds;        // the maximum wall clock time, checked after each block
+  unsigned long minPaths;   // the minimum number of paths, for a reliable variance estimate
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+inline
+McParams::McParams(UrngType u, PathGenType p, ControlVarType c, size_t nthreads, unsigned long seed,
+  bool greeks, unsigned long lsmpaths)
+: urngType(u), pathGenType(p), controlVarType(c), nThreads(nthreads), seed(seed), computeGreeks(greeks),
+  nLsmPaths(lsmpaths)
+{}
+
+inline
+bool McParams::hasStratifiedPaths() const
+{
+  return urngType == UrngType::STRATIFIED || urngType == UrngType::LATINHYPERCUBE;
+}
+
+inline
+McErrorTarget::McErrorTarget(double absTol, double relTol, unsigned long maxPaths,
+  double maxSeconds, unsigned long minPaths)
+: absTol(absTol), relTol(relTol), maxPaths(maxPaths), maxSeconds(maxSeconds), minPaths(minPaths)
+{
+  ORF_ASSERT(absTol > 0.0 || relTol > 0.0, "McErrorTarget: need a positive absolute or relative tolerance!");
+  ORF_ASSERT(absTol >= 0.0 && relTol >= 0.0, "McErrorTarget: the tolerances must be non-negative!");
+}
+
+inline
+bool McErrorTarget::isDone(double mean, double stdErr, unsigned long npaths, double seconds) const
+{
+  if (maxSeconds > 0.0 && seconds > maxSeconds)
+    return true;
+  if (npaths < minPaths)
+    return false;
+  return (absTol > 0.0 && stdErr <= absTol) || (relTol > 0.0 && stdErr <= relTol * std::fabs(mean));
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_MCPARAMS_HPP
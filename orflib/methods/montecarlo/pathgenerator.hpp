@@ -1,76 +1,229 @@
-/**
-@file  pathgenerator.hpp
-@brief Base class for all Monte Carlo path generators
-*/
-
-#ifndef ORF_PATHGENERATOR_HPP
-#define ORF_PATHGENERATOR_HPP
-
-
-#include <orflib/defines.hpp>
-#include <orflib/exception.hpp>
-#include <orflib/sptr.hpp>
-#include <orflib/math/matrix.hpp>
-
-BEGIN_NAMESPACE(orf)
-
-/** The abstract base class for all Monte Carlo path generators.
-    It must be inherited by specific path generators.
-*/
-class PathGenerator
-{
-public:
-  /** Dtor */
-  virtual ~PathGenerator() {}
-
-  /** Returns the number of time steps */
-  size_t nTimeSteps() const;
-
-  /** Returns the number of simulated factors */
-  size_t nFactors() const;
-
-  /** Returns the next price path.
-      The Matrix is resized to size ntimesteps * nfactors
-  */
-  virtual void next(Matrix& pricePath) = 0;
-
-protected:
-  PathGenerator() {};     // default ctor
-  PathGenerator(size_t ntimesteps, size_t nfactors, Matrix const& correlation);
-
-  // Does spectral truncation and Cholesky decomposition on the correlation matrix
-  void initCorrelation(Matrix const& correlation);
-
-  size_t ntimesteps_;    // the number of time steps
-  size_t nfactors_;      // the number of factors
-  Matrix sqrtCorrel_;    // the Cholesky factor of the correlation matrix
-};
-
-using SPtrPathGenerator = std::shared_ptr<PathGenerator>;
-
-///////////////////////////////////////////////////////////////////////////////
-// Inline definitions
-inline
-PathGenerator::PathGenerator(size_t ntimesteps, size_t nfactors, Matrix const& correlMatrix)
-: ntimesteps_(ntimesteps), nfactors_(nfactors)
-{
-  ORF_ASSERT(correlMatrix.is_square(), "the correlation matrix is not square!");
-  if (!correlMatrix.is_empty())
-    ORF_ASSERT(correlMatrix.n_rows == nfactors,
-    "the correlation matrix number of rows is not equal to the number of factors!");
-  initCorrelation(correlMatrix);
-}
-
-inline size_t PathGenerator::nTimeSteps() const
-{
-  return ntimesteps_;
-}
-
-inline size_t PathGenerator::nFactors() const
-{
-  return nfactors_;
-}
-
-END_NAMESPACE(orf)
-
-#endif // ORF_PATHGENERATOR_HPP
+/**
+@file  pathgenerator.hpp
+@brief Base class for all Monte Carlo path generators
+*/
+
+#ifndef ORF_PATHGENERATOR_HPP
+#define ORF_PATHGENERATOR_HPP
+
+
+#include <orflib/defines.hpp>
+#include <orflib/exception.hpp>
+#include <orflib/sptr.hpp>
+#include <orflib/math/matrix.hpp>
+#include <vector>
+
+BEGIN_NAMESPACE(orf)
+
+/** The abstract base class for all Monte Carlo path generators.
+    It must be inherited by specific path generators.
+*/
+class PathGenerator
+{
+public:
+  /** Dtor */
+  virtual ~PathGenerator() {}
+
+  /** Returns the number of time steps */
+  size_t nTimeSteps() const;
+
+  /** Returns the number of simulated factors */
+  size_t nFactors() const;
+
+  /** Returns the next price path.
+      The Matrix is resized to size ntimesteps * nfactors
+  */
+  virtual void next(Matrix& pricePath) = 0;
+
+  /** Returns the next npaths price paths.
+      The Cube is resized to size npaths * nfactors * ntimesteps: slice i holds time step i,
+      with one row per path and one column per factor, so that for each time step and factor
+      the values of consecutive paths are contiguous.
+      The paths are the same as those returned by npaths successive calls to next().
+  */
+  virtual void nextBatch(size_t npaths, Cube& paths);
+
+  /** Starts the lazy generation of a batch of npaths paths, for evaluations that stop simulating
+      some paths before the last time step, e.g. knock-outs or early exercise.
+      The time steps of the batch are then returned in order by nextStep(), for the paths still
+      active only. The random stream is advanced as by nextBatch(), however many paths stop early,
+      so the following batches and the values of the active paths are those of nextBatch().
+      The default implementation generates the whole batch with nextBatch().
+  */
+  virtual void beginBatch(size_t npaths);
+
+  /** Writes time step i of the batch started by beginBatch() into devs, resized to one row per path
+      and one column per factor. Only the rows of the paths listed in active are meaningful, the other
+      rows hold unspecified values. The time steps must be requested in increasing order, and the ones
+      after the last active path stops need not be requested at all.
+  */
+  virtual void nextStep(size_t i, std::vector<size_t> const& active, Matrix& devs);
+
+  /** Positions the generator at the beginning of the random stream of a block of paths.
+      Used by the block-partitioned simulation, where the block blockIdx starts at the
+      global path index firstPath. The paths of a block depend only on (seed, blockIdx, firstPath),
+      so blocks can be generated in any order and on any thread.
+  */
+  virtual void setStream(unsigned long seed, size_t blockIdx, size_t firstPath);
+
+  /** Importance sampling: shifts the mean of the independent normal deviate of time step i and
+      factor j, before correlation, by shift(i, j), for ntimesteps rows and nfactors columns.
+      The paths then have to be weighted by their likelihood ratios, see logWeights().
+      An empty matrix removes the shift.
+      The default implementation throws, for path generators without importance sampling.
+  */
+  virtual void setDriftShift(Matrix const& shift);
+
+  /** Returns the drift shift of importance sampling, empty without it */
+  Matrix const& driftShift() const;
+
+  /** Returns the logs of the likelihood ratios of the paths last generated, one per path, with
+      importance sampling: the expectations of the payoffs are those of the payoffs times the
+      likelihood ratios under the shifted distribution. For a lazy batch they cover the time steps
+      generated so far.
+  */
+  Vector const& logWeights() const;
+
+  /** Returns the correlation matrix of the factors after spectral truncation,
+      i.e. the one actually simulated. It is the identity for independent factors.
+  */
+  Matrix correlation() const;
+
+  /** Returns the lower triangular Cholesky factor L of correlation(): the correlated deviates
+      of each time step are L times independent ones. It is empty for independent factors.
+  */
+  Matrix const& sqrtCorrelation() const;
+
+protected:
+  PathGenerator() {};     // default ctor
+  PathGenerator(size_t ntimesteps, size_t nfactors, Matrix const& correlation);
+
+  // Does spectral truncation and Cholesky decomposition on the correlation matrix
+  void initCorrelation(Matrix const& correlation);
+
+  /** Correlates the deviates of one path, of size ntimesteps * nfactors, in place.
+      It multiplies by the transposed Cholesky factor with a single dense (BLAS) product.
+      Does nothing for independent factors.
+  */
+  void correlate(Matrix& path);
+
+  /** Correlates the deviates of a batch of paths in place, one dense product per time step */
+  void correlate(Cube& paths);
+
+  size_t ntimesteps_;    // the number of time steps
+  size_t nfactors_;      // the number of factors
+  Matrix sqrtCorrel_;    // the Cholesky factor of the correlation matrix
+  Matrix batchPath_;     // scratch path used by the default nextBatch()
+  Matrix corrDevs_;      // scratch matrix for the correlated deviates
+  Cube lazyPaths_;       // the batch of the lazy generation, one slice per time step
+  Matrix shift_;         // the drift shift of importance sampling, empty without it
+  Vector logWeights_;    // the log likelihood ratios of the paths last generated, with importance sampling
+};
+
+using SPtrPathGenerator = std::shared_ptr<PathGenerator>;
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+inline
+PathGenerator::PathGenerator(size_t ntimesteps, size_t nfactors, Matrix const& correlMatrix)
+: ntimesteps_(ntimesteps), nfactors_(nfactors)
+{
+  ORF_ASSERT(correlMatrix.is_square(), "the correlation matrix is not square!");
+  if (!correlMatrix.is_empty())
+    ORF_ASSERT(correlMatrix.n_rows == nfactors,
+    "the correlation matrix number of rows is not equal to the number of factors!");
+  initCorrelation(correlMatrix);
+}
+
+inline void PathGenerator::nextBatch(size_t npaths, Cube& paths)
+{
+  paths.set_size(npaths, nfactors_, ntimesteps_);
+  for (size_t p = 0; p < npaths; ++p) {
+    next(batchPath_);
+    for (size_t i = 0; i < ntimesteps_; ++i)
+      for (size_t j = 0; j < nfactors_; ++j)
+        paths(p, j, i) = batchPath_(i, j);
+  }
+}
+
+inline void PathGenerator::beginBatch(size_t npaths)
+{
+  nextBatch(npaths, lazyPaths_);
+}
+
+inline void PathGenerator::nextStep(size_t i, std::vector<size_t> const& active, Matrix& devs)
+{
+  devs.set_size(lazyPaths_.n_rows, nfactors_);
+  for (size_t j = 0; j < nfactors_; ++j) {
+    double const* src = lazyPaths_.slice_colptr(i, j);
+    double* dst = devs.colptr(j);
+    for (size_t p : active)
+      dst[p] = src[p];
+  }
+}
+
+inline void PathGenerator::correlate(Matrix& path)
+{
+  if (sqrtCorrel_.n_rows == 0)
+    return;
+  corrDevs_ = path * sqrtCorrel_.t();
+  path = corrDevs_;
+}
+
+inline void PathGenerator::correlate(Cube& paths)
+{
+  if (sqrtCorrel_.n_rows == 0)
+    return;
+  for (size_t i = 0; i < paths.n_slices; ++i) {
+    // a view on the memory of the slice, Cube::slice() would allocate a matrix header
+    Matrix devs(paths.slice_memptr(i), paths.n_rows, paths.n_cols, false, true);
+    corrDevs_ = devs * sqrtCorrel_.t();
+    devs = corrDevs_;
+  }
+}
+
+inline void PathGenerator::setStream(unsigned long seed, size_t blockIdx, size_t firstPath)
+{
+  ORF_ASSERT(0, "this path generator does not support block-partitioned simulation!");
+}
+
+inline void PathGenerator::setDriftShift(Matrix const& shift)
+{
+  ORF_ASSERT(0, "this path generator does not support importance sampling!");
+}
+
+inline Matrix const& PathGenerator::driftShift() const
+{
+  return shift_;
+}
+
+inline Vector const& PathGenerator::logWeights() const
+{
+  return logWeights_;
+}
+
+inline Matrix PathGenerator::correlation() const
+{
+  if (sqrtCorrel_.n_rows == 0)
+    return arma::eye<Matrix>(nfactors_, nfactors_);
+  return sqrtCorrel_ * sqrtCorrel_.t();
+}
+
+inline Matrix const& PathGenerator::sqrtCorrelation() const
+{
+  return sqrtCorrel_;
+}
+
+inline size_t PathGenerator::nTimeSteps() const
+{
+  return ntimesteps_;
+}
+
+inline size_t PathGenerator::nFactors() const
+{
+  return nfactors_;
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_PATHGENERATOR_HPP
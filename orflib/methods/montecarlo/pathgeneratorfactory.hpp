@@ -0,0 +1,78 @@
+/**
+@file  pathgeneratorfactory.hpp
+@brief Creation of path generators from the Monte Carlo parameters
+*/
+
+#ifndef ORF_PATHGENERATORFACTORY_HPP
+#define ORF_PATHGENERATORFACTORY_HPP
+
+#include <orflib/methods/montecarlo/mcparams.hpp>
+#include <orflib/methods/montecarlo/eulerpathgenerator.hpp>
+#include <orflib/methods/montecarlo/brownianbridgepathgenerator.hpp>
+#include <iterator>
+
+BEGIN_NAMESPACE(orf)
+
+/** Creates a path generator of type PATHGEN, driven by the normal rng selected by urngType */
+template <template <typename> class PATHGEN, typename ITER>
+SPtrPathGenerator createPathGenerator(McParams::UrngType urngType,
+                                      ITER timestepsBegin, ITER timestepsEnd, size_t nfactors,
+                                      Matrix const& correlMat = Matrix())
+{
+  if (urngType == McParams::UrngType::MINSTDRAND)
+    return SPtrPathGenerator(new PATHGEN<NormalRngMinStdRand>(
+      timestepsBegin, timestepsEnd, nfactors, correlMat));
+  else if (urngType == McParams::UrngType::MT19937)
+    return SPtrPathGenerator(new PATHGEN<NormalRngMt19937>(
+      timestepsBegin, timestepsEnd, nfactors, correlMat));
+  else if (urngType == McParams::UrngType::RANLUX3)
+    return SPtrPathGenerator(new PATHGEN<NormalRngRanLux3>(
+      timestepsBegin, timestepsEnd, nfactors, correlMat));
+  else if (urngType == McParams::UrngType::RANLUX4)
+    return SPtrPathGenerator(new PATHGEN<NormalRngRanLux4>(
+      timestepsBegin, timestepsEnd, nfactors, correlMat));
+  else if (urngType == McParams::UrngType::SOBOL)
+    return SPtrPathGenerator(new PATHGEN<NormalRngSobol>(
+      timestepsBegin, timestepsEnd, nfactors, correlMat));
+  else if (urngType == McParams::UrngType::PHILOX)
+    return SPtrPathGenerator(new PATHGEN<NormalRngPhilox>(
+      timestepsBegin, timestepsEnd, nfactors, correlMat));
+  else if (urngType == McParams::UrngType::STRATIFIED)
+    return SPtrPathGenerator(new PATHGEN<NormalRngStratified>(
+      timestepsBegin, timestepsEnd, nfactors, correlMat));
+  else if (urngType == McParams::UrngType::LATINHYPERCUBE)
+    return SPtrPathGenerator(new PATHGEN<NormalRngLatinHypercube>(
+      timestepsBegin, timestepsEnd, nfactors, correlMat));
+  else
+    ORF_ASSERT(0, "unknown urng type!");
+  return SPtrPathGenerator();
+}
+
+/** Creates the path generator selected by the Monte Carlo parameters.
+    It does not apply the variance reduction, which is up to the caller.
+    The STRATIFIED urng needs the BROWNIANBRIDGE path generator for more than one time step.
+*/
+template <typename ITER>
+SPtrPathGenerator createPathGenerator(McParams const& mcparams,
+                                      ITER timestepsBegin, ITER timestepsEnd, size_t nfactors,
+                                      Matrix const& correlMat = Matrix())
+{
+  // Euler paths would stratify the first increment, not the terminal value
+  ORF_ASSERT(mcparams.urngType != McParams::UrngType::STRATIFIED
+             || mcparams.pathGenType != McParams::PathGenType::EULER
+             || std::distance(timestepsBegin, timestepsEnd) <= 1,
+    "the STRATIFIED urng needs the BROWNIANBRIDGE path generator for more than one time step!");
+  if (mcparams.pathGenType == McParams::PathGenType::EULER)
+    return createPathGenerator<EulerPathGenerator>(mcparams.urngType,
+      timestepsBegin, timestepsEnd, nfactors, correlMat);
+  else if (mcparams.pathGenType == McParams::PathGenType::BROWNIANBRIDGE)
+    return createPathGenerator<BrownianBridgePathGenerator>(mcparams.urngType,
+      timestepsBegin, timestepsEnd, nfactors, correlMat);
+  else
+    ORF_ASSERT(0, "unknown path generator type!");
+  return SPtrPathGenerator();
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_PATHGENERATORFACTORY_HPP
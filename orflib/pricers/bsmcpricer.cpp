@@ -1,103 +1,415 @@
-/**
-@file  bsmcpricer.cpp
-@brief Implementation of the BsMcPricer class
-*/
-
-#include <orflib/pricers/bsmcpricer.hpp>
-#include <orflib/methods/montecarlo/eulerpathgenerator.hpp>
-#include <orflib/methods/montecarlo/antitheticpathgenerator.hpp>
-
-#include <cmath>
-
-using namespace std;
-
-BEGIN_NAMESPACE(orf)
-
-BsMcPricer::BsMcPricer(SPtrProduct prod,
-                       SPtrYieldCurve discountCurve,
-                       double divYield,
-                       SPtrVolatilityTermStructure volatility,
-                       double spot,
-                       McParams mcparams)
-: prod_(prod), discyc_(discountCurve), divyld_(divYield), vol_(volatility),
-spot_(spot), mcparams_(mcparams)
-{
-  // Get the simulation times
-  Vector timesteps = prod->fixTimes();
-  size_t ntimesteps = timesteps.size();
-
-  // Create the path generator, one factor to simulate the spot
-  if (mcparams.pathGenType == McParams::PathGenType::EULER) {
-    if (mcparams.urngType == McParams::UrngType::MINSTDRAND)
-      pathgen_ = SPtrPathGenerator(new EulerPathGenerator<NormalRngMinStdRand>(
-          timesteps.begin(), timesteps.end(), 1));
-    else if (mcparams.urngType == McParams::UrngType::MT19937)
-      pathgen_ = SPtrPathGenerator(new EulerPathGenerator<NormalRngMt19937>(
-          timesteps.begin(), timesteps.end(), 1));
-    else if (mcparams.urngType == McParams::UrngType::RANLUX3)
-      pathgen_ = SPtrPathGenerator(new EulerPathGenerator<NormalRngRanLux3>(
-          timesteps.begin(), timesteps.end(), 1));
-    else if (mcparams.urngType == McParams::UrngType::RANLUX4)
-      pathgen_ = SPtrPathGenerator(new EulerPathGenerator<NormalRngRanLux4>(
-          timesteps.begin(), timesteps.end(), 1));
-    else if (mcparams.urngType == McParams::UrngType::SOBOL)
-      pathgen_ = SPtrPathGenerator(new EulerPathGenerator<NormalRngSobol>(
-          timesteps.begin(), timesteps.end(), 1));
-    else
-      ORF_ASSERT(0, "unknown urng type!");
-  } 
-  else
-    ORF_ASSERT(0, "unknown path generator type!");
-  if (mcparams.controlVarType == McParams::ControlVarType::ANTITHETIC) {
-    pathgen_ = SPtrPathGenerator(new AntitheticPathGenerator(pathgen_));
-  }
-
-  // Pre-compute the discount factors
-  Vector const& paytimes = prod->payTimes();
-  discfactors_.resize(paytimes.size());
-  for (size_t i = 0; i < paytimes.size(); ++i)
-    discfactors_[i] = discyc_->discount(paytimes[i]);
-
-  // Pre-compute the stdevs and drifts from time step to time step
-  Vector const& fixtimes = prod->fixTimes();
-  double t1 = 0.0;
-  drifts_.resize(fixtimes.size());
-  stdevs_.resize(fixtimes.size());
-  for (size_t i = 0; i < fixtimes.size(); ++i) {
-    double t2 = fixtimes[i];
-    double fwdvol = vol_->fwdVol(t1, t2);
-    double var = fwdvol * fwdvol * (t2 - t1);
-    stdevs_[i] = sqrt(var);
-    double fwdrate = discyc_->fwdRate(t1, t2);
-    // risk free rate less yield plus convexity adjustment
-    drifts_[i] = (fwdrate - divyld_) * (t2 - t1) - 0.5 * var;
-    t1 = t2;
-  }
-
-  // Resize the payment amounts
-  payamts_.resize(prod->payTimes().size());
-
-}
-
-
-double BsMcPricer::processOnePath(Matrix& pricePath)
-{
-  pathgen_->next(pricePath);
-  // convert the normal deviates to a price path in-place
-  double spot = spot_;
-  for (size_t i = 0; i < pricePath.n_rows; ++i) {
-    double normaldeviate = pricePath(i, 0);
-    pricePath(i, 0) = spot * exp(drifts_[i] + stdevs_[i] * normaldeviate);
-    spot = pricePath(i, 0);
-  }
-  prod_->eval(pricePath);
-  payamts_ = prod_->payAmounts();
-
-  double pv = 0.0;
-  for (size_t i = 0; i < payamts_.size(); ++i)
-    pv += discfactors_[i] * payamts_[i];
-
-  return pv;
-}
-
-END_NAMESPACE(orf)
+/**
+@file  bsmcpricer.cpp
+@brief Implementation of the BsMcPricer class
+*/
+
+#include <orflib/pricers/bsmcpricer.hpp>
+#include <orflib/methods/montecarlo/pathgeneratorfactory.hpp>
+#include <orflib/methods/montecarlo/antitheticpathgenerator.hpp>
+#include <orflib/pricers/simplepricers.hpp>
+
+#include <cmath>
+#include <exception>
+#include <numeric>
+#include <thread>
+
+using namespace std;
+
+BEGIN_NAMESPACE(orf)
+
+// bump sizes of the Greeks computed by differences on the same path
+static const double DELTABUMP = 1.0e-4;   // relative bump of the initial spot
+static const double VEGABUMP = 1.0e-4;    // absolute bump of the forward volatilities
+// degree of the polynomials in the spot of the Longstaff-Schwartz regression
+static const size_t LSMDEGREE = 3;
+
+BsMcPricer::BsMcPricer(SPtrProduct prod,
+                       SPtrYieldCurve discountCurve,
+                       double divYield,
+                       SPtrVolatilityTermStructure volatility,
+                       double spot,
+                       McParams mcparams)
+: prod_(prod), discyc_(discountCurve), divyld_(divYield), vol_(volatility),
+spot_(spot), mcparams_(mcparams)
+{
+  // Get the simulation times
+  Vector timesteps = prod->fixTimes();
+  size_t ntimesteps = timesteps.size();
+
+  // Create the path generator, one factor to simulate the spot
+  pathgen_ = createPathGenerator(mcparams, timesteps.begin(), timesteps.end(), 1);
+  if (mcparams.controlVarType == McParams::ControlVarType::ANTITHETIC) {
+    pathgen_ = SPtrPathGenerator(new AntitheticPathGenerator(pathgen_));
+  }
+
+  // Pre-compute the discount factors
+  Vector const& paytimes = prod->payTimes();
+  discfactors_.resize(paytimes.size());
+  for (size_t i = 0; i < paytimes.size(); ++i)
+    discfactors_[i] = discyc_->discount(paytimes[i]);
+
+  // Pre-compute the stdevs and drifts from time step to time step
+  Vector const& fixtimes = prod->fixTimes();
+  double t1 = 0.0;
+  drifts_.resize(fixtimes.size());
+  stdevs_.resize(fixtimes.size());
+  for (size_t i = 0; i < fixtimes.size(); ++i) {
+    double t2 = fixtimes[i];
+    double fwdvol = vol_->fwdVol(t1, t2);
+    double var = fwdvol * fwdvol * (t2 - t1);
+    stdevs_[i] = sqrt(var);
+    double fwdrate = t2 > t1 ? discyc_->fwdRate(t1, t2) : 0.0;  // e.g. a fixing at time 0
+    // risk free rate less yield plus convexity adjustment
+    drifts_[i] = (fwdrate - divyld_) * (t2 - t1) - 0.5 * var;
+    t1 = t2;
+  }
+
+  // Products with early exercise pay at the exercise (fixing) times
+  if (prod->hasEarlyExercise()) {
+    ORF_ASSERT(paytimes.size() == ntimesteps, "early exercise needs one payment time per fixing time!");
+    ORF_ASSERT(mcparams.nLsmPaths > 0, "early exercise needs paths for the Longstaff-Schwartz regression!");
+    ORF_ASSERT(!mcparams.computeGreeks, "the Greeks do not support early exercise!");
+    lsm_ = make_shared<LsmRegression>(Vector(1, arma::fill::value(spot_)), LSMDEGREE);
+  }
+
+  // The Greeks need the score of the first increment, and the time steps for vega
+  if (mcparams.computeGreeks) {
+    ORF_ASSERT(stdevs_[0] > 0.0, "the Greeks need a positive first fixing time and volatility!");
+    sqrtdts_.resize(ntimesteps);
+    for (size_t i = 0; i < ntimesteps; ++i)
+      sqrtdts_[i] = sqrt(fixtimes[i] - (i > 0 ? fixtimes[i - 1] : 0.0));
+  }
+
+  // Conditional Monte Carlo integrates the last time step of the streamed paths in closed form
+  if (mcparams.controlVarType == McParams::ControlVarType::CONDITIONAL) {
+    ORF_ASSERT(prod->hasConditionalPayoff(), "the product does not support conditional Monte Carlo!");
+    ORF_ASSERT(!prod->hasEarlyExercise() && !mcparams.computeGreeks,
+      "conditional Monte Carlo does not support early exercise or the Greeks!");
+    condloadings_ = Vector(1, arma::fill::value(stdevs_[ntimesteps - 1]));
+  }
+
+  // Set up the control variates and their expectations, all paid at the last fixing time
+  if (mcparams.controlVarType == McParams::ControlVarType::CONTROLVARIATE) {
+    double T = fixtimes[ntimesteps - 1];
+    double vol = vol_->fwdVol(0.0, T);
+    ORF_ASSERT(T > 0.0 && vol > 0.0, "control variates need a positive last fixing time and volatility!");
+    cvDiscount_ = discyc_->discount(T);
+    double rate = -log(cvDiscount_) / T;
+    cvStrike_ = fwdPrice(spot_, T, rate, divyld_);
+    Vector means(ntimesteps > 1 ? 3 : 2);
+    means[0] = cvDiscount_ * cvStrike_;
+    means[1] = europeanOptionBS(1, spot_, cvStrike_, T, rate, divyld_, vol)[0];
+    if (ntimesteps > 1) {
+      // lognormal geometric average of the spots relative to the initial spot
+      double mean, var;
+      geometricAverageMoments(drifts_, stdevs_, Matrix(1, 1, arma::fill::ones), mean, var);
+      cvGeoStrike_ = exp(mean + 0.5 * var);
+      means[2] = europeanOptionBS(1, cvGeoStrike_, cvGeoStrike_, T, rate, rate, sqrt(var / T))[0];
+    }
+    cv_ = make_shared<ControlVariate>(means);
+  }
+}
+
+void BsMcPricer::generatePaths(size_t npaths)
+{
+  pathgen_->nextBatch(npaths, paths_);
+  // keep the standard normal increments for the Greeks
+  if (mcparams_.computeGreeks)
+    devs_ = paths_;
+  // convert the normal deviates to price paths in-place, one time step at a time
+  for (size_t i = 0; i < paths_.n_slices; ++i) {
+    double* spots = paths_.slice_colptr(i, 0);
+    double const* prevspots = i > 0 ? paths_.slice_colptr(i - 1, 0) : nullptr;
+    double drift = drifts_[i];
+    double stdev = stdevs_[i];
+    for (size_t p = 0; p < npaths; ++p) {
+      double spot = i > 0 ? prevspots[p] : spot_;
+      spots[p] = spot * exp(drift + stdev * spots[p]);
+    }
+  }
+}
+
+void BsMcPricer::streamPaths(size_t npaths)
+{
+  prod_->resetState(npaths, states_);
+  currspots_.set_size(npaths, 1);
+  double* spots = currspots_.colptr(0);
+  fill(spots, spots + npaths, spot_);
+  size_t nsteps = prod_->fixTimes().size();
+  // conditional Monte Carlo does not simulate the deviates of the last time step
+  bool conditional = !condloadings_.is_empty();
+  size_t nstream = conditional ? nsteps - 1 : nsteps;
+  if (prod_->hasEarlyTermination() || conditional) {
+    // move only the paths not yet decided by the product to the next time step
+    pathgen_->beginBatch(npaths);
+    active_.resize(npaths);
+    iota(active_.begin(), active_.end(), size_t(0));
+    for (size_t i = 0; i < nstream && !active_.empty(); ++i) {
+      pathgen_->nextStep(i, active_, stepdevs_);
+      double const* devs = stepdevs_.colptr(0);
+      double drift = drifts_[i];
+      double stdev = stdevs_[i];
+      for (size_t p : active_)
+        spots[p] = spots[p] * exp(drift + stdev * devs[p]);
+      prod_->updateState(i, currspots_, states_);
+      prod_->updateActive(i, states_, active_);
+    }
+  }
+  else {
+    pathgen_->nextBatch(npaths, paths_);
+    // move the spots to each time step, and pass them on to the product
+    for (size_t i = 0; i < nsteps; ++i) {
+      double const* devs = paths_.slice_colptr(i, 0);
+      double drift = drifts_[i];
+      double stdev = stdevs_[i];
+      for (size_t p = 0; p < npaths; ++p)
+        spots[p] = spots[p] * exp(drift + stdev * devs[p]);
+      prod_->updateState(i, currspots_, states_);
+    }
+  }
+  if (!conditional) {
+    prod_->finalizeState(states_, payamts_);
+    return;
+  }
+  // the spots at the last time step are these times exp(stdev * Z), with Z integrated by the product
+  // of the active paths; the others, decided by the product, keep the spots of their last time step
+  double growth = exp(drifts_[nsteps - 1]);
+  for (size_t p : active_)
+    spots[p] *= growth;
+  prod_->finalizeConditional(states_, currspots_, condloadings_, payamts_);
+}
+
+void BsMcPricer::exercisePaths(size_t npaths, double* pvs)
+{
+  pathgen_->beginBatch(npaths);
+  active_.resize(npaths);
+  iota(active_.begin(), active_.end(), size_t(0));
+  currspots_.set_size(npaths, 1);
+  double* spots = currspots_.colptr(0);
+  fill(spots, spots + npaths, spot_);
+  // all the paths still active are exercised at the last time step
+  for (size_t i = 0; !active_.empty(); ++i) {
+    pathgen_->nextStep(i, active_, stepdevs_);
+    double const* devs = stepdevs_.colptr(0);
+    double drift = drifts_[i];
+    double stdev = stdevs_[i];
+    for (size_t p : active_)
+      spots[p] = spots[p] * exp(drift + stdev * devs[p]);
+    size_t nactive = 0;
+    for (size_t p : active_)
+      if (!lsm_->exerciseStep(*prod_, i, currspots_, p, discfactors_, pvs[p]))
+        active_[nactive++] = p;
+    active_.resize(nactive);
+  }
+}
+
+void BsMcPricer::processPaths(size_t npaths, Matrix& samples, size_t firstRow)
+{
+  double* pvs = samples.colptr(0) + firstRow;
+  // products without early exercise are evaluated on the whole batch,
+  // streaming the time steps unless the control variates need the price paths
+  if (!lsm_ && !mcparams_.computeGreeks) {
+    if (cv_) {
+      generatePaths(npaths);
+      prod_->evalBatch(paths_, payamts_);
+    }
+    else {
+      streamPaths(npaths);
+    }
+    batchPVs(npaths, pvs);
+    return;
+  }
+
+  // products with early exercise stop their paths at the exercise time,
+  // unless the Greeks or the control variates need the whole price paths
+  if (!mcparams_.computeGreeks && !cv_) {
+    exercisePaths(npaths, pvs);
+    return;
+  }
+
+  generatePaths(npaths);
+
+  // evaluate the product on each path
+  pricePath_.set_size(paths_.n_slices, 1);
+  for (size_t p = 0; p < npaths; ++p) {
+    for (size_t i = 0; i < paths_.n_slices; ++i)
+      pricePath_(i, 0) = paths_(p, 0, i);
+    pvs[p] = pathPV(pricePath_);
+    if (mcparams_.computeGreeks)
+      pathGreeks(p, pvs[p], samples, firstRow + p);
+  }
+}
+
+double BsMcPricer::pathPV(Matrix const& pricePath)
+{
+  if (lsm_)
+    return lsm_->exercisePV(*prod_, pricePath, discfactors_);
+  prod_->eval(pricePath);
+  Vector const& payamts = prod_->payAmounts();
+  double pv = 0.0;
+  for (size_t k = 0; k < payamts.size(); ++k)
+    pv += discfactors_[k] * payamts[k];
+  return pv;
+}
+
+void BsMcPricer::batchPVs(size_t npaths, double* pvs) const
+{
+  for (size_t p = 0; p < npaths; ++p)
+    pvs[p] = 0.0;
+  for (size_t k = 0; k < payamts_.n_cols; ++k) {
+    double const* payamts = payamts_.colptr(k);
+    double df = discfactors_[k];
+    for (size_t p = 0; p < npaths; ++p)
+      pvs[p] += df * payamts[p];
+  }
+}
+
+void BsMcPricer::pathGreeks(size_t p, double pv, Matrix& samples, size_t row)
+{
+  size_t nsteps = pricePath_.n_rows;
+  // likelihood ratio score of the initial spot, which only enters the first increment
+  double z0 = devs_(p, 0, 0);
+  double score = z0 / (spot_ * stdevs_[0]);
+  double delta, gamma, vega;
+
+  if (prod_->isLipschitz()) {
+    // pathwise delta: all the fixings scale with the initial spot
+    bumpPath_ = pricePath_ * (1.0 + DELTABUMP);
+    double pvup = pathPV(bumpPath_);
+    bumpPath_ = pricePath_ * (1.0 - DELTABUMP);
+    double pvdown = pathPV(bumpPath_);
+    delta = (pvup - pvdown) / (2.0 * DELTABUMP * spot_);
+    // gamma: likelihood ratio derivative of the pathwise delta, which is homogeneous of degree -1
+    gamma = delta * (score - 1.0 / spot_);
+    // pathwise vega: the same increments with all forward vols shifted up and down
+    vegaBumpedPath(p, VEGABUMP);
+    pvup = pathPV(bumpPath_);
+    vegaBumpedPath(p, -VEGABUMP);
+    pvdown = pathPV(bumpPath_);
+    vega = (pvup - pvdown) / (2.0 * VEGABUMP);
+  }
+  else {
+    // likelihood ratio weights, with the log-normal density of the increments
+    double s0 = stdevs_[0];
+    delta = pv * score;
+    gamma = pv * (z0 * z0 - 1.0 - z0 * s0) / (spot_ * spot_ * s0 * s0);
+    double vegascore = 0.0;
+    for (size_t i = 0; i < nsteps; ++i) {
+      if (stdevs_[i] > 0.0) {
+        double z = devs_(p, 0, i);
+        vegascore += ((z * z - 1.0) / stdevs_[i] - z) * sqrtdts_[i];
+      }
+    }
+    vega = pv * vegascore;
+  }
+  samples(row, 1) = delta;
+  samples(row, 2) = gamma;
+  samples(row, 3) = vega;
+}
+
+void BsMcPricer::vegaBumpedPath(size_t p, double volBump)
+{
+  bumpPath_.set_size(pricePath_.n_rows, 1);
+  double logshift = 0.0;
+  for (size_t i = 0; i < pricePath_.n_rows; ++i) {
+    double dt = sqrtdts_[i] * sqrtdts_[i];
+    // change of the log increment when the forward vol s becomes s + volBump
+    logshift += volBump * sqrtdts_[i] * (devs_(p, 0, i) - stdevs_[i]) - 0.5 * volBump * volBump * dt;
+    bumpPath_(i, 0) = pricePath_(i, 0) * exp(logshift);
+  }
+}
+
+void BsMcPricer::computeControls(size_t npaths, Matrix& controls, size_t firstRow)
+{
+  size_t nsteps = paths_.n_slices;
+  double const* spots = paths_.slice_colptr(nsteps - 1, 0);
+  double* discspots = controls.colptr(0) + firstRow;
+  double* calls = controls.colptr(1) + firstRow;
+  for (size_t p = 0; p < npaths; ++p) {
+    discspots[p] = cvDiscount_ * spots[p];
+    calls[p] = cvDiscount_ * max(spots[p] - cvStrike_, 0.0);
+  }
+  if (controls.n_cols < 3)
+    return;
+  // geometric average call, accumulating the logs of the spots
+  double* geocalls = controls.colptr(2) + firstRow;
+  fill(geocalls, geocalls + npaths, 0.0);
+  for (size_t i = 0; i < nsteps; ++i) {
+    double const* fixings = paths_.slice_colptr(i, 0);
+    for (size_t p = 0; p < npaths; ++p)
+      geocalls[p] += log(fixings[p]);
+  }
+  double wgt = 1.0 / nsteps;
+  double logspot = log(spot_);
+  for (size_t p = 0; p < npaths; ++p) {
+    double geoavg = exp(wgt * geocalls[p] - logspot);
+    geocalls[p] = cvDiscount_ * max(geoavg - cvGeoStrike_, 0.0);
+  }
+}
+
+void BsMcPricer::calibrateExercise(unsigned long npaths)
+{
+  size_t blocksize = McParams::PATHBLOCKSIZE;
+  // in the block-partitioned simulation, continue with the blocks after the pricing ones
+  if (mcparams_.nThreads > 0) {
+    size_t nblocks = (npaths + blocksize - 1) / blocksize;
+    pathgen_->setStream(mcparams_.seed, nblocks, nblocks * blocksize);
+  }
+  size_t nlsmpaths = mcparams_.nLsmPaths;
+  Cube lsmpaths(nlsmpaths, 1, prod_->fixTimes().size());
+  for (size_t k = 0; k < nlsmpaths; k += blocksize) {
+    size_t n = min(blocksize, nlsmpaths - k);
+    generatePaths(n);
+    lsmpaths.subcube(k, 0, 0, k + n - 1, 0, paths_.n_slices - 1) = paths_;
+  }
+  lsm_->calibrate(*prod_, lsmpaths, discfactors_);
+}
+
+void BsMcPricer::simulateBlocks(size_t firstBlock, size_t nBlocks, unsigned long npaths,
+                                Matrix& samples, Matrix& controls)
+{
+  size_t blocksize = McParams::PATHBLOCKSIZE;
+  size_t firstpath = firstBlock * blocksize;
+  size_t endpath = min<size_t>(npaths, (firstBlock + nBlocks) * blocksize);
+  samples.set_size(endpath - firstpath, nVariables());
+  if (cv_)
+    controls.set_size(endpath - firstpath, cv_->nControls());
+
+  // create the workers on first use; each one has its own product copy and path generator
+  size_t nworkers = min(mcparams_.nThreads, nBlocks);
+  while (workers_.size() < nworkers)
+    workers_.push_back(make_shared<BsMcPricer>(prod_->clone(), discyc_, divyld_, vol_, spot_, mcparams_));
+  // the workers follow the exercise policy estimated by this pricer
+  if (lsm_)
+    for (size_t w = 0; w < nworkers; ++w)
+      *workers_[w]->lsm_ = *lsm_;
+
+  // worker w simulates the blocks w, w + nworkers, w + 2*nworkers, ...
+  vector<exception_ptr> errors(nworkers);
+  vector<thread> threads;
+  for (size_t w = 0; w < nworkers; ++w) {
+    threads.emplace_back([&, w]() {
+      try {
+        BsMcPricer& worker = *workers_[w];
+        for (size_t b = w; b < nBlocks; b += nworkers) {
+          size_t begin = (firstBlock + b) * blocksize;
+          size_t end = min(begin + blocksize, endpath);
+          worker.pathgen_->setStream(mcparams_.seed, firstBlock + b, begin);
+          worker.processPaths(end - begin, samples, begin - firstpath);
+          if (cv_)
+            worker.computeControls(end - begin, controls, begin - firstpath);
+        }
+      }
+      catch (...) {
+        errors[w] = current_exception();
+      }
+    });
+  }
+  for (size_t w = 0; w < nworkers; ++w)
+    threads[w].join();
+  for (size_t w = 0; w < nworkers; ++w)
+    if (errors[w])
+      rethrow_exception(errors[w]);
+}
+
+END_NAMESPACE(orf)
@@ -1,88 +1,267 @@
-/**
-@file  bsmcpricer.hpp
-@brief Monte Carlo pricer in the Black Scholes model
-*/
-
-#ifndef ORF_BSMCPRICER_HPP
-#define ORF_BSMCPRICER_HPP
-
-#include <orflib/products/product.hpp>
-#include <orflib/market/yieldcurve.hpp>
-#include <orflib/market/volatilitytermstructure.hpp>
-#include <orflib/methods/montecarlo/mcparams.hpp>
-#include <orflib/methods/montecarlo/pathgenerator.hpp>
-#include <orflib/methods/montecarlo/eulerpathgenerator.hpp>
-#include <orflib/math/stats/statisticscalculator.hpp>
-
-BEGIN_NAMESPACE(orf)
-
-/** Monte Carlo pricer in the Black-Scholes model (deterministic rates and vols).
-*/
-class BsMcPricer
-{
-public:
-  /** Initializing ctor */
-  BsMcPricer(SPtrProduct prod,
-             SPtrYieldCurve discountYieldCurve,
-             double divYield,
-             SPtrVolatilityTermStructure volatility,
-             double spot,
-             McParams mcparams);
-
-  /** Returns the number of variables that can be tracked for stats */
-  size_t nVariables();
-
-  /** Runs the simulation and collects statistics */
-  template<typename ITER>
-  void simulate(StatisticsCalculator<ITER>& statsCalc, unsigned long npaths);
-
-protected:
-
-  /** Creates and processes one price path.
-      It returns the PV of the product
-      */
-  double processOnePath(Matrix& pricePath);
-
-private:
-  SPtrProduct prod_;      // pointer to the product
-  SPtrYieldCurve discyc_; // pointer to the discount curve
-  double divyld_;         // the constant dividend yield   
-  SPtrVolatilityTermStructure vol_;            // the volatility term structure
-  double spot_;           // the initial spot
-  McParams mcparams_;     // the Monte Carlo parameters
-
-  SPtrPathGenerator pathgen_;  // pointer to the path generator
-  Vector discfactors_;         // caches the pre-computed discount factors
-  Vector drifts_;              // caches the pre-computed asset drifts
-  Vector stdevs_;              // caches the pre-computed standard deviations 
-
-  Vector payamts_;             // scratch array for writing the payments after each simulation
-};
-
-///////////////////////////////////////////////////////////////////////////////
-// Inline definitions
-
-inline
-size_t BsMcPricer::nVariables()
-{
-  return 1;
-}
-
-template<typename ITER>
-void BsMcPricer::simulate(StatisticsCalculator<ITER>& statsCalc, unsigned long npaths)
-{
-  // create the price path matrix
-  Matrix pricePath(pathgen_->nTimeSteps(), pathgen_->nFactors());
-  // check the size of the statistics calcuilator
-  ORF_ASSERT(statsCalc.nVariables() == nVariables(), "the statistics calculator must track only one variable!");
-
-  // This is the HOT loop
-  for (unsigned long i = 0; i < npaths; ++i) {
-    double pv = processOnePath(pricePath);
-    statsCalc.addSample(&pv, &pv + 1);
-  }
-}
-
-END_NAMESPACE(orf)
-
-#endif // ORF_PRODUCT_HPP
+/**
+@file  bsmcpricer.hpp
+@brief Monte Carlo pricer in the Black Scholes model
+*/
+
+#ifndef ORF_BSMCPRICER_HPP
+#define ORF_BSMCPRICER_HPP
+
+#include <orflib/products/product.hpp>
+#include <orflib/market/yieldcurve.hpp>
+#include <orflib/market/volatilitytermstructure.hpp>
+#include <orflib/methods/montecarlo/mcparams.hpp>
+#include <orflib/methods/montecarlo/pathgenerator.hpp>
+#include <orflib/methods/montecarlo/eulerpathgenerator.hpp>
+#include <orflib/methods/montecarlo/controlvariate.hpp>
+#include <orflib/methods/montecarlo/lsmregression.hpp>
+#include <orflib/math/stats/statisticscalculator.hpp>
+#include <orflib/math/stats/meanvarcalculator.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+BEGIN_NAMESPACE(orf)
+
+/** Monte Carlo pricer in the Black-Scholes model (deterministic rates and vols).
+*/
+class BsMcPricer
+{
+public:
+  /** Initializing ctor */
+  BsMcPricer(SPtrProduct prod,
+             SPtrYieldCurve discountYieldCurve,
+             double divYield,
+             SPtrVolatilityTermStructure volatility,
+             double spot,
+             McParams mcparams);
+
+  /** Returns the number of variables that can be tracked for stats: the PV and,
+      if mcparams.computeGreeks is set, its delta, gamma and vega.
+      Delta and vega are pathwise derivatives, by central differences on the same path, and gamma
+      is the likelihood ratio derivative of the pathwise delta. For products that are not
+      Lipschitz, e.g. digitals, all three are likelihood ratio estimates.
+      Products with early exercise do not support the Greeks.
+      Vega is with respect to a parallel shift of the forward volatilities.
+  */
+  size_t nVariables();
+
+  /** Runs the simulation and collects statistics.
+      If mcparams.nThreads > 0, the paths are split in blocks of McParams::PATHBLOCKSIZE paths,
+      each block with its own random stream, and the blocks are simulated on nThreads worker threads.
+      The samples are passed to the statistics calculator in path order, so for a given seed
+      the results do not depend on the number of threads.
+      With the CONTROLVARIATE control variate type the PVs are adjusted, one block at a time
+      and in path order, with controls priced in closed form: the discounted spot and an
+      at-the-money call at the last fixing time and, with several fixings, an at-the-money call
+      on the geometric average of the spots.
+      With the CONDITIONAL type, the product, e.g. a digital, pays its expected payments over
+      the last time step, computed in closed form, see Product::finalizeConditional().
+      For products with early exercise, the exercise policy is first estimated by Longstaff-Schwartz
+      regression on mcparams.nLsmPaths paths, independent of the pricing paths: in the serial
+      simulation they come first in the random stream, in the block-partitioned one they are the
+      blocks following the last pricing block.
+  */
+  template<typename ITER>
+  void simulate(StatisticsCalculator<ITER>& statsCalc, unsigned long npaths);
+
+  /** Runs the simulation until the standard error of the mean PV meets the target, or the
+      path or time budget of the target runs out. The criteria are checked after each block of
+      McParams::PATHBLOCKSIZE paths, in path order, so with the block-partitioned simulation the
+      stopping point does not depend on the number of threads; the blocks simulated beyond it in
+      the last round are discarded. It rejects the STRATIFIED and LATINHYPERCUBE urng types, whose
+      standard error overstates the actual one.
+      It returns the number of paths simulated.
+  */
+  template<typename ITER>
+  unsigned long simulateToTolerance(MeanVarCalculator<ITER>& statsCalc, McErrorTarget const& target);
+
+protected:
+
+  /** Simulates up to npaths paths and passes the PVs to the statistics calculator in path order.
+      After each block of McParams::PATHBLOCKSIZE paths it calls stop(n), with n the number of
+      paths simulated so far, and ends the simulation if it returns true.
+      It returns the number of paths simulated.
+  */
+  template<typename ITER, typename STOP>
+  unsigned long runSimulation(StatisticsCalculator<ITER>& statsCalc, unsigned long npaths, STOP stop);
+
+  /** Creates a batch of npaths price paths in paths_ */
+  void generatePaths(size_t npaths);
+
+  /** Creates a batch of npaths paths and evaluates the product on them with the streaming
+      evaluation, one time step at a time, writing the payments into payamts_.
+      Only the normal deviates of the batch are stored, not the price paths. For products with
+      early termination, the paths decided by the product are not simulated any further.
+      With conditional Monte Carlo, the product integrates the last time step in closed form.
+  */
+  void streamPaths(size_t npaths);
+
+  /** Creates a batch of npaths paths one time step at a time, and writes into pvs their PVs
+      following the exercise policy of the last calibration. The paths are not simulated
+      beyond their exercise time.
+  */
+  void exercisePaths(size_t npaths, double* pvs);
+
+  /** Creates and processes a batch of npaths price paths.
+      It writes the samples of each path into the rows [firstRow, firstRow + npaths) of samples,
+      the PV in the first column and the Greeks, if any, in the following ones.
+      */
+  void processPaths(size_t npaths, Matrix& samples, size_t firstRow);
+
+  /** Evaluates the product on a price path and returns its PV.
+      Products with early exercise follow the exercise policy of the last calibration.
+  */
+  double pathPV(Matrix const& pricePath);
+
+  /** Writes into pvs the PVs of the first npaths rows of payments in payamts_ */
+  void batchPVs(size_t npaths, double* pvs) const;
+
+  /** Computes the delta, gamma and vega samples of path p of the batch, with spots in pricePath_
+      and PV pv, and writes them into columns 1 to 3 of the given row of samples.
+      */
+  void pathGreeks(size_t p, double pv, Matrix& samples, size_t row);
+
+  /** Writes into bumpPath_ the price path p of the batch with all the forward vols shifted by volBump */
+  void vegaBumpedPath(size_t p, double volBump);
+
+  /** Computes the control variates on the batch of npaths paths last processed.
+      It writes them into the rows [firstRow, firstRow + npaths) of controls, one column per control.
+  */
+  void computeControls(size_t npaths, Matrix& controls, size_t firstRow);
+
+  /** Estimates the exercise policy on mcparams.nLsmPaths paths, ahead of a simulation of npaths paths */
+  void calibrateExercise(unsigned long npaths);
+
+  /** Simulates the paths of the blocks [firstBlock, firstBlock + nBlocks) on the worker threads,
+      stopping at path index npaths. The samples are written into the rows of samples, in path order,
+      and the control variates, if any, into the rows of controls.
+  */
+  void simulateBlocks(size_t firstBlock, size_t nBlocks, unsigned long npaths,
+                      Matrix& samples, Matrix& controls);
+
+private:
+  // number of blocks simulated by each worker thread in one round
+  enum { BLOCKSPERTHREAD = 16 };
+
+  SPtrProduct prod_;      // pointer to the product
+  SPtrYieldCurve discyc_; // pointer to the discount curve
+  double divyld_;         // the constant dividend yield   
+  SPtrVolatilityTermStructure vol_;            // the volatility term structure
+  double spot_;           // the initial spot
+  McParams mcparams_;     // the Monte Carlo parameters
+
+  SPtrPathGenerator pathgen_;  // pointer to the path generator
+  Vector discfactors_;         // caches the pre-computed discount factors
+  Vector drifts_;              // caches the pre-computed asset drifts
+  Vector stdevs_;              // caches the pre-computed standard deviations 
+  Vector sqrtdts_;             // caches the square roots of the time steps, for the Greeks
+  Vector condloadings_;        // the stdev of the last time step, empty without conditional Monte Carlo
+
+  Matrix payamts_;             // scratch matrix with the payments of a batch, one row per path
+  Matrix states_;              // scratch matrix with the states of the streaming evaluation, one row per path
+  Matrix currspots_;           // scratch matrix with the current spots of a batch, one row per path
+  Matrix stepdevs_;            // scratch matrix with the deviates of one time step of a lazy batch
+  std::vector<size_t> active_; // the paths of a lazy batch still simulated, in increasing order
+  Cube paths_;                 // scratch cube with a batch of paths, one slice per time step
+  Matrix pricePath_;           // scratch matrix with one price path of the batch
+  Cube devs_;                  // scratch cube with the normal increments of the batch, for the Greeks
+  Matrix bumpPath_;            // scratch matrix with a bumped price path, for the Greeks
+  Matrix samples_;             // scratch matrix with the samples of the paths, one column per variable
+
+  std::shared_ptr<ControlVariate> cv_;  // the control variate estimator, null if not used
+  double cvDiscount_;          // discount factor to the last fixing time, for the controls
+  double cvStrike_;            // strike of the vanilla control, the forward at the last fixing time
+  double cvGeoStrike_;         // strike of the geometric average control, its forward
+  Matrix controls_;            // scratch matrix with the control variates, one column per control
+
+  std::shared_ptr<LsmRegression> lsm_;  // the exercise policy, null for products without early exercise
+
+  std::vector<std::shared_ptr<BsMcPricer>> workers_;  // the pricers run by the worker threads
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+inline
+size_t BsMcPricer::nVariables()
+{
+  return mcparams_.computeGreeks ? 4 : 1;
+}
+
+template<typename ITER>
+void BsMcPricer::simulate(StatisticsCalculator<ITER>& statsCalc, unsigned long npaths)
+{
+  runSimulation(statsCalc, npaths, [](unsigned long) { return false; });
+}
+
+template<typename ITER>
+unsigned long BsMcPricer::simulateToTolerance(MeanVarCalculator<ITER>& statsCalc, McErrorTarget const& target)
+{
+  ORF_ASSERT(!mcparams_.hasStratifiedPaths(),
+    "the standard error of stratified paths overstates the error, simulate a number of paths instead!");
+  auto start = std::chrono::steady_clock::now();
+  return runSimulation(statsCalc, target.maxPaths, [&](unsigned long npaths) {
+    Matrix const& res = statsCalc.results();
+    double stdErr = std::sqrt(std::max(res(1, 0), 0.0) / statsCalc.nSamples());
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return target.isDone(res(0, 0), stdErr, npaths, elapsed.count());
+  });
+}
+
+template<typename ITER, typename STOP>
+unsigned long BsMcPricer::runSimulation(StatisticsCalculator<ITER>& statsCalc, unsigned long npaths, STOP stop)
+{
+  // check the size of the statistics calcuilator
+  ORF_ASSERT(statsCalc.nVariables() == nVariables(), "the statistics calculator must track as many variables as the pricer captures!");
+
+  // the control variate coefficients are estimated afresh in each simulation
+  if (cv_)
+    cv_->reset();
+  // and so is the exercise policy
+  if (lsm_)
+    calibrateExercise(npaths);
+
+  if (mcparams_.nThreads == 0) {
+    samples_.set_size(McParams::PATHBLOCKSIZE, nVariables());
+    if (cv_)
+      controls_.set_size(McParams::PATHBLOCKSIZE, cv_->nControls());
+
+    // This is the HOT loop, over batches of paths
+    for (unsigned long i = 0; i < npaths; i += McParams::PATHBLOCKSIZE) {
+      size_t n = std::min<unsigned long>(McParams::PATHBLOCKSIZE, npaths - i);
+      processPaths(n, samples_, 0);
+      if (cv_) {
+        computeControls(n, controls_, 0);
+        cv_->adjust(n, samples_.colptr(0), controls_);
+      }
+      statsCalc.addSamples(samples_, 0, n);
+      if (stop(i + n))
+        return i + n;
+    }
+    return npaths;
+  }
+
+  // block-partitioned simulation, a few blocks per worker thread in each round
+  size_t nblocks = (npaths + McParams::PATHBLOCKSIZE - 1) / McParams::PATHBLOCKSIZE;
+  size_t roundsize = mcparams_.nThreads * BLOCKSPERTHREAD;
+  for (size_t firstblock = 0; firstblock < nblocks; firstblock += roundsize) {
+    simulateBlocks(firstblock, std::min(roundsize, nblocks - firstblock), npaths, samples_, controls_);
+    // consume the round block by block, exactly as the serial simulation
+    size_t nrows = samples_.n_rows;
+    for (size_t k = 0; k < nrows; k += McParams::PATHBLOCKSIZE) {
+      size_t n = std::min<size_t>(McParams::PATHBLOCKSIZE, nrows - k);
+      if (cv_)
+        cv_->adjust(n, samples_.colptr(0) + k, controls_, k);
+      statsCalc.addSamples(samples_, k, n);
+      unsigned long ndone = firstblock * McParams::PATHBLOCKSIZE + k + n;
+      if (stop(ndone))
+        return ndone;
+    }
+  }
+  return npaths;
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_PRODUCT_HPP
@@ -0,0 +1,341 @@
+/**
+@file  bsmlmcpricer.cpp
+@brief Implementation of the BsMlmcPricer class
+*/
+
+#include <orflib/pricers/bsmlmcpricer.hpp>
+#include <orflib/methods/montecarlo/pathgeneratorfactory.hpp>
+#include <orflib/methods/montecarlo/antitheticpathgenerator.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+BEGIN_NAMESPACE(orf)
+
+// degree of the polynomials in the spot of the Longstaff-Schwartz regression
+static const size_t LSMDEGREE = 3;
+
+// the cost of evaluating the product on one fixing, relative to simulating one
+static const double EVALCOST = 0.1;
+
+// the number of points of a point rng reserved for each level, including the regression paths
+static const size_t LEVELPOINTS = size_t(1) << 26;
+
+// the point rngs index their points globally and ignore the stream index
+static bool isPointRng(McParams::UrngType urngType)
+{
+  return urngType == McParams::UrngType::SOBOL || urngType == McParams::UrngType::PHILOX
+    || urngType == McParams::UrngType::STRATIFIED || urngType == McParams::UrngType::LATINHYPERCUBE;
+}
+
+BsMlmcPricer::BsMlmcPricer(SPtrProduct prod,
+                           SPtrYieldCurve discountCurve,
+                           double divYield,
+                           SPtrVolatilityTermStructure volatility,
+                           double spot,
+                           McParams mcparams)
+: prod_(prod), discyc_(discountCurve), divyld_(divYield), vol_(volatility),
+spot_(spot), mcparams_(mcparams), stderr_(0.0)
+{
+  ORF_ASSERT(mcparams.controlVarType != McParams::ControlVarType::CONTROLVARIATE,
+    "the multilevel pricer does not support control variates!");
+  ORF_ASSERT(mcparams.controlVarType != McParams::ControlVarType::CONDITIONAL,
+    "the multilevel pricer does not support conditional Monte Carlo!");
+  ORF_ASSERT(mcparams.nThreads == 0, "the multilevel pricer simulates serially, nThreads must be 0!");
+  Vector const& fixtimes = prod->fixTimes();
+  size_t nfix = fixtimes.size();
+  ORF_ASSERT(nfix > 0, "the product has no fixing times!");
+
+  // the finest level L simulates all the fixings, with 2^L >= nfix
+  size_t nlevels = 1;
+  while ((size_t(1) << (nlevels - 1)) < nfix)
+    ++nlevels;
+  levels_.resize(nlevels);
+  for (size_t l = 0; l < nlevels; ++l) {
+    Level& lev = levels_[l];
+    // every stride-th fixing, counting back from the last one
+    size_t stride = size_t(1) << (nlevels - 1 - l);
+    for (size_t i = 0; i < nfix; ++i)
+      if ((nfix - 1 - i) % stride == 0)
+        lev.fixIdx.push_back(i);
+    size_t nnodes = lev.fixIdx.size();
+
+    // interpolation weights of all the fixings, and their sums over the fixings of each node
+    lev.nodeIdx.resize(nfix);
+    lev.nodeWgt.resize(nfix);
+    lev.nodeSum.zeros(nnodes);
+    lev.spotSum = 0.0;
+    for (size_t i = 0, r = 0; i < nfix; ++i) {
+      while (lev.fixIdx[r] < i) ++r;
+      double tleft = r > 0 ? fixtimes[lev.fixIdx[r - 1]] : 0.0;
+      double tright = fixtimes[lev.fixIdx[r]];
+      double wgt = tright > tleft ? (fixtimes[i] - tleft) / (tright - tleft) : 1.0;
+      lev.nodeIdx[i] = r;
+      lev.nodeWgt[i] = wgt;
+      lev.nodeSum[r] += wgt;
+      if (r > 0)
+        lev.nodeSum[r - 1] += 1.0 - wgt;
+      else
+        lev.spotSum += 1.0 - wgt;
+    }
+
+    // the path generator, with the drifts and stdevs from simulated fixing to simulated fixing
+    Vector times(nnodes);
+    lev.drifts.resize(nnodes);
+    lev.stdevs.resize(nnodes);
+    double t1 = 0.0;
+    for (size_t j = 0; j < nnodes; ++j) {
+      double t2 = fixtimes[lev.fixIdx[j]];
+      times[j] = t2;
+      double fwdvol = vol_->fwdVol(t1, t2);
+      double var = fwdvol * fwdvol * (t2 - t1);
+      lev.stdevs[j] = sqrt(var);
+      double fwdrate = t2 > t1 ? discyc_->fwdRate(t1, t2) : 0.0;  // e.g. a fixing at time 0
+      // risk free rate less yield plus convexity adjustment
+      lev.drifts[j] = (fwdrate - divyld_) * (t2 - t1) - 0.5 * var;
+      t1 = t2;
+    }
+    lev.pathgen = createPathGenerator(mcparams, times.begin(), times.end(), 1);
+    if (mcparams.controlVarType == McParams::ControlVarType::ANTITHETIC)
+      lev.pathgen = SPtrPathGenerator(new AntitheticPathGenerator(lev.pathgen));
+  }
+  // positions of the simulated fixings of each level in the grid of the next one
+  for (size_t l = 0; l + 1 < nlevels; ++l) {
+    std::vector<size_t> const& fineidx = levels_[l + 1].fixIdx;
+    for (size_t i : levels_[l].fixIdx)
+      levels_[l].finePos.push_back(lower_bound(fineidx.begin(), fineidx.end(), i) - fineidx.begin());
+  }
+
+  // Pre-compute the discount factors
+  Vector const& paytimes = prod->payTimes();
+  discfactors_.resize(paytimes.size());
+  for (size_t i = 0; i < paytimes.size(); ++i)
+    discfactors_[i] = discyc_->discount(paytimes[i]);
+
+  // Products with early exercise pay at the exercise (fixing) times
+  if (prod->hasEarlyExercise()) {
+    ORF_ASSERT(paytimes.size() == nfix, "early exercise needs one payment time per fixing time!");
+    ORF_ASSERT(mcparams.nLsmPaths > 0, "early exercise needs paths for the Longstaff-Schwartz regression!");
+    lsm_ = make_shared<LsmRegression>(Vector(1, arma::fill::value(spot_)), LSMDEGREE);
+  }
+  additive_ = !lsm_ && prod->hasAdditiveState();
+  pricePath_.set_size(nfix, 1);
+  samples_.set_size(McParams::PATHBLOCKSIZE, 1);
+}
+
+double BsMlmcPricer::simulate(double rmse, unsigned long nPilotPaths)
+{
+  ORF_ASSERT(rmse > 0.0, "the target standard error must be positive!");
+  ORF_ASSERT(nPilotPaths > 1, "need at least two pilot paths per level!");
+  ORF_ASSERT(!mcparams_.hasStratifiedPaths(),
+    "the standard error of stratified paths overstates the error, use another urng type!");
+  size_t nlevels = levels_.size();
+  for (size_t l = 0; l < nlevels; ++l) {
+    Level& lev = levels_[l];
+    // the pseudo-random rngs draw from the stream of the level index, the point rngs
+    // from the range of points of the level, so that the levels are independent
+    lev.pathgen->setStream(mcparams_.seed, l, l * LEVELPOINTS);
+    lev.stats.reset();
+  }
+  // the regression paths come first in the stream of the finest level
+  if (lsm_)
+    calibrateExercise();
+
+  // pilot run, then top up the levels to the optimal allocation for the target variance,
+  // N_l = sqrt(V_l / C_l) * sum_k sqrt(V_k C_k) / rmse^2, until no level needs more paths
+  for (size_t l = 0; l < nlevels; ++l)
+    simulateLevel(l, nPilotPaths);
+  Vector vars, costs;
+  bool done = false;
+  while (!done) {
+    vars = levelVariances();
+    costs = levelCosts();
+    double sumvc = arma::accu(arma::sqrt(vars % costs));
+    done = true;
+    for (size_t l = 0; l < nlevels; ++l) {
+      double target = ceil(sqrt(vars[l] / costs[l]) * sumvc / (rmse * rmse));
+      unsigned long npaths = levels_[l].stats.nSamples();
+      if (target > npaths) {
+        simulateLevel(l, static_cast<unsigned long>(target) - npaths);
+        done = false;
+      }
+    }
+  }
+
+  // the price is the sum of the level means
+  vars = levelVariances();
+  double price = 0.0;
+  double var = 0.0;
+  for (size_t l = 0; l < nlevels; ++l) {
+    MeanVarCalculator<double*>& stats = levels_[l].stats;
+    price += stats.results()(0, 0);
+    var += vars[l] / stats.nSamples();
+  }
+  stderr_ = sqrt(var);
+  return price;
+}
+
+std::vector<unsigned long> BsMlmcPricer::levelPaths() const
+{
+  std::vector<unsigned long> npaths;
+  for (Level const& lev : levels_)
+    npaths.push_back(lev.stats.nSamples());
+  return npaths;
+}
+
+Vector BsMlmcPricer::levelVariances()
+{
+  Vector vars(levels_.size(), arma::fill::zeros);
+  for (size_t l = 0; l < levels_.size(); ++l) {
+    MeanVarCalculator<double*>& stats = levels_[l].stats;
+    if (stats.nSamples() > 1)
+      vars[l] = stats.results()(1, 0);
+  }
+  return vars;
+}
+
+Vector BsMlmcPricer::levelCosts() const
+{
+  size_t nfix = prod_->fixTimes().size();
+  Vector costs(levels_.size());
+  bool onNodes = lsm_ || additive_;
+  for (size_t l = 0; l < levels_.size(); ++l) {
+    // with additive states or early exercise the product is evaluated at the fixings simulated only
+    double nevals = onNodes ? levels_[l].fixIdx.size() : nfix;
+    if (l > 0)
+      nevals += onNodes ? levels_[l - 1].fixIdx.size() : nfix;
+    costs[l] = levels_[l].fixIdx.size() + EVALCOST * nevals;
+  }
+  return costs;
+}
+
+void BsMlmcPricer::simulateLevel(size_t l, unsigned long npaths)
+{
+  Level& lev = levels_[l];
+  if (isPointRng(mcparams_.urngType)) {
+    unsigned long nlsmpaths = lsm_ && l + 1 == levels_.size() ? mcparams_.nLsmPaths : 0;
+    ORF_ASSERT(nlsmpaths + lev.stats.nSamples() + npaths <= LEVELPOINTS,
+      "the paths of a level exceed the points of the rng reserved for it!");
+  }
+  for (unsigned long i = 0; i < npaths; i += McParams::PATHBLOCKSIZE) {
+    size_t n = min<unsigned long>(McParams::PATHBLOCKSIZE, npaths - i);
+    lev.pathgen->nextBatch(n, paths_);
+    generateSpots(l);
+    // the PV of the level less the PV of the next coarser level, on the same path
+    if (additive_) {
+      samples_.zeros();
+      streamPVs(l, false, 1.0);
+      if (l > 0)
+        streamPVs(l, true, -1.0);
+      lev.stats.addSamples(samples_, 0, n);
+      continue;
+    }
+    for (size_t p = 0; p < n; ++p) {
+      fillPath(l, p, false);
+      double sample = pathPV(l);
+      if (l > 0) {
+        fillPath(l, p, true);
+        sample -= pathPV(l - 1);
+      }
+      samples_(p, 0) = sample;
+    }
+    lev.stats.addSamples(samples_, 0, n);
+  }
+}
+
+void BsMlmcPricer::generateSpots(size_t l)
+{
+  Level const& lev = levels_[l];
+  size_t npaths = paths_.n_rows;
+  // convert the normal deviates to spots in-place, one simulated fixing at a time
+  for (size_t j = 0; j < paths_.n_slices; ++j) {
+    double* spots = paths_.slice_colptr(j, 0);
+    double const* prevspots = j > 0 ? paths_.slice_colptr(j - 1, 0) : nullptr;
+    double drift = lev.drifts[j];
+    double stdev = lev.stdevs[j];
+    for (size_t p = 0; p < npaths; ++p) {
+      double spot = j > 0 ? prevspots[p] : spot_;
+      spots[p] = spot * exp(drift + stdev * spots[p]);
+    }
+  }
+}
+
+void BsMlmcPricer::fillPath(size_t l, size_t p, bool coarse)
+{
+  Level const& lev = coarse ? levels_[l - 1] : levels_[l];
+  size_t nnodes = lev.fixIdx.size();
+  // with early exercise, the level can only exercise at its simulated fixings
+  if (lsm_) {
+    for (size_t j = 0; j < nnodes; ++j)
+      pricePath_(lev.fixIdx[j], 0) = paths_(p, 0, coarse ? lev.finePos[j] : j);
+    return;
+  }
+  nodeSpots_.set_size(nnodes);
+  for (size_t j = 0; j < nnodes; ++j)
+    nodeSpots_[j] = paths_(p, 0, coarse ? lev.finePos[j] : j);
+  for (size_t i = 0; i < pricePath_.n_rows; ++i) {
+    size_t r = lev.nodeIdx[i];
+    double left = r > 0 ? nodeSpots_[r - 1] : spot_;
+    pricePath_(i, 0) = left + lev.nodeWgt[i] * (nodeSpots_[r] - left);
+  }
+}
+
+double BsMlmcPricer::pathPV(size_t l)
+{
+  if (lsm_)
+    return lsm_->exercisePV(*prod_, pricePath_, discfactors_, levels_[l].fixIdx);
+  prod_->eval(pricePath_);
+  Vector const& payamts = prod_->payAmounts();
+  double pv = 0.0;
+  for (size_t k = 0; k < payamts.size(); ++k)
+    pv += discfactors_[k] * payamts[k];
+  return pv;
+}
+
+void BsMlmcPricer::streamPVs(size_t l, bool coarse, double sign)
+{
+  Level const& lev = coarse ? levels_[l - 1] : levels_[l];
+  size_t npaths = paths_.n_rows;
+  prod_->resetState(npaths, states_);
+  currspots_.set_size(npaths, 1);
+  double* spots = currspots_.colptr(0);
+  // the fixings interpolated from the initial spot
+  if (lev.spotSum > 0.0) {
+    fill(spots, spots + npaths, lev.spotSum * spot_);
+    prod_->updateState(0, currspots_, states_);
+  }
+  for (size_t j = 0; j < lev.fixIdx.size(); ++j) {
+    double const* nodespots = paths_.slice_colptr(coarse ? lev.finePos[j] : j, 0);
+    double wgt = lev.nodeSum[j];
+    for (size_t p = 0; p < npaths; ++p)
+      spots[p] = wgt * nodespots[p];
+    prod_->updateState(lev.fixIdx[j], currspots_, states_);
+  }
+  prod_->finalizeState(states_, payamts_);
+  double* samples = samples_.colptr(0);
+  for (size_t k = 0; k < payamts_.n_cols; ++k) {
+    double const* payamts = payamts_.colptr(k);
+    double df = sign * discfactors_[k];
+    for (size_t p = 0; p < npaths; ++p)
+      samples[p] += df * payamts[p];
+  }
+}
+
+void BsMlmcPricer::calibrateExercise()
+{
+  size_t finest = levels_.size() - 1;
+  size_t blocksize = McParams::PATHBLOCKSIZE;
+  size_t nlsmpaths = mcparams_.nLsmPaths;
+  Cube lsmpaths(nlsmpaths, 1, prod_->fixTimes().size());
+  for (size_t k = 0; k < nlsmpaths; k += blocksize) {
+    size_t n = min(blocksize, nlsmpaths - k);
+    levels_[finest].pathgen->nextBatch(n, paths_);
+    generateSpots(finest);
+    lsmpaths.subcube(k, 0, 0, k + n - 1, 0, paths_.n_slices - 1) = paths_;
+  }
+  lsm_->calibrate(*prod_, lsmpaths, discfactors_);
+}
+
+END_NAMESPACE(orf)
@@ -0,0 +1,159 @@
+/**
+@file  bsmlmcpricer.hpp
+@brief Multilevel Monte Carlo pricer in the Black Scholes model
+*/
+
+#ifndef ORF_BSMLMCPRICER_HPP
+#define ORF_BSMLMCPRICER_HPP
+
+#include <orflib/products/product.hpp>
+#include <orflib/market/yieldcurve.hpp>
+#include <orflib/market/volatilitytermstructure.hpp>
+#include <orflib/methods/montecarlo/mcparams.hpp>
+#include <orflib/methods/montecarlo/pathgenerator.hpp>
+#include <orflib/methods/montecarlo/lsmregression.hpp>
+#include <orflib/math/stats/meanvarcalculator.hpp>
+#include <vector>
+
+BEGIN_NAMESPACE(orf)
+
+/** Multilevel Monte Carlo pricer in the Black-Scholes model (deterministic rates and vols),
+    for products with many fixing times.
+    The finest level L simulates the spot at all the fixing times of the product. Each coarser
+    level l simulates it only at every 2^(L-l)-th fixing time, counting back from the last one,
+    and fills the other fixings by linear interpolation of the spot in time, starting from the
+    initial spot. Level 0 simulates the last fixing only. For products with additive streaming
+    states, e.g. Asian averages, see Product::hasAdditiveState(), the interpolation is folded into
+    weights of the simulated fixings, so a path of a level costs in proportion to its simulated
+    fixings; the other products are evaluated on all the fixings, path by path.
+    The price is estimated as the mean PV of level 0 plus the mean differences of the PVs of
+    levels l and l - 1. On each path of level l both PVs see the same Brownian increments: the
+    spots are simulated exactly, so the coarse path is the fine one restricted to the coarse grid.
+    As the finest level is the product itself, the estimate is unbiased.
+    The paths per level are allocated from the observed variances and a deterministic cost model,
+    see levelCosts(), so a run is reproducible for a given seed.
+    Products with early exercise follow a Longstaff-Schwartz policy estimated on the finest grid;
+    on each level they can only be exercised at the fixing times simulated, as a Bermudan option.
+    Each level draws from its own random stream, seeded with mcparams.seed and the level index,
+    or, with the rngs of points indexed globally, e.g. SOBOL or PHILOX, from its own range of
+    2^26 points, which bounds the paths of a level.
+*/
+class BsMlmcPricer
+{
+public:
+  /** Initializing ctor. The simulation is serial, so mcparams.nThreads must be 0. */
+  BsMlmcPricer(SPtrProduct prod,
+               SPtrYieldCurve discountYieldCurve,
+               double divYield,
+               SPtrVolatilityTermStructure volatility,
+               double spot,
+               McParams mcparams);
+
+  /** Returns the number of levels, L + 1 */
+  size_t nLevels() const;
+
+  /** Runs the multilevel simulation until the standard error of the price is at most rmse.
+      It starts with nPilotPaths paths on each level to estimate the variances and costs.
+      It rejects the STRATIFIED and LATINHYPERCUBE urng types, whose variances overstate the errors.
+      It returns the price estimate.
+  */
+  double simulate(double rmse, unsigned long nPilotPaths = McParams::PATHBLOCKSIZE);
+
+  /** Returns the standard error of the price of the last simulation */
+  double stdErr() const;
+
+  /** Returns the number of paths simulated on each level */
+  std::vector<unsigned long> levelPaths() const;
+
+  /** Returns the variances of the PV of level 0 and of the PV differences of the other levels */
+  Vector levelVariances();
+
+  /** Returns the cost of one path of each level, in units of the simulation of one fixing:
+      the fixings simulated, plus a fraction for each fixing the product is evaluated on,
+      once on level 0 and twice, fine and coarse, on the other levels. Products with additive
+      states or early exercise are evaluated on the fixings simulated only, the others on all.
+  */
+  Vector levelCosts() const;
+
+protected:
+  /** Simulates npaths paths of level l and adds their samples to the statistics of the level */
+  void simulateLevel(size_t l, unsigned long npaths);
+
+  /** Converts the normal increments in paths_ to the spots at the fixing times of level l */
+  void generateSpots(size_t l);
+
+  /** Fills pricePath_ from the spots of path p of the batch of level l, interpolating the fixings
+      not simulated, except for products with early exercise. If coarse is true it uses only the
+      fixing times of level l - 1.
+  */
+  void fillPath(size_t l, size_t p, bool coarse);
+
+  /** Evaluates the product on pricePath_, as filled for level l, and returns its PV */
+  double pathPV(size_t l);
+
+  /** Evaluates a product with additive states on the batch of level l with the streaming
+      evaluation, passing each simulated fixing weighted by the fixings it stands for, and adds
+      sign times the PVs to samples_. If coarse is true it uses only the fixing times of level l - 1.
+  */
+  void streamPVs(size_t l, bool coarse, double sign);
+
+  /** Estimates the exercise policy on mcparams.nLsmPaths paths of the finest level */
+  void calibrateExercise();
+
+private:
+  /** The grid of a level and its statistics */
+  struct Level
+  {
+    std::vector<size_t> fixIdx;   // the fixing times simulated, as indices into the product fixings
+    std::vector<size_t> nodeIdx;  // for each fixing of the product, the first simulated one at or after it
+    Vector nodeWgt;               // its interpolation weight; the previous node, or time 0, gets the rest
+    Vector nodeSum;               // the total interpolation weight of each simulated fixing
+    double spotSum;               // the total interpolation weight of the initial spot
+    std::vector<size_t> finePos;  // the position of each simulated fixing in the grid of the next level
+    SPtrPathGenerator pathgen;    // the path generator on the fixing times simulated
+    Vector drifts;                // the log drifts from simulated fixing to simulated fixing
+    Vector stdevs;                // the standard deviations from simulated fixing to simulated fixing
+    MeanVarCalculator<double*> stats{ 1 };  // the mean and variance of the samples
+  };
+
+  SPtrProduct prod_;      // pointer to the product
+  SPtrYieldCurve discyc_; // pointer to the discount curve
+  double divyld_;         // the constant dividend yield
+  SPtrVolatilityTermStructure vol_;            // the volatility term structure
+  double spot_;           // the initial spot
+  McParams mcparams_;     // the Monte Carlo parameters
+
+  std::vector<Level> levels_;  // the levels, from the coarsest to the finest
+  Vector discfactors_;         // caches the pre-computed discount factors
+  double stderr_;              // the standard error of the last simulation
+  bool additive_;              // true if the product is evaluated on the simulated fixings only
+
+  Cube paths_;                 // scratch cube with a batch of paths, one slice per simulated fixing
+  Matrix samples_;             // scratch matrix with the samples of a batch
+  Matrix pricePath_;           // scratch matrix with one price path at all the product fixings
+  Vector nodeSpots_;           // scratch array with the spots of one path at the simulated fixings
+  Matrix currspots_;           // scratch matrix with the weighted spots of a batch at one fixing
+  Matrix states_;              // scratch matrix with the states of the streaming evaluation
+  Matrix payamts_;             // scratch matrix with the payments of a batch, one row per path
+
+  std::shared_ptr<LsmRegression> lsm_;  // the exercise policy, null for products without early exercise
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+inline
+size_t BsMlmcPricer::nLevels() const
+{
+  return levels_.size();
+}
+
+inline
+double BsMlmcPricer::stdErr() const
+{
+  return stderr_;
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_BSMLMCPRICER_HPP
@@ -1,116 +1,529 @@
-/**
-  @file  multiassetbsmcpricer.cpp
-  @brief Implementation of the MultiAssetBsMcPricer class
-*/
-
-#include <orflib/pricers/multiassetbsmcpricer.hpp>
-#include <orflib/methods/montecarlo/eulerpathgenerator.hpp>
-
-#include <cmath>
-
-using namespace std;
-
-BEGIN_NAMESPACE(orf)
-
-MultiAssetBsMcPricer::MultiAssetBsMcPricer(SPtrProduct prod,
-                                           SPtrYieldCurve discountCurve,
-                                           Vector const& divYields,
-                                           Vector const& volatilities,
-                                           Vector const& spots,
-                                           Matrix const& correlMatrix,
-                                           McParams const& mcparams)
-: prod_(prod), discyc_(discountCurve), divylds_(divYields), vols_(volatilities),
-spots_(spots), mcparams_(mcparams)
-{
-  // Get the simulation times
-  Vector timesteps = prod->fixTimes();
-  size_t ntimesteps = timesteps.size();
-
-  // Get the number of assets (factors) and check inputs for size.
-  size_t nassets = prod->nAssets();
-  ORF_ASSERT(divYields.size() == nassets, "need as many div yields as product assets!");
-  ORF_ASSERT(volatilities.size() == nassets, "need as many volatilities as product assets!");
-  ORF_ASSERT(spots.size() == nassets, "need as many spots as product assets!");
-  if (nassets > 1) {
-    ORF_ASSERT(correlMatrix.is_square(), "the correlation matrix must be square!");
-    ORF_ASSERT(correlMatrix.n_rows == nassets, "need as many correlation matrix rows as product assets!");
-  }
-
-  // Create the path generator, one factor to simulate the spot
-  if (mcparams.pathGenType == McParams::PathGenType::EULER) {
-    if (mcparams.urngType == McParams::UrngType::MINSTDRAND)
-      pathgen_ = SPtrPathGenerator(new EulerPathGenerator<NormalRngMinStdRand>(
-        timesteps.begin(), timesteps.end(), nassets, correlMatrix));
-    else if (mcparams.urngType == McParams::UrngType::MT19937)
-      pathgen_ = SPtrPathGenerator(new EulerPathGenerator<NormalRngMt19937>(
-        timesteps.begin(), timesteps.end(), nassets, correlMatrix));
-    else if (mcparams.urngType == McParams::UrngType::RANLUX3)
-      pathgen_ = SPtrPathGenerator(new EulerPathGenerator<NormalRngRanLux3>(
-        timesteps.begin(), timesteps.end(), nassets, correlMatrix));
-    else if (mcparams.urngType == McParams::UrngType::RANLUX4)
-      pathgen_ = SPtrPathGenerator(new EulerPathGenerator<NormalRngRanLux4>(
-        timesteps.begin(), timesteps.end(), nassets, correlMatrix));
-    else if (mcparams.urngType == McParams::UrngType::SOBOL)
-      pathgen_ = SPtrPathGenerator(new EulerPathGenerator<NormalRngSobol>(
-        timesteps.begin(), timesteps.end(), nassets, correlMatrix));
-    else
-      ORF_ASSERT(0, "unknown urng type!");
-  }
-  else
-    ORF_ASSERT(0, "unknown path generator type!");
-
-  // Pre-compute the discount factors
-  Vector const& paytimes = prod->payTimes();
-  discfactors_.resize(paytimes.size());
-  for (size_t i = 0; i < paytimes.size(); ++i)
-    discfactors_[i] = discyc_->discount(paytimes[i]);
-
-  // Pre-compute the stdevs and drifts from time step to time step
-  Vector const& fixtimes = prod->fixTimes();
-  drifts_.resize(fixtimes.size(), nassets);
-  stdevs_.resize(fixtimes.size(), nassets);
-
-  // loop over assets
-  for (size_t j = 0; j < nassets; ++j) {
-    double t1 = 0.0;
-    // loop over fixing times
-    for (size_t i = 0; i < fixtimes.size(); ++i) {
-      double t2 = fixtimes[i];
-      double var = vols_[j] * vols_[j] * (t2 - t1);
-      stdevs_(i, j) = vols_[j];
-      double fwdrate = discyc_->fwdRate(t1, t2);
-      // risk free rate less yield plus convexity adjustment
-      drifts_(i, j) = (fwdrate - divylds_[j]) * (t2 - t1) - 0.5 * var;
-      t1 = t2;
-    }
-  }
-
-  // Resize the payment amounts
-  payamts_.resize(prod->payTimes().size());
-
-}
-
-double MultiAssetBsMcPricer::processOnePath(Matrix& pricePath)
-{
-  pathgen_->next(pricePath);
-  size_t nassets = prod_->nAssets();
-  currspots_ = spots_;               // initialize the current spots array
-  // convert the normal deviates to a price path in-place
-  for (size_t i = 0; i < pricePath.n_rows; ++i) {
-    for (size_t j = 0; j < nassets; ++j) {
-      double normaldeviate = pricePath(i, j);
-      pricePath(i, j) = currspots_[j] * exp(drifts_(i, j) + stdevs_(i, j) * normaldeviate);
-      currspots_[j] = pricePath(i, j);  // store the spot for the next time step
-    }
-  }
-  prod_->eval(pricePath);
-  payamts_ = prod_->payAmounts();
-
-  double pv = 0.0;
-  for (size_t i = 0; i < payamts_.size(); ++i)
-    pv += discfactors_[i] * payamts_[i];
-
-  return pv;
-}
-
-END_NAMESPACE(orf)
+/**
+  @file  multiassetbsmcpricer.cpp
+  @brief Implementation of the MultiAssetBsMcPricer class
+*/
+
+#include <orflib/pricers/multiassetbsmcpricer.hpp>
+#include <orflib/methods/montecarlo/pathgeneratorfactory.hpp>
+#include <orflib/methods/montecarlo/antitheticpathgenerator.hpp>
+#include <orflib/pricers/simplepricers.hpp>
+
+#include <cmath>
+#include <numeric>
+
+using namespace std;
+
+BEGIN_NAMESPACE(orf)
+
+// total degree of the polynomials in the spots of the Longstaff-Schwartz regression
+static const size_t LSMDEGREE = 2;
+
+MultiAssetBsMcPricer::MultiAssetBsMcPricer(SPtrProduct prod,
+                                           SPtrYieldCurve discountCurve,
+                                           Vector const& divYields,
+                                           Vector const& volatilities,
+                                           Vector const& spots,
+                                           Matrix const& correlMatrix,
+                                           McParams const& mcparams)
+: prod_(prod), discyc_(discountCurve), divylds_(divYields), vols_(volatilities),
+spots_(spots), mcparams_(mcparams)
+{
+  ORF_ASSERT(mcparams.nThreads == 0, "the multiasset pricer simulates serially, nThreads must be 0!");
+
+  // Get the simulation times
+  Vector timesteps = prod->fixTimes();
+  size_t ntimesteps = timesteps.size();
+
+  // Get the number of assets (factors) and check inputs for size.
+  size_t nassets = prod->nAssets();
+  ORF_ASSERT(divYields.size() == nassets, "need as many div yields as product assets!");
+  ORF_ASSERT(volatilities.size() == nassets, "need as many volatilities as product assets!");
+  ORF_ASSERT(spots.size() == nassets, "need as many spots as product assets!");
+  if (nassets > 1) {
+    ORF_ASSERT(correlMatrix.is_square(), "the correlation matrix must be square!");
+    ORF_ASSERT(correlMatrix.n_rows == nassets, "need as many correlation matrix rows as product assets!");
+  }
+
+  // Create the path generator, one factor per asset
+  pathgen_ = createPathGenerator(mcparams, timesteps.begin(), timesteps.end(), nassets, correlMatrix);
+  if (mcparams.controlVarType == McParams::ControlVarType::ANTITHETIC)
+    pathgen_ = SPtrPathGenerator(new AntitheticPathGenerator(pathgen_));
+
+  // Pre-compute the discount factors
+  Vector const& paytimes = prod->payTimes();
+  discfactors_.resize(paytimes.size());
+  for (size_t i = 0; i < paytimes.size(); ++i)
+    discfactors_[i] = discyc_->discount(paytimes[i]);
+
+  // Pre-compute the stdevs and drifts from time step to time step
+  Vector const& fixtimes = prod->fixTimes();
+  drifts_.resize(fixtimes.size(), nassets);
+  stdevs_.resize(fixtimes.size(), nassets);
+
+  // loop over assets
+  for (size_t j = 0; j < nassets; ++j) {
+    double t1 = 0.0;
+    // loop over fixing times
+    for (size_t i = 0; i < fixtimes.size(); ++i) {
+      double t2 = fixtimes[i];
+      double var = vols_[j] * vols_[j] * (t2 - t1);
+      stdevs_(i, j) = sqrt(var);
+      double fwdrate = t2 > t1 ? discyc_->fwdRate(t1, t2) : 0.0;  // e.g. a fixing at time 0
+      // risk free rate less yield plus convexity adjustment
+      drifts_(i, j) = (fwdrate - divylds_[j]) * (t2 - t1) - 0.5 * var;
+      t1 = t2;
+    }
+  }
+
+  // Products with early exercise pay at the exercise (fixing) times
+  if (prod->hasEarlyExercise()) {
+    ORF_ASSERT(paytimes.size() == ntimesteps, "early exercise needs one payment time per fixing time!");
+    ORF_ASSERT(mcparams.nLsmPaths > 0, "early exercise needs paths for the Longstaff-Schwartz regression!");
+    ORF_ASSERT(!mcparams.computeGreeks, "the adjoint Greeks do not support early exercise!");
+    lsm_ = make_shared<LsmRegression>(spots_, LSMDEGREE);
+  }
+
+  // Conditional Monte Carlo integrates Z = 1' d / s over the last time step, the normalized sum of
+  // the correlated deviates d = L z, with s^2 = 1' C 1 for the correlation C = L L'. It is the
+  // independent deviate z along the direction L' 1 / s, so every asset j loads on it, with the
+  // weight (C 1)_j / s, and d less these loadings times Z is independent of Z
+  if (mcparams.controlVarType == McParams::ControlVarType::CONDITIONAL) {
+    ORF_ASSERT(prod->hasConditionalPayoff(), "the product does not support conditional Monte Carlo!");
+    ORF_ASSERT(!prod->hasEarlyExercise() && !mcparams.computeGreeks,
+      "conditional Monte Carlo does not support early exercise or the Greeks!");
+    Matrix correl = pathgen_->correlation();
+    Vector rowsums = arma::sum(correl, 1);
+    double var = arma::accu(rowsums);
+    condweights_.zeros(nassets);
+    condcol_.zeros(nassets);
+    // assets whose sum does not vary integrate nothing
+    if (var > 0.0) {
+      double s = sqrt(var);
+      condweights_.fill(1.0 / s);
+      condcol_ = rowsums / s;
+    }
+    condloadings_ = stdevs_.row(ntimesteps - 1).t() % condcol_;
+  }
+
+  // The adjoint of the volatilities needs the time steps
+  if (mcparams.computeGreeks) {
+    sqrtdts_.resize(ntimesteps);
+    for (size_t i = 0; i < ntimesteps; ++i)
+      sqrtdts_[i] = sqrt(fixtimes[i] - (i > 0 ? fixtimes[i - 1] : 0.0));
+  }
+
+  // Set up the control variates and their expectations, all paid at the last fixing time
+  if (mcparams.controlVarType == McParams::ControlVarType::CONTROLVARIATE) {
+    double T = fixtimes[ntimesteps - 1];
+    ORF_ASSERT(T > 0.0 && vols_.min() > 0.0,
+      "control variates need a positive last fixing time and volatilities!");
+    cvDiscount_ = discyc_->discount(T);
+    double rate = -log(cvDiscount_) / T;
+    Vector means(nassets + 1);
+    for (size_t j = 0; j < nassets; ++j)
+      means[j] = spots_[j] * exp(-divylds_[j] * T);
+    // lognormal geometric average, with the correlation actually simulated
+    double mean, var;
+    geometricAverageMoments(drifts_, stdevs_, pathgen_->correlation(), mean, var);
+    cvGeoStrike_ = exp(mean + 0.5 * var);
+    means[nassets] = europeanOptionBS(1, cvGeoStrike_, cvGeoStrike_, T, rate, rate, sqrt(var / T))[0];
+    cv_ = make_shared<ControlVariate>(means);
+  }
+}
+
+void MultiAssetBsMcPricer::generatePaths(size_t npaths)
+{
+  pathgen_->nextBatch(npaths, paths_);
+  // keep the correlated deviates for the adjoint
+  if (mcparams_.computeGreeks)
+    devs_ = paths_;
+  size_t nassets = paths_.n_cols;
+  // convert the normal deviates to price paths in-place, one time step and asset at a time
+  for (size_t i = 0; i < paths_.n_slices; ++i) {
+    for (size_t j = 0; j < nassets; ++j) {
+      double* spots = paths_.slice_colptr(i, j);
+      double const* prevspots = i > 0 ? paths_.slice_colptr(i - 1, j) : nullptr;
+      double drift = drifts_(i, j);
+      double stdev = stdevs_(i, j);
+      for (size_t p = 0; p < npaths; ++p) {
+        double spot = i > 0 ? prevspots[p] : spots_[j];
+        spots[p] = spot * exp(drift + stdev * spots[p]);
+      }
+    }
+  }
+}
+
+void MultiAssetBsMcPricer::streamPaths(size_t npaths)
+{
+  size_t nassets = prod_->nAssets();
+  size_t nsteps = prod_->fixTimes().size();
+  // conditional Monte Carlo does not pass the last time step to the product
+  bool conditional = !condloadings_.is_empty();
+  size_t nstream = conditional ? nsteps - 1 : nsteps;
+  prod_->resetState(npaths, states_);
+  currspots_.set_size(npaths, nassets);
+  if (prod_->hasEarlyTermination()) {
+    // move only the paths not yet decided by the product to the next time step
+    pathgen_->beginBatch(npaths);
+    active_.resize(npaths);
+    iota(active_.begin(), active_.end(), size_t(0));
+    for (size_t i = 0; i < nstream && !active_.empty(); ++i) {
+      stepActive(i);
+      prod_->updateState(i, currspots_, states_);
+      prod_->updateActive(i, states_, active_);
+    }
+    // the paths decided by the product are passed through at the spots of their last time step
+    if (conditional && !active_.empty()) {
+      pathgen_->nextStep(nsteps - 1, active_, stepdevs_);
+      conditionalSpots(stepdevs_);
+    }
+  }
+  else {
+    pathgen_->nextBatch(npaths, paths_);
+    // move the spots to each time step, and pass them on to the product
+    for (size_t i = 0; i < nstream; ++i) {
+      for (size_t j = 0; j < nassets; ++j) {
+        double* spots = currspots_.colptr(j);
+        double const* devs = paths_.slice_colptr(i, j);
+        double drift = drifts_(i, j);
+        double stdev = stdevs_(i, j);
+        for (size_t p = 0; p < npaths; ++p) {
+          double spot = i > 0 ? spots[p] : spots_[j];
+          spots[p] = spot * exp(drift + stdev * devs[p]);
+        }
+      }
+      prod_->updateState(i, currspots_, states_);
+    }
+    if (conditional) {
+      active_.resize(npaths);
+      iota(active_.begin(), active_.end(), size_t(0));
+      conditionalSpots(Matrix(paths_.slice_memptr(nsteps - 1), npaths, nassets, false, true));
+    }
+  }
+  if (conditional)
+    prod_->finalizeConditional(states_, currspots_, condloadings_, payamts_);
+  else
+    prod_->finalizeState(states_, payamts_);
+}
+
+void MultiAssetBsMcPricer::conditionalSpots(Matrix const& devs)
+{
+  size_t i = drifts_.n_rows - 1;
+  size_t nassets = currspots_.n_cols;
+  for (size_t p : active_) {
+    // remove the part of the deviates driven by Z, which the product integrates
+    double z = 0.0;
+    for (size_t k = 0; k < nassets; ++k)
+      z += condweights_[k] * devs(p, k);
+    for (size_t j = 0; j < nassets; ++j) {
+      double spot = i > 0 ? currspots_(p, j) : spots_[j];
+      currspots_(p, j) = spot * exp(drifts_(i, j) + stdevs_(i, j) * (devs(p, j) - condcol_[j] * z));
+    }
+  }
+}
+
+void MultiAssetBsMcPricer::stepActive(size_t i)
+{
+  pathgen_->nextStep(i, active_, stepdevs_);
+  for (size_t j = 0; j < currspots_.n_cols; ++j) {
+    double* spots = currspots_.colptr(j);
+    double const* devs = stepdevs_.colptr(j);
+    double drift = drifts_(i, j);
+    double stdev = stdevs_(i, j);
+    for (size_t p : active_) {
+      double spot = i > 0 ? spots[p] : spots_[j];
+      spots[p] = spot * exp(drift + stdev * devs[p]);
+    }
+  }
+}
+
+void MultiAssetBsMcPricer::exercisePaths(size_t npaths, double* pvs)
+{
+  pathgen_->beginBatch(npaths);
+  active_.resize(npaths);
+  iota(active_.begin(), active_.end(), size_t(0));
+  currspots_.set_size(npaths, prod_->nAssets());
+  // all the paths still active are exercised at the last time step
+  for (size_t i = 0; !active_.empty(); ++i) {
+    stepActive(i);
+    size_t nactive = 0;
+    for (size_t p : active_)
+      if (!lsm_->exerciseStep(*prod_, i, currspots_, p, discfactors_, pvs[p]))
+        active_[nactive++] = p;
+    active_.resize(nactive);
+  }
+}
+
+void MultiAssetBsMcPricer::processPaths(size_t npaths, Matrix& samples)
+{
+  double* pvs = samples.colptr(0);
+  // products without early exercise are evaluated on the whole batch,
+  // streaming the time steps unless the control variates need the price paths
+  if (!lsm_ && !mcparams_.computeGreeks) {
+    if (cv_) {
+      generatePaths(npaths);
+      prod_->evalBatch(paths_, payamts_);
+    }
+    else {
+      streamPaths(npaths);
+    }
+    batchPVs(npaths, pvs);
+    weightPaths(npaths, pvs);
+    return;
+  }
+
+  // products with early exercise stop their paths at the exercise time,
+  // unless the Greeks or the control variates need the whole price paths
+  if (!mcparams_.computeGreeks && !cv_) {
+    exercisePaths(npaths, pvs);
+    return;
+  }
+
+  generatePaths(npaths);
+  size_t nassets = paths_.n_cols;
+
+  // evaluate the product on each path, with the adjoint of the PV if needed
+  pricePath_.set_size(paths_.n_slices, nassets);
+  if (mcparams_.computeGreeks)
+    pathBars_.set_size(npaths, nassets, paths_.n_slices);
+  for (size_t p = 0; p < npaths; ++p) {
+    for (size_t i = 0; i < paths_.n_slices; ++i)
+      for (size_t j = 0; j < nassets; ++j)
+        pricePath_(i, j) = paths_(p, j, i);
+    if (lsm_) {
+      pvs[p] = lsm_->exercisePV(*prod_, pricePath_, discfactors_);
+      continue;
+    }
+    if (mcparams_.computeGreeks) {
+      // the adjoints of the payments are their discount factors
+      prod_->evalAdjoint(pricePath_, discfactors_, pathBar_);
+      for (size_t i = 0; i < paths_.n_slices; ++i)
+        for (size_t j = 0; j < nassets; ++j)
+          pathBars_(p, j, i) = pathBar_(i, j);
+    }
+    else {
+      prod_->eval(pricePath_);
+    }
+    Vector const& payamts = prod_->payAmounts();
+    double pv = 0.0;
+    for (size_t k = 0; k < payamts.size(); ++k)
+      pv += discfactors_[k] * payamts[k];
+    pvs[p] = pv;
+  }
+
+  weightPaths(npaths, pvs);
+  if (mcparams_.computeGreeks) {
+    // the likelihood ratios do not depend on the market, so the Greeks are weighted like the PVs
+    for (size_t i = 0; i < paths_.n_slices; ++i)
+      for (size_t j = 0; j < nassets; ++j)
+        weightPaths(npaths, pathBars_.slice_colptr(i, j));
+    adjointPaths(npaths, samples);
+  }
+}
+
+void MultiAssetBsMcPricer::batchPVs(size_t npaths, double* pvs) const
+{
+  for (size_t p = 0; p < npaths; ++p)
+    pvs[p] = 0.0;
+  for (size_t k = 0; k < payamts_.n_cols; ++k) {
+    double const* payamts = payamts_.colptr(k);
+    double df = discfactors_[k];
+    for (size_t p = 0; p < npaths; ++p)
+      pvs[p] += df * payamts[p];
+  }
+}
+
+void MultiAssetBsMcPricer::weightPaths(size_t npaths, double* values) const
+{
+  if (pathgen_->driftShift().is_empty())
+    return;
+  Vector const& logwgts = pathgen_->logWeights();
+  for (size_t p = 0; p < npaths; ++p)
+    values[p] *= exp(logwgts[p]);
+}
+
+void MultiAssetBsMcPricer::setDriftShift(Matrix const& shift)
+{
+  // the exercise policy would be estimated on the shifted paths
+  ORF_ASSERT(!lsm_, "importance sampling does not support early exercise!");
+  Matrix theta = shift;
+  // the deviate integrated by conditional Monte Carlo keeps its distribution: the last time step
+  // is not shifted along its direction u = L' w in the independent deviates
+  if (!condloadings_.is_empty() && !theta.is_empty()) {
+    Matrix const& L = pathgen_->sqrtCorrelation();
+    RowVector u = L.is_empty() ? RowVector(condweights_.t()) : RowVector(condweights_.t() * L);
+    size_t last = theta.n_rows - 1;
+    theta.row(last) -= arma::dot(theta.row(last), u) * u;
+  }
+  pathgen_->setDriftShift(theta);
+}
+
+Matrix const& MultiAssetBsMcPricer::optimizeDriftShift(unsigned long npaths, size_t niters)
+{
+  ORF_ASSERT(!prod_->hasEarlyTermination(),
+    "the drift shift optimization does not support early termination, use setDriftShift()!");
+  size_t nsteps = prod_->fixTimes().size();
+  size_t nassets = prod_->nAssets();
+  Matrix const& L = pathgen_->sqrtCorrelation();
+  if (!L.is_empty())
+    ORF_ASSERT(L.diag().min() > 0.0,
+      "the drift shift optimization needs a positive definite correlation matrix!");
+
+  Vector pvs(McParams::PATHBLOCKSIZE), z(nassets);
+  Matrix shift(nsteps, nassets);
+  for (size_t it = 0; it < niters; ++it) {
+    // cross-entropy: the shift that maximizes the likelihood of the pilot deviates, each path
+    // weighted by its absolute PV times its likelihood ratio, is their weighted mean
+    shift.zeros();
+    double den = 0.0;
+    for (unsigned long k = 0; k < npaths; k += McParams::PATHBLOCKSIZE) {
+      size_t n = min<unsigned long>(McParams::PATHBLOCKSIZE, npaths - k);
+      streamPaths(n);            // leaves the correlated deviates in paths_
+      batchPVs(n, pvs.memptr());
+      for (size_t p = 0; p < n; ++p)
+        pvs[p] = fabs(pvs[p]);
+      weightPaths(n, pvs.memptr());
+      for (size_t p = 0; p < n; ++p) {
+        if (pvs[p] == 0.0)
+          continue;
+        den += pvs[p];
+        for (size_t i = 0; i < nsteps; ++i) {
+          // the independent deviates, by forward substitution of L z = d
+          for (size_t j = 0; j < nassets; ++j) {
+            double sum = paths_(p, j, i);
+            if (!L.is_empty()) {
+              for (size_t m = 0; m < j; ++m)
+                sum -= L(j, m) * z[m];
+              sum /= L(j, j);
+            }
+            z[j] = sum;
+            shift(i, j) += pvs[p] * sum;
+          }
+        }
+      }
+    }
+    ORF_ASSERT(den > 0.0, "no pilot path pays, the drift shift cannot be optimized!");
+    setDriftShift(shift / den);
+  }
+  return pathgen_->driftShift();
+}
+
+void MultiAssetBsMcPricer::calibrateExercise()
+{
+  size_t blocksize = McParams::PATHBLOCKSIZE;
+  size_t nlsmpaths = mcparams_.nLsmPaths;
+  Cube lsmpaths(nlsmpaths, prod_->nAssets(), prod_->fixTimes().size());
+  for (size_t k = 0; k < nlsmpaths; k += blocksize) {
+    size_t n = min(blocksize, nlsmpaths - k);
+    generatePaths(n);
+    lsmpaths.subcube(k, 0, 0, k + n - 1, paths_.n_cols - 1, paths_.n_slices - 1) = paths_;
+  }
+  lsm_->calibrate(*prod_, lsmpaths, discfactors_);
+}
+
+void MultiAssetBsMcPricer::adjointPaths(size_t npaths, Matrix& samples)
+{
+  size_t nsteps = paths_.n_slices;
+  size_t nassets = paths_.n_cols;
+  bool correlated = pathgen_->sqrtCorrelation().n_rows > 0;
+  samples.submat(0, 1 + nassets, npaths - 1, 2 * nassets).zeros();
+
+  // backwards in time: the log price at step i enters the prices of all later steps
+  logBar_.zeros(npaths, nassets);
+  devBar_.set_size(npaths, nassets);
+  for (size_t i = nsteps; i-- > 0;) {
+    double sqrtdt = sqrtdts_[i];
+    for (size_t j = 0; j < nassets; ++j) {
+      double* logbar = logBar_.colptr(j);
+      double const* pathbars = pathBars_.slice_colptr(i, j);
+      double const* spots = paths_.slice_colptr(i, j);
+      double const* devs = devs_.slice_colptr(i, j);
+      double* devbar = devBar_.colptr(j);
+      double* vegas = samples.colptr(1 + nassets + j);
+      double stdev = stdevs_(i, j);
+      // the log increment depends on the vol through vol * sqrtdt * dev - vol^2 * dt / 2
+      for (size_t p = 0; p < npaths; ++p) {
+        logbar[p] += pathbars[p] * spots[p];
+        devbar[p] = logbar[p] * stdev;
+        vegas[p] += logbar[p] * sqrtdt * (devs[p] - stdev);
+      }
+    }
+    if (correlated) {
+      // a view on the memory of the slice, Cube::slice() would allocate a matrix header
+      Matrix devs(devs_.slice_memptr(i), npaths, nassets, false, true);
+      correlBar_ += devBar_.t() * devs;
+    }
+  }
+
+  // the initial spots enter the log price of the first step
+  for (size_t j = 0; j < nassets; ++j) {
+    double const* logbar = logBar_.colptr(j);
+    double* deltas = samples.colptr(1 + j);
+    for (size_t p = 0; p < npaths; ++p)
+      deltas[p] = logbar[p] / spots_[j];
+  }
+}
+
+void MultiAssetBsMcPricer::computeCorrelSensitivities(unsigned long npaths)
+{
+  size_t nassets = prod_->nAssets();
+  correlSens_.zeros(nassets, nassets);
+  Matrix const& sqrtcorrel = pathgen_->sqrtCorrelation();
+  if (sqrtcorrel.n_rows == 0 || npaths == 0)
+    return;
+  ORF_ASSERT(sqrtcorrel.diag().min() > 0.0,
+    "the correlation sensitivities need a positive definite correlation matrix!");
+
+  // the deviates are x = L z, so the adjoint of L is the mean of xbar z' = xbar x' L^-T
+  Matrix lt = sqrtcorrel.t();
+  Matrix sqrtbar = arma::solve(arma::trimatl(sqrtcorrel), correlBar_.t() / npaths).t();
+  sqrtbar = arma::trimatl(sqrtbar);
+
+  // adjoint of the Cholesky decomposition C = L L': Cbar = L^-T Phi(L' Lbar) L^-1,
+  // where Phi takes the lower triangle and halves the diagonal
+  Matrix phi = arma::trimatl(lt * sqrtbar);
+  phi.diag() *= 0.5;
+  Matrix tmp = arma::solve(arma::trimatu(lt), phi);
+  Matrix cbar = arma::solve(arma::trimatu(lt), tmp.t()).t();
+
+  // each correlation moves both symmetric entries
+  correlSens_ = cbar + cbar.t();
+  correlSens_.diag().zeros();
+}
+
+void MultiAssetBsMcPricer::computeControls(size_t npaths, Matrix& controls)
+{
+  size_t nsteps = paths_.n_slices;
+  size_t nassets = paths_.n_cols;
+  // discounted spots at the last fixing time
+  for (size_t j = 0; j < nassets; ++j) {
+    double const* spots = paths_.slice_colptr(nsteps - 1, j);
+    double* discspots = controls.colptr(j);
+    for (size_t p = 0; p < npaths; ++p)
+      discspots[p] = cvDiscount_ * spots[p];
+  }
+  // geometric average call, accumulating the logs of the spots
+  double* geocalls = controls.colptr(nassets);
+  fill(geocalls, geocalls + npaths, 0.0);
+  for (size_t i = 0; i < nsteps; ++i) {
+    for (size_t j = 0; j < nassets; ++j) {
+      double const* fixings = paths_.slice_colptr(i, j);
+      for (size_t p = 0; p < npaths; ++p)
+        geocalls[p] += log(fixings[p]);
+    }
+  }
+  double wgt = 1.0 / (nsteps * nassets);
+  double logspots = 0.0;
+  for (size_t j = 0; j < nassets; ++j)
+    logspots += log(spots_[j]);
+  logspots /= nassets;
+  for (size_t p = 0; p < npaths; ++p) {
+    double geoavg = exp(wgt * geocalls[p] - logspots);
+    geocalls[p] = cvDiscount_ * max(geoavg - cvGeoStrike_, 0.0);
+  }
+  // the controls keep their expectations under the likelihood ratios
+  for (size_t k = 0; k < controls.n_cols; ++k)
+    weightPaths(npaths, controls.colptr(k));
+}
+
+END_NAMESPACE(orf)
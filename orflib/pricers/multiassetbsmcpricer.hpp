@@ -1,91 +1,296 @@
-/**
-@file  multiassetbsmcpricer.hpp
-@brief Multiasset Monte Carlo pricer in the Black Scholes model
-*/
-
-#ifndef ORF_MULTIASSETBSMCPRICER_HPP
-#define ORF_MULTIASSETBSMCPRICER_HPP
-
-
-#include <orflib/products/product.hpp>
-#include <orflib/market/yieldcurve.hpp>
-#include <orflib/methods/montecarlo/mcparams.hpp>
-#include <orflib/methods/montecarlo/pathgenerator.hpp>
-#include <orflib/math/stats/statisticscalculator.hpp>
-
-BEGIN_NAMESPACE(orf)
-
-/** Multiasset Monte Carlo pricer in the Black-Scholes model (deterministic rates and vols).
-    Current constraint: all assets must be in the same economy, i.e. share the same yield curve.
-    */
-class MultiAssetBsMcPricer
-{
-
-public:
-  /** Initializing ctor */
-  MultiAssetBsMcPricer(SPtrProduct prod,
-                       SPtrYieldCurve discountYieldCurve,
-                       Vector const& divYields,
-                       Vector const& volatilities,
-                       Vector const& spots,
-                       Matrix const& correlMatrix,
-                       McParams const& mcparams);
-
-  /** Returns the number of variables that can be tracked for stats */
-  size_t nVariables();
-
-  /** Runs the simulation and collects statistics */
-  template<typename ITER>
-  void simulate(StatisticsCalculator<ITER>& statsCalc, unsigned long npaths);
-
-protected:
-
-  /** Creates and processes one price path.
-      It returns the PV of the product
-  */
-  double processOnePath(Matrix& pricePath);
-
-private:
-  SPtrProduct prod_;               // pointer to the product
-  SPtrYieldCurve discyc_;          // pointer to the discount curve
-  Vector divylds_;                 // the constant dividend yield, one per asset   
-  Vector vols_;                    // the constant volatility, one per asset
-  Vector spots_;                   // the initial spots, one per asset
-  McParams mcparams_;              // the Monte Carlo parameters
-
-  SPtrPathGenerator pathgen_;  // pointer to the path generator
-  Vector discfactors_;         // caches the pre-computed discount factors
-  Matrix drifts_;              // caches the pre-computed asset drifts, one column per asset
-  Matrix stdevs_;              // caches the pre-computed standard deviations, one column per asset 
-
-  Vector currspots_;           // scratch array with the current spots, one per asset
-  Vector payamts_;             // scratch array for writting the payments after each simulation
-};
-
-///////////////////////////////////////////////////////////////////////////////
-// Inline definitions
-
-inline
-size_t MultiAssetBsMcPricer::nVariables()
-{
-  return 1;  // just one variable, the price
-}
-
-template<typename ITER>
-void MultiAssetBsMcPricer::simulate(StatisticsCalculator<ITER>& statsCalc, unsigned long npaths)
-{
-  // create the price path matrix
-  Matrix pricePath(pathgen_->nTimeSteps(), pathgen_->nFactors());
-  // check the size of the statistics calculator
-  ORF_ASSERT(statsCalc.nVariables() == nVariables(), "the statistics calculator must track as many variables as the pricer captures!");
-
-  // This is the HOT loop
-  for (unsigned long i = 0; i < npaths; ++i) {
-    double pv = processOnePath(pricePath);
-    statsCalc.addSample(&pv, &pv + 1);
-  }
-}
-
-END_NAMESPACE(orf)
-
-#endif // ORF_MULTIASSETBSMCPRICER_HPP
+/**
+@file  multiassetbsmcpricer.hpp
+@brief Multiasset Monte Carlo pricer in the Black Scholes model
+*/
+
+#ifndef ORF_MULTIASSETBSMCPRICER_HPP
+#define ORF_MULTIASSETBSMCPRICER_HPP
+
+
+#include <orflib/products/product.hpp>
+#include <orflib/market/yieldcurve.hpp>
+#include <orflib/methods/montecarlo/mcparams.hpp>
+#include <orflib/methods/montecarlo/pathgenerator.hpp>
+#include <orflib/methods/montecarlo/controlvariate.hpp>
+#include <orflib/methods/montecarlo/lsmregression.hpp>
+#include <orflib/math/stats/statisticscalculator.hpp>
+#include <orflib/math/stats/meanvarcalculator.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+BEGIN_NAMESPACE(orf)
+
+/** Multiasset Monte Carlo pricer in the Black-Scholes model (deterministic rates and vols).
+    Current constraint: all assets must be in the same economy, i.e. share the same yield curve.
+    */
+class MultiAssetBsMcPricer
+{
+
+public:
+  /** Initializing ctor. The simulation is serial, so mcparams.nThreads must be 0. */
+  MultiAssetBsMcPricer(SPtrProduct prod,
+                       SPtrYieldCurve discountYieldCurve,
+                       Vector const& divYields,
+                       Vector const& volatilities,
+                       Vector const& spots,
+                       Matrix const& correlMatrix,
+                       McParams const& mcparams);
+
+  /** Returns the number of variables that can be tracked for stats: the PV and, if
+      mcparams.computeGreeks is set, its derivatives with respect to the spots and then to the
+      volatilities, one per asset. They are computed by adjoint differentiation of each path,
+      at a cost independent of the number of assets, and need a product with evalAdjoint().
+  */
+  size_t nVariables();
+
+  /** Returns the derivatives of the price with respect to the correlations, computed with the Greeks.
+      Entry (i, j) is the derivative with respect to the correlation of assets i and j, moving both
+      symmetric entries of the matrix; the diagonal is zero. They are averages over the paths of the
+      last simulation, without statistics, and need a positive definite correlation matrix.
+  */
+  Matrix const& correlSensitivities() const;
+
+  /** Importance sampling: shifts the means of the independent normal deviates that drive the paths,
+      see PathGenerator::setDriftShift(), and weights the samples of each path, PV, Greeks and
+      controls, by its likelihood ratio. Shifting the paths towards the region where a rare payoff
+      pays, e.g. a far out-of-the-money digital or worst-of put, lowers the variance by orders of
+      magnitude. The shift has one row per fixing time and one column per asset, an empty matrix
+      removes it. It needs the EULER path generator and a product without early exercise.
+      With conditional Monte Carlo, the deviate integrated in closed form is not shifted.
+  */
+  void setDriftShift(Matrix const& shift);
+
+  /** Returns the drift shift of importance sampling, empty without it */
+  Matrix const& driftShift() const;
+
+  /** Finds a drift shift by the cross-entropy method and sets it, see setDriftShift().
+      The shift is the mean of the independent deviates of the pilot paths, weighted by their
+      absolute PVs and likelihood ratios, over niters rounds of npaths pilot paths, each simulated
+      with the shift of the previous round and the first with the current shift. The pilot paths
+      are simulated ahead of the pricing paths. Products with conditional payoffs are scored by them
+      with conditional Monte Carlo, which are positive even far from the money; the others need
+      some paying pilot paths, so events too rare for them need a rough first shift set by
+      setDriftShift(). It needs a product without early termination, and returns the shift.
+  */
+  Matrix const& optimizeDriftShift(unsigned long npaths = 8 * McParams::PATHBLOCKSIZE, size_t niters = 4);
+
+  /** Runs the simulation and collects statistics.
+      With the CONTROLVARIATE control variate type the PVs are adjusted one block of
+      McParams::PATHBLOCKSIZE paths at a time, with controls priced in closed form:
+      the discounted spot of each asset at the last fixing time, and an at-the-money call on the
+      geometric average of the spots relative to their initial values, over all fixings and assets.
+      With the CONDITIONAL type, the product, e.g. a worst-of digital, pays its expected payments
+      over the normalized sum of the correlated deviates of the last time step, in closed form,
+      see Product::finalizeConditional(). Every asset loads on that deviate, but the deviates
+      orthogonal to it are simulated, so for several assets the payoff is smoothed along that one
+      direction only.
+      For products with early exercise, the exercise policy is first estimated by Longstaff-Schwartz
+      regression on mcparams.nLsmPaths paths, simulated ahead of the pricing paths.
+  */
+  template<typename ITER>
+  void simulate(StatisticsCalculator<ITER>& statsCalc, unsigned long npaths);
+
+  /** Runs the simulation until the standard error of the mean PV meets the target, or the
+      path or time budget of the target runs out, checking after each block of
+      McParams::PATHBLOCKSIZE paths. It rejects the STRATIFIED and LATINHYPERCUBE urng types,
+      whose standard error overstates the actual one.
+      It returns the number of paths simulated.
+  */
+  template<typename ITER>
+  unsigned long simulateToTolerance(MeanVarCalculator<ITER>& statsCalc, McErrorTarget const& target);
+
+protected:
+
+  /** Simulates up to npaths paths and passes the PVs to the statistics calculator in path order.
+      After each block of McParams::PATHBLOCKSIZE paths it calls stop(n), with n the number of
+      paths simulated so far, and ends the simulation if it returns true.
+      It returns the number of paths simulated.
+  */
+  template<typename ITER, typename STOP>
+  unsigned long runSimulation(StatisticsCalculator<ITER>& statsCalc, unsigned long npaths, STOP stop);
+
+  /** Creates a batch of npaths price paths in paths_ */
+  void generatePaths(size_t npaths);
+
+  /** Creates a batch of npaths paths and evaluates the product on them with the streaming
+      evaluation, one time step at a time, writing the payments into payamts_.
+      Only the correlated normal deviates of the batch are stored, not the price paths. For products
+      with early termination, the paths decided by the product are not simulated any further.
+      With conditional Monte Carlo, the product integrates the last time step in closed form.
+  */
+  void streamPaths(size_t npaths);
+
+  /** Moves the spots of the active paths in currspots_ to the last time step, given its correlated
+      deviates, one column per asset, without the independent deviate integrated by conditional
+      Monte Carlo. The rows of the other paths, in currspots_ and devs, are not read.
+  */
+  void conditionalSpots(Matrix const& devs);
+
+  /** Moves the spots of the active paths in currspots_ to time step i of the lazy batch */
+  void stepActive(size_t i);
+
+  /** Creates a batch of npaths paths one time step at a time, and writes into pvs their PVs
+      following the exercise policy. The paths are not simulated beyond their exercise time.
+  */
+  void exercisePaths(size_t npaths, double* pvs);
+
+  /** Creates and processes a batch of npaths price paths.
+      It writes the samples of each path into the first npaths rows of samples,
+      the PV in the first column and the Greeks, if any, in the following ones.
+  */
+  void processPaths(size_t npaths, Matrix& samples);
+
+  /** Writes into pvs the PVs of the first npaths rows of payments in payamts_ */
+  void batchPVs(size_t npaths, double* pvs) const;
+
+  /** Multiplies the npaths values by the likelihood ratios of the paths last generated,
+      with importance sampling
+  */
+  void weightPaths(size_t npaths, double* values) const;
+
+  /** Propagates the adjoints of the prices in pathBars_ back through the batch of npaths paths.
+      It writes the spot and volatility derivatives into samples, and adds the products of the
+      adjoints and the correlated deviates to correlBar_.
+  */
+  void adjointPaths(size_t npaths, Matrix& samples);
+
+  /** Computes correlSens_ from correlBar_, accumulated over npaths paths, through the adjoint
+      of the Cholesky decomposition.
+  */
+  void computeCorrelSensitivities(unsigned long npaths);
+
+  /** Estimates the exercise policy on mcparams.nLsmPaths paths */
+  void calibrateExercise();
+
+  /** Computes the control variates on the batch of npaths paths last processed.
+      It writes them into the first npaths rows of controls, one column per control.
+  */
+  void computeControls(size_t npaths, Matrix& controls);
+
+private:
+  SPtrProduct prod_;               // pointer to the product
+  SPtrYieldCurve discyc_;          // pointer to the discount curve
+  Vector divylds_;                 // the constant dividend yield, one per asset   
+  Vector vols_;                    // the constant volatility, one per asset
+  Vector spots_;                   // the initial spots, one per asset
+  McParams mcparams_;              // the Monte Carlo parameters
+
+  SPtrPathGenerator pathgen_;  // pointer to the path generator
+  Vector discfactors_;         // caches the pre-computed discount factors
+  Matrix drifts_;              // caches the pre-computed asset drifts, one column per asset
+  Matrix stdevs_;              // caches the pre-computed standard deviations, one column per asset 
+  Vector sqrtdts_;             // caches the square roots of the time steps, for the Greeks
+  Vector condloadings_;        // the loadings of the assets on the integrated deviate, empty without
+                               // conditional Monte Carlo
+  Vector condweights_;         // the integrated deviate is the dot product of these and the correlated ones
+  Vector condcol_;             // the correlated deviates are condcol_ times the integrated one, plus the rest
+
+  Matrix payamts_;             // scratch matrix with the payments of a batch, one row per path
+  Matrix states_;              // scratch matrix with the states of the streaming evaluation, one row per path
+  Matrix currspots_;           // scratch matrix with the current spots of a batch, one column per asset
+  Matrix stepdevs_;            // scratch matrix with the deviates of one time step of a lazy batch
+  std::vector<size_t> active_; // the paths of a lazy batch still simulated, in increasing order
+  Cube paths_;                 // scratch cube with a batch of paths, one slice per time step
+  Matrix pricePath_;           // scratch matrix with one price path of the batch
+  Cube devs_;                  // scratch cube with the correlated deviates of the batch, for the Greeks
+  Cube pathBars_;              // scratch cube with the adjoints of the prices of the batch
+  Matrix pathBar_;             // scratch matrix with the adjoints of one price path
+  Matrix logBar_;              // scratch matrix with the adjoints of the log prices of one time step
+  Matrix devBar_;              // scratch matrix with the adjoints of the deviates of one time step
+  Matrix correlBar_;           // sum over the paths of the deviate adjoints times the deviates
+  Matrix correlSens_;          // the correlation sensitivities of the last simulation
+  Matrix samples_;             // scratch matrix with the samples of the paths, one column per variable
+
+  std::shared_ptr<ControlVariate> cv_;  // the control variate estimator, null if not used
+  double cvDiscount_;          // discount factor to the last fixing time, for the controls
+  double cvGeoStrike_;         // strike of the geometric average control, its forward
+  Matrix controls_;            // scratch matrix with the control variates, one column per control
+
+  std::shared_ptr<LsmRegression> lsm_;  // the exercise policy, null for products without early exercise
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+inline
+size_t MultiAssetBsMcPricer::nVariables()
+{
+  // the price, and the spot and volatility derivatives
+  return mcparams_.computeGreeks ? 1 + 2 * prod_->nAssets() : 1;
+}
+
+inline
+Matrix const& MultiAssetBsMcPricer::driftShift() const
+{
+  return pathgen_->driftShift();
+}
+
+inline
+Matrix const& MultiAssetBsMcPricer::correlSensitivities() const
+{
+  return correlSens_;
+}
+
+template<typename ITER>
+void MultiAssetBsMcPricer::simulate(StatisticsCalculator<ITER>& statsCalc, unsigned long npaths)
+{
+  runSimulation(statsCalc, npaths, [](unsigned long) { return false; });
+}
+
+template<typename ITER>
+unsigned long MultiAssetBsMcPricer::simulateToTolerance(MeanVarCalculator<ITER>& statsCalc,
+                                                        McErrorTarget const& target)
+{
+  ORF_ASSERT(!mcparams_.hasStratifiedPaths(),
+    "the standard error of stratified paths overstates the error, simulate a number of paths instead!");
+  auto start = std::chrono::steady_clock::now();
+  return runSimulation(statsCalc, target.maxPaths, [&](unsigned long npaths) {
+    Matrix const& res = statsCalc.results();
+    double stdErr = std::sqrt(std::max(res(1, 0), 0.0) / statsCalc.nSamples());
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return target.isDone(res(0, 0), stdErr, npaths, elapsed.count());
+  });
+}
+
+template<typename ITER, typename STOP>
+unsigned long MultiAssetBsMcPricer::runSimulation(StatisticsCalculator<ITER>& statsCalc,
+                                                  unsigned long npaths, STOP stop)
+{
+  // check the size of the statistics calculator
+  ORF_ASSERT(statsCalc.nVariables() == nVariables(), "the statistics calculator must track as many variables as the pricer captures!");
+  samples_.set_size(McParams::PATHBLOCKSIZE, nVariables());
+  // the control variate coefficients are estimated afresh in each simulation
+  if (cv_) {
+    cv_->reset();
+    controls_.set_size(McParams::PATHBLOCKSIZE, cv_->nControls());
+  }
+  // and so is the exercise policy
+  if (lsm_)
+    calibrateExercise();
+  if (mcparams_.computeGreeks)
+    correlBar_.zeros(prod_->nAssets(), prod_->nAssets());
+
+  // This is the HOT loop, over batches of paths
+  unsigned long ndone = 0;
+  while (ndone < npaths) {
+    size_t n = std::min<unsigned long>(McParams::PATHBLOCKSIZE, npaths - ndone);
+    processPaths(n, samples_);
+    if (cv_) {
+      computeControls(n, controls_);
+      cv_->adjust(n, samples_.colptr(0), controls_);
+    }
+    statsCalc.addSamples(samples_, 0, n);
+    ndone += n;
+    if (stop(ndone))
+      break;
+  }
+  if (mcparams_.computeGreeks)
+    computeCorrelSensitivities(ndone);
+  return ndone;
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_MULTIASSETBSMCPRICER_HPP
@@ -0,0 +1,232 @@
+/**
+@file  portfoliobsmcpricer.cpp
+@brief Implementation of the PortfolioBsMcPricer class
+*/
+
+#include <orflib/pricers/portfoliobsmcpricer.hpp>
+#include <orflib/methods/montecarlo/pathgeneratorfactory.hpp>
+#include <orflib/methods/montecarlo/antitheticpathgenerator.hpp>
+
+#include <cmath>
+
+using namespace std;
+
+BEGIN_NAMESPACE(orf)
+
+// total degree of the polynomials in the spots of the Longstaff-Schwartz regression
+static const size_t LSMDEGREE = 2;
+
+PortfolioBsMcPricer::PortfolioBsMcPricer(std::vector<SPtrProduct> const& prods,
+                                         SPtrYieldCurve discountCurve,
+                                         Vector const& divYields,
+                                         Vector const& volatilities,
+                                         Vector const& spots,
+                                         Matrix const& correlMatrix,
+                                         McParams const& mcparams,
+                                         Vector const& quantities)
+: prods_(prods), quantities_(quantities), discyc_(discountCurve), divylds_(divYields),
+vols_(volatilities), spots_(spots), mcparams_(mcparams)
+{
+  size_t nprods = prods.size();
+  ORF_ASSERT(nprods > 0, "the portfolio has no products!");
+  ORF_ASSERT(mcparams.nThreads == 0, "the portfolio pricer simulates serially, nThreads must be 0!");
+  if (quantities_.is_empty())
+    quantities_.ones(nprods);
+  ORF_ASSERT(quantities_.size() == nprods, "need as many quantities as products!");
+  ORF_ASSERT(mcparams.controlVarType != McParams::ControlVarType::CONTROLVARIATE,
+    "the portfolio pricer does not support control variates!");
+  ORF_ASSERT(mcparams.controlVarType != McParams::ControlVarType::CONDITIONAL,
+    "the portfolio pricer does not support conditional Monte Carlo!");
+
+  // Get the number of assets (factors) and check inputs for size.
+  size_t nassets = prods[0]->nAssets();
+  for (size_t k = 1; k < nprods; ++k)
+    ORF_ASSERT(prods[k]->nAssets() == nassets, "all the products must depend on the same assets!");
+  ORF_ASSERT(divYields.size() == nassets, "need as many div yields as product assets!");
+  ORF_ASSERT(volatilities.size() == nassets, "need as many volatilities as product assets!");
+  ORF_ASSERT(spots.size() == nassets, "need as many spots as product assets!");
+  if (nassets > 1) {
+    ORF_ASSERT(correlMatrix.is_square(), "the correlation matrix must be square!");
+    ORF_ASSERT(correlMatrix.n_rows == nassets, "need as many correlation matrix rows as product assets!");
+  }
+
+  // Merge the fixing times of all the products into the simulation grid
+  std::vector<double> times;
+  for (size_t k = 0; k < nprods; ++k) {
+    Vector const& fixtimes = prods[k]->fixTimes();
+    times.insert(times.end(), fixtimes.begin(), fixtimes.end());
+  }
+  sort(times.begin(), times.end());
+  times.erase(unique(times.begin(), times.end()), times.end());
+  simtimes_ = Vector(times);
+  fixRows_.resize(nprods);
+  fixIdx_.assign(nprods, std::vector<ptrdiff_t>(times.size(), -1));
+  for (size_t k = 0; k < nprods; ++k) {
+    Vector const& fixtimes = prods[k]->fixTimes();
+    for (size_t i = 0; i < fixtimes.size(); ++i) {
+      fixRows_[k].push_back(lower_bound(times.begin(), times.end(), fixtimes[i]) - times.begin());
+      fixIdx_[k][fixRows_[k].back()] = i;
+    }
+  }
+
+  // Create the path generator, one factor per asset
+  pathgen_ = createPathGenerator(mcparams, simtimes_.begin(), simtimes_.end(), nassets, correlMatrix);
+  if (mcparams.controlVarType == McParams::ControlVarType::ANTITHETIC)
+    pathgen_ = SPtrPathGenerator(new AntitheticPathGenerator(pathgen_));
+
+  // Pre-compute the stdevs and drifts from time step to time step
+  size_t nsteps = simtimes_.size();
+  drifts_.resize(nsteps, nassets);
+  stdevs_.resize(nsteps, nassets);
+  for (size_t j = 0; j < nassets; ++j) {
+    double t1 = 0.0;
+    for (size_t i = 0; i < nsteps; ++i) {
+      double t2 = simtimes_[i];
+      double var = vols_[j] * vols_[j] * (t2 - t1);
+      stdevs_(i, j) = sqrt(var);
+      double fwdrate = t2 > t1 ? discyc_->fwdRate(t1, t2) : 0.0;  // e.g. a fixing at time 0
+      // risk free rate less yield plus convexity adjustment
+      drifts_(i, j) = (fwdrate - divylds_[j]) * (t2 - t1) - 0.5 * var;
+      t1 = t2;
+    }
+  }
+
+  // Pre-compute the discount factors of each product, and set up the exercise policies
+  discfactors_.resize(nprods);
+  lsms_.resize(nprods);
+  pricePaths_.resize(nprods);
+  states_.resize(nprods);
+  for (size_t k = 0; k < nprods; ++k) {
+    Vector const& paytimes = prods[k]->payTimes();
+    discfactors_[k].resize(paytimes.size());
+    for (size_t i = 0; i < paytimes.size(); ++i)
+      discfactors_[k][i] = discyc_->discount(paytimes[i]);
+    if (prods[k]->hasEarlyExercise()) {
+      ORF_ASSERT(paytimes.size() == fixRows_[k].size(), "early exercise needs one payment time per fixing time!");
+      ORF_ASSERT(mcparams.nLsmPaths > 0, "early exercise needs paths for the Longstaff-Schwartz regression!");
+      lsms_[k] = make_shared<LsmRegression>(spots_, LSMDEGREE);
+    }
+    pricePaths_[k].set_size(fixRows_[k].size(), nassets);
+  }
+}
+
+void PortfolioBsMcPricer::generatePaths(size_t npaths)
+{
+  pathgen_->nextBatch(npaths, paths_);
+  size_t nassets = paths_.n_cols;
+  // convert the normal deviates to price paths in-place, one time step and asset at a time
+  for (size_t i = 0; i < paths_.n_slices; ++i) {
+    for (size_t j = 0; j < nassets; ++j) {
+      double* spots = paths_.slice_colptr(i, j);
+      double const* prevspots = i > 0 ? paths_.slice_colptr(i - 1, j) : nullptr;
+      double drift = drifts_(i, j);
+      double stdev = stdevs_(i, j);
+      for (size_t p = 0; p < npaths; ++p) {
+        double spot = i > 0 ? prevspots[p] : spots_[j];
+        spots[p] = spot * exp(drift + stdev * spots[p]);
+      }
+    }
+  }
+}
+
+void PortfolioBsMcPricer::processPaths(size_t npaths)
+{
+  pathgen_->nextBatch(npaths, paths_);
+  size_t nprods = prods_.size();
+  size_t nassets = paths_.n_cols;
+  // the products with early exercise need the whole price paths
+  bool storepaths = std::any_of(lsms_.begin(), lsms_.end(), [](std::shared_ptr<LsmRegression> const& lsm) { return bool(lsm); });
+
+  // move the spots to each simulation time, and pass them on to the products that fix there
+  for (size_t k = 0; k < nprods; ++k)
+    if (!lsms_[k])
+      prods_[k]->resetState(npaths, states_[k]);
+  currspots_.set_size(npaths, nassets);
+  for (size_t i = 0; i < paths_.n_slices; ++i) {
+    for (size_t j = 0; j < nassets; ++j) {
+      double* spots = currspots_.colptr(j);
+      double* devs = paths_.slice_colptr(i, j);
+      double drift = drifts_(i, j);
+      double stdev = stdevs_(i, j);
+      for (size_t p = 0; p < npaths; ++p) {
+        double spot = i > 0 ? spots[p] : spots_[j];
+        spots[p] = spot * exp(drift + stdev * devs[p]);
+      }
+      if (storepaths)
+        std::copy(spots, spots + npaths, devs);
+    }
+    for (size_t k = 0; k < nprods; ++k)
+      if (!lsms_[k] && fixIdx_[k][i] >= 0)
+        prods_[k]->updateState(fixIdx_[k][i], currspots_, states_[k]);
+  }
+
+  // evaluate each product on its fixings of each path
+  for (size_t k = 0; k < nprods; ++k) {
+    Product& prod = *prods_[k];
+    std::vector<size_t> const& rows = fixRows_[k];
+    Vector const& discfactors = discfactors_[k];
+    double* pvs = samples_.colptr(k);
+    if (lsms_[k]) {
+      Matrix& pricePath = pricePaths_[k];
+      for (size_t p = 0; p < npaths; ++p) {
+        for (size_t i = 0; i < rows.size(); ++i)
+          for (size_t j = 0; j < nassets; ++j)
+            pricePath(i, j) = paths_(p, j, rows[i]);
+        pvs[p] = lsms_[k]->exercisePV(prod, pricePath, discfactors);
+      }
+      continue;
+    }
+
+    // the others pay from the states of the streaming evaluation
+    prod.finalizeState(states_[k], payamts_);
+    for (size_t p = 0; p < npaths; ++p)
+      pvs[p] = 0.0;
+    for (size_t m = 0; m < payamts_.n_cols; ++m) {
+      double const* payamts = payamts_.colptr(m);
+      double df = discfactors[m];
+      for (size_t p = 0; p < npaths; ++p)
+        pvs[p] += df * payamts[p];
+    }
+  }
+
+  // the portfolio PV
+  double* pvs = samples_.colptr(nprods);
+  std::fill(pvs, pvs + npaths, 0.0);
+  for (size_t k = 0; k < nprods; ++k) {
+    double const* prodpvs = samples_.colptr(k);
+    double qty = quantities_[k];
+    for (size_t p = 0; p < npaths; ++p)
+      pvs[p] += qty * prodpvs[p];
+  }
+}
+
+void PortfolioBsMcPricer::calibrateExercise()
+{
+  if (std::none_of(lsms_.begin(), lsms_.end(), [](std::shared_ptr<LsmRegression> const& lsm) { return bool(lsm); }))
+    return;
+
+  // the regression paths on the whole grid, ahead of the pricing paths
+  size_t blocksize = McParams::PATHBLOCKSIZE;
+  size_t nlsmpaths = mcparams_.nLsmPaths;
+  size_t nassets = spots_.size();
+  Cube lsmpaths(nlsmpaths, nassets, simtimes_.size());
+  for (size_t k = 0; k < nlsmpaths; k += blocksize) {
+    size_t n = min(blocksize, nlsmpaths - k);
+    generatePaths(n);
+    lsmpaths.subcube(k, 0, 0, k + n - 1, nassets - 1, paths_.n_slices - 1) = paths_;
+  }
+
+  // each product regresses on its own fixings
+  Cube prodpaths;
+  for (size_t k = 0; k < prods_.size(); ++k) {
+    if (!lsms_[k])
+      continue;
+    std::vector<size_t> const& rows = fixRows_[k];
+    prodpaths.set_size(nlsmpaths, nassets, rows.size());
+    for (size_t i = 0; i < rows.size(); ++i)
+      prodpaths.slice(i) = lsmpaths.slice(rows[i]);
+    lsms_[k]->calibrate(*prods_[k], prodpaths, discfactors_[k]);
+  }
+}
+
+END_NAMESPACE(orf)
@@ -0,0 +1,141 @@
+/**
+@file  portfoliobsmcpricer.hpp
+@brief Monte Carlo pricer of a portfolio of products in the Black Scholes model
+*/
+
+#ifndef ORF_PORTFOLIOBSMCPRICER_HPP
+#define ORF_PORTFOLIOBSMCPRICER_HPP
+
+#include <orflib/products/product.hpp>
+#include <orflib/market/yieldcurve.hpp>
+#include <orflib/methods/montecarlo/mcparams.hpp>
+#include <orflib/methods/montecarlo/pathgenerator.hpp>
+#include <orflib/methods/montecarlo/lsmregression.hpp>
+#include <orflib/math/stats/statisticscalculator.hpp>
+#include <algorithm>
+#include <vector>
+
+BEGIN_NAMESPACE(orf)
+
+/** Multiasset Monte Carlo pricer of a portfolio of products in the Black-Scholes model
+    (deterministic rates and vols). All the products depend on the same assets.
+    The fixing times of all the products are merged into one simulation grid, so each path is
+    generated once and every product is evaluated on its own fixing times of that path.
+    The PVs of the products thus use common random numbers.
+    Products with early exercise follow a Longstaff-Schwartz policy estimated, for each of them,
+    on the same mcparams.nLsmPaths paths, simulated ahead of the pricing paths.
+*/
+class PortfolioBsMcPricer
+{
+
+public:
+  /** Initializing ctor.
+      The quantities weigh the products in the portfolio PV; all ones if empty.
+      The simulation is serial, so mcparams.nThreads must be 0.
+  */
+  PortfolioBsMcPricer(std::vector<SPtrProduct> const& prods,
+                      SPtrYieldCurve discountYieldCurve,
+                      Vector const& divYields,
+                      Vector const& volatilities,
+                      Vector const& spots,
+                      Matrix const& correlMatrix,
+                      McParams const& mcparams,
+                      Vector const& quantities = Vector());
+
+  /** Returns the number of products */
+  size_t nProducts() const;
+
+  /** Returns the number of variables that can be tracked for stats: the PV of each product,
+      for one unit, and then the PV of the portfolio.
+  */
+  size_t nVariables() const;
+
+  /** Returns the simulation grid, the merged fixing times of all the products */
+  Vector const& simulationTimes() const;
+
+  /** Runs the simulation and collects statistics */
+  template<typename ITER>
+  void simulate(StatisticsCalculator<ITER>& statsCalc, unsigned long npaths);
+
+protected:
+  /** Creates a batch of npaths price paths in paths_, one slice per simulation time */
+  void generatePaths(size_t npaths);
+
+  /** Creates and processes a batch of npaths paths.
+      The products without early exercise are evaluated with the streaming evaluation, one
+      simulation time at a time, and the price paths are stored in paths_ only if some product
+      has early exercise.
+      It writes the samples of each path into the first npaths rows of samples_.
+  */
+  void processPaths(size_t npaths);
+
+  /** Estimates the exercise policies of the products with early exercise */
+  void calibrateExercise();
+
+private:
+  std::vector<SPtrProduct> prods_;  // pointers to the products
+  Vector quantities_;               // the quantities of the products
+  SPtrYieldCurve discyc_;           // pointer to the discount curve
+  Vector divylds_;                  // the constant dividend yield, one per asset
+  Vector vols_;                     // the constant volatility, one per asset
+  Vector spots_;                    // the initial spots, one per asset
+  McParams mcparams_;               // the Monte Carlo parameters
+
+  Vector simtimes_;                 // the simulation grid
+  std::vector<std::vector<size_t>> fixRows_;  // for each product, the grid index of each of its fixings
+  std::vector<std::vector<ptrdiff_t>> fixIdx_;  // for each product, the index of its fixing at each grid time, -1 if none
+  SPtrPathGenerator pathgen_;       // pointer to the path generator
+  std::vector<Vector> discfactors_; // for each product, the discount factors to its payment times
+  Matrix drifts_;                   // caches the pre-computed asset drifts, one column per asset
+  Matrix stdevs_;                   // caches the pre-computed standard deviations, one column per asset
+  std::vector<std::shared_ptr<LsmRegression>> lsms_;  // the exercise policies, null for products without early exercise
+
+  Cube paths_;                      // scratch cube with a batch of paths, one slice per simulation time
+  std::vector<Matrix> pricePaths_;  // scratch matrices with one price path of each product
+  Matrix currspots_;                // scratch matrix with the current spots of a batch, one column per asset
+  std::vector<Matrix> states_;      // scratch matrices with the states of the streaming evaluation of each product
+  Matrix payamts_;                  // scratch matrix with the payments of a batch, one row per path
+  Matrix samples_;                  // scratch matrix with the samples of the paths, one column per variable
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+inline
+size_t PortfolioBsMcPricer::nProducts() const
+{
+  return prods_.size();
+}
+
+inline
+size_t PortfolioBsMcPricer::nVariables() const
+{
+  return prods_.size() + 1;
+}
+
+inline
+Vector const& PortfolioBsMcPricer::simulationTimes() const
+{
+  return simtimes_;
+}
+
+template<typename ITER>
+void PortfolioBsMcPricer::simulate(StatisticsCalculator<ITER>& statsCalc, unsigned long npaths)
+{
+  // check the size of the statistics calculator
+  ORF_ASSERT(statsCalc.nVariables() == nVariables(), "the statistics calculator must track as many variables as the pricer captures!");
+  // the exercise policies are estimated afresh in each simulation
+  calibrateExercise();
+
+  samples_.set_size(McParams::PATHBLOCKSIZE, nVariables());
+  // This is the HOT loop, over batches of paths
+  for (unsigned long i = 0; i < npaths; i += McParams::PATHBLOCKSIZE) {
+    size_t n = std::min<unsigned long>(McParams::PATHBLOCKSIZE, npaths - i);
+    processPaths(n);
+    statsCalc.addSamples(samples_, 0, n);
+  }
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_PORTFOLIOBSMCPRICER_HPP
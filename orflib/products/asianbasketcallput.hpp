@@ -1,114 +1,237 @@
-/**
-@file  asianbasketcallput.hpp
-@brief The payoff of an Asian Call/Put option on a basket of assets
-*/
-
-#ifndef ORF_ASIANBASKETCALLPUT_HPP
-#define ORF_ASIANBASKETCALLPUT_HPP
-
-#include <orflib/products/product.hpp>
-#include <algorithm>
-#include <functional>
-
-BEGIN_NAMESPACE(orf)
-
-/** The Asian basket call/put class
-*/
-class AsianBasketCallPut : public Product
-{
-public:
-  /** Initializing ctor */
-  AsianBasketCallPut(int payoffType,
-                     double strike,
-                     Vector const& fixingTimes,
-                     Vector const& assetQuantities);
-
-  /** The number of assets this product depends on */
-  virtual size_t nAssets() const override;
-
-  /** Evaluates the product given the passed-in path
-      The "pricePath" matrix must have as many rows as
-      the number of fixing times
-      */
-  virtual void eval(Matrix const& pricePath) override;
-
-  /** Evaluates the product at fixing time index idx
-  */
-  virtual void eval(size_t idx, Vector const& spots, double contValue) override;
-
-private:
-  int payoffType_;          // 1: call; -1 put
-  double strike_;
-  Vector assetQuantities_;  // number of units of each asset in the basket
-};
-
-///////////////////////////////////////////////////////////////////////////////
-// Inline definitions
-
-inline
-AsianBasketCallPut::AsianBasketCallPut(int payoffType,
-                                       double strike,
-                                       Vector const& fixingTimes,
-                                       Vector const& assetQuantities)
-: payoffType_(payoffType), strike_(strike), assetQuantities_(assetQuantities)
-{
-  ORF_ASSERT(payoffType == 1 || payoffType == -1, "AsianBasketCallPut: the payoff type must be 1 (call) or -1 (put)!");
-  ORF_ASSERT(strike >= 0.0, "AsianBasketCallPut: the strike must be positive!");
-  ORF_ASSERT(fixingTimes[0] >= 0.0,
-    "AsianBasketCallPut: the first fixing time must be non-negative!");
-  Vector::const_iterator it(
-    std::adjacent_find(fixingTimes.begin(), fixingTimes.end(), std::greater_equal<double>()));
-  ORF_ASSERT(it == fixingTimes.end(),
-    "AsianBasketCallPut: the fixing times must be in strict increasing order");
-
-  // set the fixing times
-  fixTimes_ = fixingTimes;
-  // assume that it will settle (pay) at expiration
-  // TODO allow payment time later than expiration
-  payTimes_.resize(1);
-  payTimes_[0] = fixingTimes[fixingTimes.size() - 1];
-
-  // this product generates only one payment
-  payAmounts_.resize(1);
-}
-
-inline
-size_t AsianBasketCallPut::nAssets() const
-{
-  return assetQuantities_.size();
-}
-
-inline void AsianBasketCallPut::eval(Matrix const& pricePath)
-{
-  double bsktAvg = 0;
-  size_t nfixings = pricePath.n_rows;
-  ORF_ASSERT(fixTimes_.size() == nfixings,
-    "AsianBasketCallPut: number of fixings mismatch in price path!");
-  size_t nassets = pricePath.n_cols;
-  ORF_ASSERT(assetQuantities_.size() == nassets,
-    "AsianBasketCallPut: number of assets mismatch in price path!");
-
-  for (size_t i = 0; i < nfixings; ++i) {
-    double bsktval = 0.0;
-    for (size_t j = 0; j < nassets; ++j) {
-      bsktval += assetQuantities_[j] * pricePath(i, j);
-    }
-    bsktAvg += bsktval;
-  }
-  bsktAvg /= nfixings;
-
-  if (payoffType_ == 1)
-    payAmounts_[0] = bsktAvg >= strike_ ? bsktAvg - strike_ : 0.0;
-  else
-    payAmounts_[0] = bsktAvg >= strike_ ? 0.0 : strike_ - bsktAvg;
-}
-
-// Not implemented
-inline void AsianBasketCallPut::eval(size_t idx, Vector const& spots, double contValue)
-{
-  ORF_ASSERT(0, "not implemented!");
-}
-
-END_NAMESPACE(orf)
-
-#endif // ORF_ASIANBASKETCALLPUT_HPP
+/**
+@file  asianbasketcallput.hpp
+@brief The payoff of an Asian Call/Put option on a basket of assets
+*/
+
+#ifndef ORF_ASIANBASKETCALLPUT_HPP
+#define ORF_ASIANBASKETCALLPUT_HPP
+
+#include <orflib/products/product.hpp>
+#include <algorithm>
+#include <functional>
+
+BEGIN_NAMESPACE(orf)
+
+/** The Asian basket call/put class
+*/
+class AsianBasketCallPut : public Product
+{
+public:
+  /** Initializing ctor */
+  AsianBasketCallPut(int payoffType,
+                     double strike,
+                     Vector const& fixingTimes,
+                     Vector const& assetQuantities);
+
+  /** The number of assets this product depends on */
+  virtual size_t nAssets() const override;
+
+  /** The call/put payoff is Lipschitz in the basket average */
+  virtual bool isLipschitz() const override { return true; }
+
+  /** Returns a copy of this product */
+  virtual SPtrProduct clone() const override;
+
+  /** Evaluates the product given the passed-in path
+      The "pricePath" matrix must have as many rows as
+      the number of fixing times
+      */
+  virtual void eval(Matrix const& pricePath) override;
+
+  /** Evaluates the product on a batch of paths */
+  virtual void evalBatch(Cube const& paths, Matrix& payAmounts) const override;
+
+  /** In the streaming evaluation, the state of a path is the running sum of the basket values */
+  virtual size_t stateSize() const override;
+
+  /** Starts the streaming evaluation of a batch of paths */
+  virtual void resetState(size_t npaths, Matrix& states) const override;
+
+  /** Updates the states of a batch of paths with the spots at fixing time index idx */
+  virtual void updateState(size_t idx, Matrix const& spots, Matrix& states) const override;
+
+  /** Computes the payments of a batch of paths from their states */
+  virtual void finalizeState(Matrix const& states, Matrix& payAmounts) const override;
+
+  /** The state is the running sum of the basket values */
+  virtual bool hasAdditiveState() const override { return true; }
+
+  /** Evaluates the product and its adjoint on the passed-in path */
+  virtual void evalAdjoint(Matrix const& pricePath, Vector const& payBar, Matrix& pathBar) override;
+
+  /** Evaluates the product at fixing time index idx
+  */
+  virtual void eval(size_t idx, Vector const& spots, double contValue) override;
+
+private:
+  int payoffType_;          // 1: call; -1 put
+  double strike_;
+  Vector assetQuantities_;  // number of units of each asset in the basket
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+inline
+AsianBasketCallPut::AsianBasketCallPut(int payoffType,
+                                       double strike,
+                                       Vector const& fixingTimes,
+                                       Vector const& assetQuantities)
+: payoffType_(payoffType), strike_(strike), assetQuantities_(assetQuantities)
+{
+  ORF_ASSERT(payoffType == 1 || payoffType == -1, "AsianBasketCallPut: the payoff type must be 1 (call) or -1 (put)!");
+  ORF_ASSERT(strike >= 0.0, "AsianBasketCallPut: the strike must be positive!");
+  ORF_ASSERT(fixingTimes[0] >= 0.0,
+    "AsianBasketCallPut: the first fixing time must be non-negative!");
+  Vector::const_iterator it(
+    std::adjacent_find(fixingTimes.begin(), fixingTimes.end(), std::greater_equal<double>()));
+  ORF_ASSERT(it == fixingTimes.end(),
+    "AsianBasketCallPut: the fixing times must be in strict increasing order");
+
+  // set the fixing times
+  fixTimes_ = fixingTimes;
+  // assume that it will settle (pay) at expiration
+  // TODO allow payment time later than expiration
+  payTimes_.resize(1);
+  payTimes_[0] = fixingTimes[fixingTimes.size() - 1];
+
+  // this product generates only one payment
+  payAmounts_.resize(1);
+}
+
+inline
+SPtrProduct AsianBasketCallPut::clone() const
+{
+  return SPtrProduct(new AsianBasketCallPut(*this));
+}
+
+inline
+size_t AsianBasketCallPut::nAssets() const
+{
+  return assetQuantities_.size();
+}
+
+inline void AsianBasketCallPut::eval(Matrix const& pricePath)
+{
+  double bsktAvg = 0;
+  size_t nfixings = pricePath.n_rows;
+  ORF_ASSERT(fixTimes_.size() == nfixings,
+    "AsianBasketCallPut: number of fixings mismatch in price path!");
+  size_t nassets = pricePath.n_cols;
+  ORF_ASSERT(assetQuantities_.size() == nassets,
+    "AsianBasketCallPut: number of assets mismatch in price path!");
+
+  for (size_t i = 0; i < nfixings; ++i) {
+    double bsktval = 0.0;
+    for (size_t j = 0; j < nassets; ++j) {
+      bsktval += assetQuantities_[j] * pricePath(i, j);
+    }
+    bsktAvg += bsktval;
+  }
+  bsktAvg /= nfixings;
+
+  if (payoffType_ == 1)
+    payAmounts_[0] = bsktAvg >= strike_ ? bsktAvg - strike_ : 0.0;
+  else
+    payAmounts_[0] = bsktAvg >= strike_ ? 0.0 : strike_ - bsktAvg;
+}
+
+inline void AsianBasketCallPut::evalBatch(Cube const& paths, Matrix& payAmounts) const
+{
+  size_t npaths = paths.n_rows;
+  size_t nassets = paths.n_cols;
+  size_t nfixings = paths.n_slices;
+  ORF_ASSERT(fixTimes_.size() == nfixings,
+    "AsianBasketCallPut: number of fixings mismatch in paths!");
+  ORF_ASSERT(assetQuantities_.size() == nassets,
+    "AsianBasketCallPut: number of assets mismatch in paths!");
+
+  // accumulate the basket values in the payments, one fixing and asset at a time
+  payAmounts.zeros(npaths, 1);
+  double* payamts = payAmounts.colptr(0);
+  for (size_t i = 0; i < nfixings; ++i) {
+    for (size_t j = 0; j < nassets; ++j) {
+      double const* spots = paths.slice_colptr(i, j);
+      double qty = assetQuantities_[j];
+      for (size_t p = 0; p < npaths; ++p)
+        payamts[p] += qty * spots[p];
+    }
+  }
+  double phi = payoffType_;
+  for (size_t p = 0; p < npaths; ++p) {
+    double payoff = phi * (payamts[p] / nfixings - strike_);
+    payamts[p] = payoff > 0.0 ? payoff : 0.0;
+  }
+}
+
+inline size_t AsianBasketCallPut::stateSize() const
+{
+  return 1;
+}
+
+inline void AsianBasketCallPut::resetState(size_t npaths, Matrix& states) const
+{
+  states.zeros(npaths, 1);
+}
+
+inline void AsianBasketCallPut::updateState(size_t idx, Matrix const& spots, Matrix& states) const
+{
+  ORF_ASSERT(assetQuantities_.size() == spots.n_cols,
+    "AsianBasketCallPut: number of assets mismatch in spots!");
+  size_t npaths = spots.n_rows;
+  double* bsktsums = states.colptr(0);
+  for (size_t j = 0; j < spots.n_cols; ++j) {
+    double const* fixings = spots.colptr(j);
+    double qty = assetQuantities_[j];
+    for (size_t p = 0; p < npaths; ++p)
+      bsktsums[p] += qty * fixings[p];
+  }
+}
+
+inline void AsianBasketCallPut::finalizeState(Matrix const& states, Matrix& payAmounts) const
+{
+  size_t npaths = states.n_rows;
+  size_t nfixings = fixTimes_.size();
+  payAmounts.set_size(npaths, 1);
+  double const* bsktsums = states.colptr(0);
+  double* payamts = payAmounts.colptr(0);
+  double phi = payoffType_;
+  for (size_t p = 0; p < npaths; ++p) {
+    double payoff = phi * (bsktsums[p] / nfixings - strike_);
+    payamts[p] = payoff > 0.0 ? payoff : 0.0;
+  }
+}
+
+inline void AsianBasketCallPut::evalAdjoint(Matrix const& pricePath, Vector const& payBar, Matrix& pathBar)
+{
+  eval(pricePath);
+  size_t nfixings = pricePath.n_rows;
+  size_t nassets = pricePath.n_cols;
+  // the payoff is linear in the basket average, with slope 1, -1 or 0
+  double bsktAvg = 0.0;
+  for (size_t i = 0; i < nfixings; ++i)
+    for (size_t j = 0; j < nassets; ++j)
+      bsktAvg += assetQuantities_[j] * pricePath(i, j);
+  bsktAvg /= nfixings;
+  double slope = 0.0;
+  if (payoffType_ == 1)
+    slope = bsktAvg >= strike_ ? 1.0 : 0.0;
+  else
+    slope = bsktAvg >= strike_ ? 0.0 : -1.0;
+
+  double avgBar = payBar[0] * slope / nfixings;
+  pathBar.set_size(nfixings, nassets);
+  for (size_t j = 0; j < nassets; ++j)
+    for (size_t i = 0; i < nfixings; ++i)
+      pathBar(i, j) = avgBar * assetQuantities_[j];
+}
+
+// Not implemented
+inline void AsianBasketCallPut::eval(size_t idx, Vector const& spots, double contValue)
+{
+  ORF_ASSERT(0, "not implemented!");
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_ASIANBASKETCALLPUT_HPP
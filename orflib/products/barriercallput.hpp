@@ -0,0 +1,269 @@
+/**
+@file  barriercallput.hpp
+@brief The payoff of a discretely monitored knock-out barrier Call/Put option
+*/
+
+#ifndef ORF_BARRIERCALLPUT_HPP
+#define ORF_BARRIERCALLPUT_HPP
+
+#include <orflib/products/product.hpp>
+#include <orflib/math/stats/normaldistribution.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+BEGIN_NAMESPACE(orf)
+
+/** The knock-out barrier call/put class.
+    The barrier is monitored at the fixing times, the last one being the expiration; the option
+    is knocked out, and pays nothing, as soon as a fixing is at or beyond the barrier.
+    Otherwise it pays the call or put payoff at expiration.
+*/
+class BarrierCallPut : public Product
+{
+public:
+  /** Initializing ctor. The barrier type is 1 for up-and-out, -1 for down-and-out. */
+  BarrierCallPut(int payoffType, double strike, int barrierType, double barrier,
+                 Vector const& fixingTimes);
+
+  /** The number of assets this product depends on */
+  virtual size_t nAssets() const override { return 1; }
+
+  /** Returns a copy of this product */
+  virtual SPtrProduct clone() const override;
+
+  /** The payoff jumps at the barrier */
+  virtual bool isLipschitz() const override { return false; }
+
+  /** Evaluates the product given the passed-in path
+      The "pricePath" matrix must have as many rows as
+      the number of fixing times
+  */
+  virtual void eval(Matrix const& pricePath) override;
+
+  /** Evaluates the product on a batch of paths */
+  virtual void evalBatch(Cube const& paths, Matrix& payAmounts) const override;
+
+  /** In the streaming evaluation, the state of a path is 1 while it is alive, 0 once knocked out,
+      and its spot at the last fixing time passed in while alive
+  */
+  virtual size_t stateSize() const override;
+
+  /** Starts the streaming evaluation of a batch of paths */
+  virtual void resetState(size_t npaths, Matrix& states) const override;
+
+  /** Updates the states of the paths still alive with the spots at fixing time index idx */
+  virtual void updateState(size_t idx, Matrix const& spots, Matrix& states) const override;
+
+  /** Computes the payments of a batch of paths from their states */
+  virtual void finalizeState(Matrix const& states, Matrix& payAmounts) const override;
+
+  /** The knocked-out paths are decided */
+  virtual bool hasEarlyTermination() const override { return true; }
+
+  /** Removes the knocked-out paths from active */
+  virtual void updateActive(size_t idx, Matrix const& states, std::vector<size_t>& active) const override;
+
+  /** Supports conditional Monte Carlo */
+  virtual bool hasConditionalPayoff() const override { return true; }
+
+  /** Computes the expected payoffs over the last time step of the paths still alive, which are
+      also knocked out at or beyond the barrier at expiration. The knocked-out paths pay nothing.
+  */
+  virtual void finalizeConditional(Matrix const& states, Matrix const& spots, Vector const& loadings,
+                                   Matrix& payAmounts) const override;
+
+  /** Evaluates the product at fixing time index idx
+  */
+  virtual void eval(size_t idx, Vector const& spots, double contValue) override;
+
+protected:
+  /** Returns true if the spot is at or beyond the barrier */
+  bool knockedOut(double spot) const;
+
+  /** Returns the payoff at expiration of a path alive until then */
+  double payoff(double spot) const;
+
+private:
+  int payoffType_;     // 1: call; -1 put
+  double strike_;
+  int barrierType_;    // 1: up-and-out; -1: down-and-out
+  double barrier_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+inline
+BarrierCallPut::BarrierCallPut(int payoffType, double strike, int barrierType, double barrier,
+                               Vector const& fixingTimes)
+  : payoffType_(payoffType), strike_(strike), barrierType_(barrierType), barrier_(barrier)
+{
+  ORF_ASSERT(payoffType == 1 || payoffType == -1, "BarrierCallPut: the payoff type must be 1 (call) or -1 (put)!");
+  ORF_ASSERT(strike > 0.0, "BarrierCallPut: the strike must be positive!");
+  ORF_ASSERT(barrierType == 1 || barrierType == -1,
+    "BarrierCallPut: the barrier type must be 1 (up-and-out) or -1 (down-and-out)!");
+  ORF_ASSERT(barrier > 0.0, "BarrierCallPut: the barrier must be positive!");
+  ORF_ASSERT(fixingTimes.size() > 0, "BarrierCallPut: there must be at least one fixing time!");
+  ORF_ASSERT(fixingTimes[0] > 0.0, "BarrierCallPut: the first fixing time must be positive!");
+  Vector::const_iterator it(
+    std::adjacent_find(fixingTimes.begin(), fixingTimes.end(), std::greater_equal<double>()));
+  ORF_ASSERT(it == fixingTimes.end(),
+    "BarrierCallPut: the fixing times must be in strict increasing order");
+
+  // set the fixing times
+  fixTimes_ = fixingTimes;
+  // assume that it will settle (pay) at expiration
+  payTimes_.resize(1);
+  payTimes_[0] = fixingTimes[fixingTimes.size() - 1];
+
+  // this product generates only one payment
+  payAmounts_.resize(1);
+}
+
+inline
+SPtrProduct BarrierCallPut::clone() const
+{
+  return SPtrProduct(new BarrierCallPut(*this));
+}
+
+inline bool BarrierCallPut::knockedOut(double spot) const
+{
+  return barrierType_ == 1 ? spot >= barrier_ : spot <= barrier_;
+}
+
+inline double BarrierCallPut::payoff(double spot) const
+{
+  double payoff = (spot - strike_) * payoffType_;
+  return payoff > 0.0 ? payoff : 0.0;
+}
+
+inline void BarrierCallPut::eval(Matrix const& pricePath)
+{
+  size_t nfixings = fixTimes_.size();
+  ORF_ASSERT(pricePath.n_rows == nfixings,
+    "BarrierCallPut: number of fixings mismatch in price path!");
+  payAmounts_[0] = 0.0;
+  for (size_t i = 0; i < nfixings; ++i)
+    if (knockedOut(pricePath(i, 0)))
+      return;
+  payAmounts_[0] = payoff(pricePath(nfixings - 1, 0));
+}
+
+inline void BarrierCallPut::evalBatch(Cube const& paths, Matrix& payAmounts) const
+{
+  size_t nfixings = fixTimes_.size();
+  ORF_ASSERT(paths.n_slices == nfixings,
+    "BarrierCallPut: number of fixings mismatch in paths!");
+  size_t npaths = paths.n_rows;
+  payAmounts.set_size(npaths, 1);
+  double* payamts = payAmounts.colptr(0);
+  double const* S_T = paths.slice_colptr(nfixings - 1, 0);
+  for (size_t p = 0; p < npaths; ++p)
+    payamts[p] = payoff(S_T[p]);
+  // zero out the knocked-out paths, one fixing time at a time
+  for (size_t i = 0; i < nfixings; ++i) {
+    double const* S = paths.slice_colptr(i, 0);
+    for (size_t p = 0; p < npaths; ++p)
+      if (knockedOut(S[p]))
+        payamts[p] = 0.0;
+  }
+}
+
+inline size_t BarrierCallPut::stateSize() const
+{
+  return 2;
+}
+
+inline void BarrierCallPut::resetState(size_t npaths, Matrix& states) const
+{
+  states.set_size(npaths, 2);
+  states.col(0).fill(1.0);
+  states.col(1).zeros();
+}
+
+inline void BarrierCallPut::updateState(size_t idx, Matrix const& spots, Matrix& states) const
+{
+  ORF_ASSERT(idx < fixTimes_.size(), "BarrierCallPut: wrong fixing time index!");
+  double const* S = spots.colptr(0);
+  double* alive = states.colptr(0);
+  double* last = states.colptr(1);
+  // the knocked-out paths keep their states, whatever their spots
+  for (size_t p = 0; p < states.n_rows; ++p) {
+    if (alive[p] == 0.0)
+      continue;
+    last[p] = S[p];
+    if (knockedOut(S[p]))
+      alive[p] = 0.0;
+  }
+}
+
+inline void BarrierCallPut::finalizeState(Matrix const& states, Matrix& payAmounts) const
+{
+  size_t npaths = states.n_rows;
+  payAmounts.set_size(npaths, 1);
+  double const* alive = states.colptr(0);
+  double const* last = states.colptr(1);
+  double* payamts = payAmounts.colptr(0);
+  for (size_t p = 0; p < npaths; ++p)
+    payamts[p] = alive[p] != 0.0 ? payoff(last[p]) : 0.0;
+}
+
+inline void BarrierCallPut::updateActive(size_t idx, Matrix const& states,
+                                         std::vector<size_t>& active) const
+{
+  double const* alive = states.colptr(0);
+  active.erase(std::remove_if(active.begin(), active.end(),
+                              [alive](size_t p) { return alive[p] == 0.0; }),
+               active.end());
+}
+
+inline void BarrierCallPut::finalizeConditional(Matrix const& states, Matrix const& spots,
+                                                Vector const& loadings, Matrix& payAmounts) const
+{
+  size_t npaths = spots.n_rows;
+  payAmounts.set_size(npaths, 1);
+  double const* alive = states.colptr(0);
+  double const* S = spots.colptr(0);
+  double* payamts = payAmounts.colptr(0);
+  double s = std::fabs(loadings[0]);
+  if (s == 0.0) {
+    // nothing left to integrate, e.g. a zero volatility
+    for (size_t p = 0; p < npaths; ++p)
+      payamts[p] = alive[p] != 0.0 && !knockedOut(S[p]) ? payoff(S[p]) : 0.0;
+    return;
+  }
+  // the option pays at expiration if S exp(s Z) is in (lo, hi), strictly inside the barrier
+  // and in the money
+  const double inf = std::numeric_limits<double>::infinity();
+  double lo = payoffType_ == 1 ? strike_ : 0.0;
+  double hi = payoffType_ == 1 ? inf : strike_;
+  if (barrierType_ == 1)
+    hi = std::min(hi, barrier_);
+  else
+    lo = std::max(lo, barrier_);
+  NormalDistribution normal;
+  double fwdfactor = std::exp(0.5 * s * s);
+  for (size_t p = 0; p < npaths; ++p) {
+    if (alive[p] == 0.0 || lo >= hi) {
+      payamts[p] = 0.0;
+      continue;
+    }
+    // E[(S exp(s Z) - K) 1{lo < S exp(s Z) < hi}], with S exp(s Z) > x with probability N(d2(x))
+    double d2lo = lo > 0.0 ? std::log(S[p] / lo) / s : inf;
+    double d2hi = hi < inf ? std::log(S[p] / hi) / s : -inf;
+    double prob = normal.cdf(d2lo) - normal.cdf(d2hi);
+    double fwdprob = normal.cdf(d2lo + s) - normal.cdf(d2hi + s);
+    payamts[p] = payoffType_ * (S[p] * fwdfactor * fwdprob - strike_ * prob);
+  }
+}
+
+inline void BarrierCallPut::eval(size_t idx, Vector const& spots, double contValue)
+{
+  ORF_ASSERT(0, "not implemented!");
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_BARRIERCALLPUT_HPP
@@ -1,86 +1,183 @@
-/**
-@file  digitacallput.hpp
-@brief The payoff of a European Digital Call/Put option
-*/
-
-#ifndef ORF_DIGITALCALLPUT_HPP
-#define ORF_DIGITALCALLPUT_HPP
-
-#include <orflib/products/product.hpp>
-
-BEGIN_NAMESPACE(orf)
-
-/** The Digital call/put class
-*/
-class DigitalCallPut : public Product
-{
-public:
-  /** Initializing ctor */
-  DigitalCallPut(int payoffType, double strike, double timeToExp);
-
-  /** The number of assets this product depends on */
-  virtual size_t nAssets() const override { return 1; }
-
-  /** Evaluates the product given the passed-in path
-      The "pricePath" matrix must have as many rows as
-      the number of fixing times
-  */
-  virtual void eval(Matrix const& pricePath) override;
-
-  /** Evaluates the product at fixing time index idx
-  */
-  virtual void eval(size_t idx, Vector const& spots, double contValue) override;
-
-private:
-  int payoffType_;     // 1: call; -1 put
-  double strike_;
-  double timeToExp_;
-};
-
-///////////////////////////////////////////////////////////////////////////////
-// Inline definitions
-
-inline
-DigitalCallPut::DigitalCallPut(int payoffType, double strike, double timeToExp)
-  : payoffType_(payoffType), strike_(strike), timeToExp_(timeToExp)
-{
-  ORF_ASSERT(payoffType == 1 || payoffType == -1, "DigitalCallPut: the payoff type must be 1 (call) or -1 (put)!");
-  ORF_ASSERT(strike > 0.0, "DigitalCallPut: the strike must be positive!");
-  ORF_ASSERT(timeToExp > 0.0, "DigitalCallPut: the time to expiration must be positive!");
-
-  // only one fixing time, the expiration
-  fixTimes_.resize(1);
-  fixTimes_[0] = timeToExp_;
-
-  // assume that it will settle (pay) at expiration
-  // TODO allow payment time later than expiration
-  payTimes_.resize(1);
-  payTimes_[0] = timeToExp_;
-
-  // this product generates only one payment
-  payAmounts_.resize(1);
-}
-
-inline void DigitalCallPut::eval(Matrix const& pricePath)
-{
-  double S_T = pricePath(0, 0);
-  if (payoffType_ == 1)
-    payAmounts_[0] = S_T >= strike_ ? 1.0 : 0.0;
-  else
-    payAmounts_[0] = S_T >= strike_ ? 0.0 : 1.0;
-}
-
-// This product has only one fixing, so the "idx" is not checked.
-inline void DigitalCallPut::eval(size_t idx, Vector const& spots, double contValue)
-{
-    ORF_ASSERT(idx == 0, "DigitalCallPut: wrong fixing time index!");    
-    double S_T = spots[idx];
-    if (payoffType_ == 1)
-        payAmounts_[idx] = S_T >= strike_ ? 1.0 : 0.0;
-    else
-        payAmounts_[idx] = S_T >= strike_ ? 0.0 : 1.0;
-}
-
-END_NAMESPACE(orf)
-
-#endif // ORF_DIGITALCALLPUT_HPP
+/**
+@file  digitacallput.hpp
+@brief The payoff of a European Digital Call/Put option
+*/
+
+#ifndef ORF_DIGITALCALLPUT_HPP
+#define ORF_DIGITALCALLPUT_HPP
+
+#include <orflib/products/product.hpp>
+#include <orflib/math/stats/normaldistribution.hpp>
+#include <cmath>
+
+BEGIN_NAMESPACE(orf)
+
+/** The Digital call/put class
+*/
+class DigitalCallPut : public Product
+{
+public:
+  /** Initializing ctor */
+  DigitalCallPut(int payoffType, double strike, double timeToExp);
+
+  /** The number of assets this product depends on */
+  virtual size_t nAssets() const override { return 1; }
+
+  /** Returns a copy of this product */
+  virtual SPtrProduct clone() const override;
+
+  /** The payoff jumps at the strike */
+  virtual bool isLipschitz() const override { return false; }
+
+  /** Evaluates the product given the passed-in path
+      The "pricePath" matrix must have as many rows as
+      the number of fixing times
+  */
+  virtual void eval(Matrix const& pricePath) override;
+
+  /** Evaluates the product on a batch of paths */
+  virtual void evalBatch(Cube const& paths, Matrix& payAmounts) const override;
+
+  /** In the streaming evaluation, the state of a path is the spot at expiration */
+  virtual size_t stateSize() const override;
+
+  /** Starts the streaming evaluation of a batch of paths */
+  virtual void resetState(size_t npaths, Matrix& states) const override;
+
+  /** Updates the states of a batch of paths with the spots at fixing time index idx */
+  virtual void updateState(size_t idx, Matrix const& spots, Matrix& states) const override;
+
+  /** Computes the payments of a batch of paths from their states */
+  virtual void finalizeState(Matrix const& states, Matrix& payAmounts) const override;
+
+  /** Supports conditional Monte Carlo */
+  virtual bool hasConditionalPayoff() const override { return true; }
+
+  /** Computes the probabilities of finishing in the money over the last time step */
+  virtual void finalizeConditional(Matrix const& states, Matrix const& spots, Vector const& loadings,
+                                   Matrix& payAmounts) const override;
+
+  /** Evaluates the product at fixing time index idx
+  */
+  virtual void eval(size_t idx, Vector const& spots, double contValue) override;
+
+private:
+  int payoffType_;     // 1: call; -1 put
+  double strike_;
+  double timeToExp_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+inline
+DigitalCallPut::DigitalCallPut(int payoffType, double strike, double timeToExp)
+  : payoffType_(payoffType), strike_(strike), timeToExp_(timeToExp)
+{
+  ORF_ASSERT(payoffType == 1 || payoffType == -1, "DigitalCallPut: the payoff type must be 1 (call) or -1 (put)!");
+  ORF_ASSERT(strike > 0.0, "DigitalCallPut: the strike must be positive!");
+  ORF_ASSERT(timeToExp > 0.0, "DigitalCallPut: the time to expiration must be positive!");
+
+  // only one fixing time, the expiration
+  fixTimes_.resize(1);
+  fixTimes_[0] = timeToExp_;
+
+  // assume that it will settle (pay) at expiration
+  // TODO allow payment time later than expiration
+  payTimes_.resize(1);
+  payTimes_[0] = timeToExp_;
+
+  // this product generates only one payment
+  payAmounts_.resize(1);
+}
+
+inline
+SPtrProduct DigitalCallPut::clone() const
+{
+  return SPtrProduct(new DigitalCallPut(*this));
+}
+
+inline void DigitalCallPut::eval(Matrix const& pricePath)
+{
+  double S_T = pricePath(0, 0);
+  if (payoffType_ == 1)
+    payAmounts_[0] = S_T >= strike_ ? 1.0 : 0.0;
+  else
+    payAmounts_[0] = S_T >= strike_ ? 0.0 : 1.0;
+}
+
+inline void DigitalCallPut::evalBatch(Cube const& paths, Matrix& payAmounts) const
+{
+  size_t npaths = paths.n_rows;
+  payAmounts.set_size(npaths, 1);
+  double const* S_T = paths.slice_colptr(0, 0);
+  double* payamts = payAmounts.colptr(0);
+  double itm = payoffType_ == 1 ? 1.0 : 0.0;
+  for (size_t p = 0; p < npaths; ++p)
+    payamts[p] = S_T[p] >= strike_ ? itm : 1.0 - itm;
+}
+
+inline size_t DigitalCallPut::stateSize() const
+{
+  return 1;
+}
+
+inline void DigitalCallPut::resetState(size_t npaths, Matrix& states) const
+{
+  states.set_size(npaths, 1);
+}
+
+inline void DigitalCallPut::updateState(size_t idx, Matrix const& spots, Matrix& states) const
+{
+  ORF_ASSERT(idx == 0, "DigitalCallPut: wrong fixing time index!");
+  std::copy(spots.colptr(0), spots.colptr(0) + spots.n_rows, states.colptr(0));
+}
+
+inline void DigitalCallPut::finalizeState(Matrix const& states, Matrix& payAmounts) const
+{
+  size_t npaths = states.n_rows;
+  payAmounts.set_size(npaths, 1);
+  double const* S_T = states.colptr(0);
+  double* payamts = payAmounts.colptr(0);
+  double itm = payoffType_ == 1 ? 1.0 : 0.0;
+  for (size_t p = 0; p < npaths; ++p)
+    payamts[p] = S_T[p] >= strike_ ? itm : 1.0 - itm;
+}
+
+inline void DigitalCallPut::finalizeConditional(Matrix const& states, Matrix const& spots,
+                                                Vector const& loadings, Matrix& payAmounts) const
+{
+  size_t npaths = spots.n_rows;
+  payAmounts.set_size(npaths, 1);
+  double const* S = spots.colptr(0);
+  double* payamts = payAmounts.colptr(0);
+  double itm = payoffType_ == 1 ? 1.0 : 0.0;
+  double s = std::fabs(loadings[0]);
+  if (s == 0.0) {
+    // nothing left to integrate, e.g. a zero volatility
+    for (size_t p = 0; p < npaths; ++p)
+      payamts[p] = S[p] >= strike_ ? itm : 1.0 - itm;
+    return;
+  }
+  // S exp(s Z) >= K with probability N(log(S / K) / s)
+  NormalDistribution normal;
+  for (size_t p = 0; p < npaths; ++p) {
+    double prob = normal.cdf(std::log(S[p] / strike_) / s);
+    payamts[p] = payoffType_ == 1 ? prob : 1.0 - prob;
+  }
+}
+
+// This product has only one fixing, so the "idx" is not checked.
+inline void DigitalCallPut::eval(size_t idx, Vector const& spots, double contValue)
+{
+    ORF_ASSERT(idx == 0, "DigitalCallPut: wrong fixing time index!");    
+    double S_T = spots[idx];
+    if (payoffType_ == 1)
+        payAmounts_[idx] = S_T >= strike_ ? 1.0 : 0.0;
+    else
+        payAmounts_[idx] = S_T >= strike_ ? 0.0 : 1.0;
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_DIGITALCALLPUT_HPP
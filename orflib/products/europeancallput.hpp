@@ -1,87 +1,171 @@
-/**
-@file  europeancallput.hpp
-@brief The payoff of a European Call/Put option
-*/
-
-#ifndef ORF_EUROPEANCALLPUT_HPP
-#define ORF_EUROPEANCALLPUT_HPP
-
-#include <orflib/products/product.hpp>
-
-BEGIN_NAMESPACE(orf)
-
-/** The European call/put class
-*/
-class EuropeanCallPut : public Product
-{
-public:
-  /** Initializing ctor */
-  EuropeanCallPut(int payoffType, double strike, double timeToExp);
-
-  /** The number of assets this product depends on */
-  virtual size_t nAssets() const override { return 1; }
-
-  /** Evaluates the product given the passed-in path
-      The "pricePath" matrix must have as many rows as
-      the number of fixing times
-  */
-  virtual void eval(Matrix const& pricePath) override;
-
-  /** Evaluates the product at fixing time index idx
-  */
-  virtual void eval(size_t idx, Vector const& spots, double contValue) override;
-
-protected:
-  int payoffType_;     // 1: call; -1 put
-  double strike_;
-  double timeToExp_;
-};
-
-///////////////////////////////////////////////////////////////////////////////
-// Inline definitions
-
-inline
-EuropeanCallPut::EuropeanCallPut(int payoffType, double strike, double timeToExp)
-  : payoffType_(payoffType), strike_(strike), timeToExp_(timeToExp)
-{
-  ORF_ASSERT(payoffType == 1 || payoffType == -1, "EuropeanCallPut: the payoff type must be 1 (call) or -1 (put)!");
-  ORF_ASSERT(strike > 0.0, "EuropeanCallPut: the strike must be positive!");
-  ORF_ASSERT(timeToExp > 0.0, "EuropeanCallPut: the time to expiration must be positive!");
-
-  // only one fixing time, the expiration
-  fixTimes_.resize(1);
-  fixTimes_[0] = timeToExp_;
-
-  // assume that it will settle (pay) at expiration
-  // TODO allow payment time later than expiration
-  payTimes_.resize(1);
-  payTimes_[0] = timeToExp_;
-
-  // this product generates only one payment
-  payAmounts_.resize(1);
-}
-
-inline void EuropeanCallPut::eval(Matrix const& pricePath)
-{
-  double S_T = pricePath(0, 0);
-  if (payoffType_ == 1)
-    payAmounts_[0] = S_T >= strike_ ? S_T - strike_ : 0.0;
-  else
-    payAmounts_[0] = S_T >= strike_ ? 0.0 : strike_ - S_T;
-}
-
-// This product has only one fixing.
-inline void EuropeanCallPut::eval(size_t idx, Vector const& spots, double contValue)
-{
-  // the continuation value is not used
-  ORF_ASSERT(idx == 0, "EuropeanCallPut: wrong fixing time index!");
-  double S_T = spots[idx];
-  if (payoffType_ == 1)
-    payAmounts_[idx] = S_T >= strike_ ? S_T - strike_ : 0.0;
-  else
-    payAmounts_[idx] = S_T >= strike_ ? 0.0 : strike_ - S_T;
-}
-
-END_NAMESPACE(orf)
-
-#endif // ORF_EUROPEANCALLPUT_HPP
+/**
+@file  europeancallput.hpp
+@brief The payoff of a European Call/Put option
+*/
+
+#ifndef ORF_EUROPEANCALLPUT_HPP
+#define ORF_EUROPEANCALLPUT_HPP
+
+#include <orflib/products/product.hpp>
+
+BEGIN_NAMESPACE(orf)
+
+/** The European call/put class
+*/
+class EuropeanCallPut : public Product
+{
+public:
+  /** Initializing ctor */
+  EuropeanCallPut(int payoffType, double strike, double timeToExp);
+
+  /** The number of assets this product depends on */
+  virtual size_t nAssets() const override { return 1; }
+
+  /** The call/put payoff is Lipschitz in the spot at expiration */
+  virtual bool isLipschitz() const override { return true; }
+
+  /** Returns a copy of this product */
+  virtual SPtrProduct clone() const override;
+
+  /** Evaluates the product given the passed-in path
+      The "pricePath" matrix must have as many rows as
+      the number of fixing times
+  */
+  virtual void eval(Matrix const& pricePath) override;
+
+  /** Evaluates the product on a batch of paths */
+  virtual void evalBatch(Cube const& paths, Matrix& payAmounts) const override;
+
+  /** In the streaming evaluation, the state of a path is the spot at expiration */
+  virtual size_t stateSize() const override;
+
+  /** Starts the streaming evaluation of a batch of paths */
+  virtual void resetState(size_t npaths, Matrix& states) const override;
+
+  /** Updates the states of a batch of paths with the spots at fixing time index idx */
+  virtual void updateState(size_t idx, Matrix const& spots, Matrix& states) const override;
+
+  /** Computes the payments of a batch of paths from their states */
+  virtual void finalizeState(Matrix const& states, Matrix& payAmounts) const override;
+
+  /** Evaluates the product and its adjoint on the passed-in path */
+  virtual void evalAdjoint(Matrix const& pricePath, Vector const& payBar, Matrix& pathBar) override;
+
+  /** Evaluates the product at fixing time index idx
+  */
+  virtual void eval(size_t idx, Vector const& spots, double contValue) override;
+
+protected:
+  int payoffType_;     // 1: call; -1 put
+  double strike_;
+  double timeToExp_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+inline
+EuropeanCallPut::EuropeanCallPut(int payoffType, double strike, double timeToExp)
+  : payoffType_(payoffType), strike_(strike), timeToExp_(timeToExp)
+{
+  ORF_ASSERT(payoffType == 1 || payoffType == -1, "EuropeanCallPut: the payoff type must be 1 (call) or -1 (put)!");
+  ORF_ASSERT(strike > 0.0, "EuropeanCallPut: the strike must be positive!");
+  ORF_ASSERT(timeToExp > 0.0, "EuropeanCallPut: the time to expiration must be positive!");
+
+  // only one fixing time, the expiration
+  fixTimes_.resize(1);
+  fixTimes_[0] = timeToExp_;
+
+  // assume that it will settle (pay) at expiration
+  // TODO allow payment time later than expiration
+  payTimes_.resize(1);
+  payTimes_[0] = timeToExp_;
+
+  // this product generates only one payment
+  payAmounts_.resize(1);
+}
+
+inline
+SPtrProduct EuropeanCallPut::clone() const
+{
+  return SPtrProduct(new EuropeanCallPut(*this));
+}
+
+inline void EuropeanCallPut::eval(Matrix const& pricePath)
+{
+  double S_T = pricePath(0, 0);
+  if (payoffType_ == 1)
+    payAmounts_[0] = S_T >= strike_ ? S_T - strike_ : 0.0;
+  else
+    payAmounts_[0] = S_T >= strike_ ? 0.0 : strike_ - S_T;
+}
+
+inline void EuropeanCallPut::evalBatch(Cube const& paths, Matrix& payAmounts) const
+{
+  size_t npaths = paths.n_rows;
+  payAmounts.zeros(npaths, payTimes_.size());
+  double const* S_T = paths.slice_colptr(0, 0);
+  double* payamts = payAmounts.colptr(0);
+  double phi = payoffType_;
+  for (size_t p = 0; p < npaths; ++p) {
+    double payoff = phi * (S_T[p] - strike_);
+    payamts[p] = payoff > 0.0 ? payoff : 0.0;
+  }
+}
+
+inline size_t EuropeanCallPut::stateSize() const
+{
+  return 1;
+}
+
+inline void EuropeanCallPut::resetState(size_t npaths, Matrix& states) const
+{
+  states.set_size(npaths, 1);
+}
+
+inline void EuropeanCallPut::updateState(size_t idx, Matrix const& spots, Matrix& states) const
+{
+  // only the last fixing, the expiration, matters
+  if (idx + 1 == fixTimes_.size())
+    std::copy(spots.colptr(0), spots.colptr(0) + spots.n_rows, states.colptr(0));
+}
+
+inline void EuropeanCallPut::finalizeState(Matrix const& states, Matrix& payAmounts) const
+{
+  size_t npaths = states.n_rows;
+  payAmounts.zeros(npaths, payTimes_.size());
+  double const* S_T = states.colptr(0);
+  double* payamts = payAmounts.colptr(payTimes_.size() - 1);
+  double phi = payoffType_;
+  for (size_t p = 0; p < npaths; ++p) {
+    double payoff = phi * (S_T[p] - strike_);
+    payamts[p] = payoff > 0.0 ? payoff : 0.0;
+  }
+}
+
+inline void EuropeanCallPut::evalAdjoint(Matrix const& pricePath, Vector const& payBar, Matrix& pathBar)
+{
+  eval(pricePath);
+  double S_T = pricePath(0, 0);
+  pathBar.zeros(pricePath.n_rows, pricePath.n_cols);
+  if (payoffType_ == 1)
+    pathBar(0, 0) = S_T >= strike_ ? payBar[0] : 0.0;
+  else
+    pathBar(0, 0) = S_T >= strike_ ? 0.0 : -payBar[0];
+}
+
+// This product has only one fixing.
+inline void EuropeanCallPut::eval(size_t idx, Vector const& spots, double contValue)
+{
+  // the continuation value is not used
+  ORF_ASSERT(idx == 0, "EuropeanCallPut: wrong fixing time index!");
+  double S_T = spots[idx];
+  if (payoffType_ == 1)
+    payAmounts_[idx] = S_T >= strike_ ? S_T - strike_ : 0.0;
+  else
+    payAmounts_[idx] = S_T >= strike_ ? 0.0 : strike_ - S_T;
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_EUROPEANCALLPUT_HPP
@@ -1,146 +1,330 @@
-/**
-@file  product.hpp
-@brief Base class for all financial products.
-*/
-
-#ifndef ORF_PRODUCT_HPP
-#define ORF_PRODUCT_HPP
-
-#include <orflib/defines.hpp>
-#include <orflib/exception.hpp>
-#include <orflib/sptr.hpp>
-#include <orflib/math/matrix.hpp>
-
-BEGIN_NAMESPACE(orf)
-
-/** The abstract base class for all financial products.
-    It must be inherited by specific product payoffs.
-*/
-class Product
-{
-public:
-  /** Initializing ctor */
-  explicit Product(std::string const& payccy = "USD");
-
-  /** Dtor */
-  virtual ~Product() {}
-
-  /** Returns the fixing (observation) times */
-  Vector const& fixTimes() const;
-
-  /** Returns the payment times */
-  Vector const& payTimes() const;
-
-  /** Returns the payment amounts */
-  Vector const& payAmounts() const;
-
-  /** Returns the number of assets this product depends on */
-  virtual size_t nAssets() const = 0;
-
-  /** Evaluates the product given the passed-in path
-      The "pricePath" matrix must have as many rows as the number of fixing times
-  */
-  virtual void eval(Matrix const& pricePath) = 0;
-
-  /** Evaluates the product at fixing time index idx, for a vector of current spots,
-      and a given continuation value.
-      Useful for PDE pricing of products with early exercise features.
-  */
-  virtual void eval(size_t idx, Vector const& spots, double contValue) = 0;
-
-  /** Sets up the time steps, to be used in a numerical method.
-  The timesteps are returned in the std::vector<double> timesteps,
-  and for each timestep, the corresponding index in the fixingTimes() array
-  is in the std::vector<long> stepindex array.
-  If stepindex[i] returns -1, this means that timesteps[i] does not correspond
-  to a fixing time.
-  */
-  virtual void timeSteps(size_t nsteps,
-                         std::vector<double>& timesteps,
-                         std::vector<ptrdiff_t>& stepindex) const;
-
-protected:
-  std::string payccy_;
-  Vector fixTimes_;       // the fixing (observation) times
-  Vector payTimes_;       // the payment times
-  Vector payAmounts_;     // the payment times
-};
-
-/** Smart pointer to Product */
-using SPtrProduct = std::shared_ptr<Product>;
-
-///////////////////////////////////////////////////////////////////////////////
-// Inline definitions
-
-inline
-Product::Product(std::string const& payccy)
-: payccy_(payccy)
-{}
-
-inline
-Vector const& Product::fixTimes() const
-{
-  return fixTimes_;
-}
-
-inline
-Vector const& Product::payTimes() const
-{
-  return payTimes_;
-}
-
-inline
-Vector const& Product::payAmounts() const
-{
-  return payAmounts_;
-}
-
-inline
-void Product::timeSteps(size_t nsteps,
-                        std::vector<double>& timesteps,
-                        std::vector<ptrdiff_t>& stepindex) const
-{
-  timesteps.clear();
-  stepindex.clear();
-
-  // first put all the fixing times into a temp array, starting with t = 0
-  std::vector<double> tstemp(1, 0.0);
-  // put the indices also in a temp array
-  std::vector<ptrdiff_t> idxtemp(1, -1);
-  for (size_t i = 0; i < fixTimes().size(); ++i) {
-    tstemp.push_back(fixTimes()[i]);
-    idxtemp.push_back(i);
-  }
-  // if t = 0 is a fixing time, remove the extra t = 0 point
-  if (tstemp[0] == tstemp[1]) {
-    tstemp.erase(tstemp.begin());
-    idxtemp.erase(idxtemp.begin());
-  }
-
-  // NOTE: here we can put other time steps such as ex-div dates for discrete divs.
-
-  // compute the timestep size
-  double maxTime = tstemp[tstemp.size() - 1];
-  double maxdt = maxTime / std::max(nsteps, size_t(1));
-
-  for (size_t i = 0; i < tstemp.size() - 1; ++i) {
-    timesteps.push_back(tstemp[i]);           // add the time step
-    stepindex.push_back(idxtemp[i]);          // add the index
-    double dt = tstemp[i + 1] - tstemp[i];
-    if (dt - maxdt > 1.0e-8) {                // insert more steps in between
-      size_t n = size_t(dt / maxdt);
-      dt /= n;
-      double T1 = tstemp[i];
-      for (size_t j = 1; j < n; ++j) {
-        timesteps.push_back(T1 + j * dt);
-        stepindex.push_back(-1);  // this is not a product event
-      }
-    }
-  }
-  timesteps.push_back(tstemp.back());
-  stepindex.push_back(idxtemp.back());
-}
-
-END_NAMESPACE(orf)
-
-#endif // ORF_PRODUCT_HPP
+/**
+@file  product.hpp
+@brief Base class for all financial products.
+*/
+
+#ifndef ORF_PRODUCT_HPP
+#define ORF_PRODUCT_HPP
+
+#include <orflib/defines.hpp>
+#include <orflib/exception.hpp>
+#include <orflib/sptr.hpp>
+#include <orflib/math/matrix.hpp>
+#include <algorithm>
+#include <vector>
+
+BEGIN_NAMESPACE(orf)
+
+/** The abstract base class for all financial products.
+    It must be inherited by specific product payoffs.
+*/
+class Product
+{
+public:
+  /** Initializing ctor */
+  explicit Product(std::string const& payccy = "USD");
+
+  /** Dtor */
+  virtual ~Product() {}
+
+  /** Returns the fixing (observation) times */
+  Vector const& fixTimes() const;
+
+  /** Returns the payment times */
+  Vector const& payTimes() const;
+
+  /** Returns the payment amounts */
+  Vector const& payAmounts() const;
+
+  /** Returns the number of assets this product depends on */
+  virtual size_t nAssets() const = 0;
+
+  /** Returns a copy of this product.
+      Copies have their own payment amounts, so they can be evaluated on different threads.
+  */
+  virtual std::shared_ptr<Product> clone() const = 0;
+
+  /** Returns true if the payoff is Lipschitz continuous in the fixings.
+      Only then are Monte Carlo Greeks by pathwise differentiation unbiased;
+      discontinuous payoffs, e.g. digitals, need likelihood ratio Greeks.
+      The default is false, so products must opt in to pathwise Greeks.
+  */
+  virtual bool isLipschitz() const;
+
+  /** Returns true if the holder can exercise at the fixing times before the last one.
+      Monte Carlo pricers then evaluate the product with eval(idx, spots, contValue),
+      with continuation values estimated by regression, instead of eval(pricePath).
+  */
+  virtual bool hasEarlyExercise() const;
+
+  /** Evaluates the product given the passed-in path
+      The "pricePath" matrix must have as many rows as the number of fixing times
+  */
+  virtual void eval(Matrix const& pricePath) = 0;
+
+  /** Evaluates the product on a batch of paths, leaving the product unchanged,
+      so one instance can be shared by several threads.
+      The "paths" cube holds one path per row, one asset per column and one fixing time per slice.
+      The payment amounts are written into payAmounts, resized to one row per path and
+      one column per payment time.
+      It has no default implementation: evaluating path by path with eval() would need a copy of
+      the product for each batch, a heap allocation in the hot loop of the Monte Carlo pricers.
+  */
+  virtual void evalBatch(Cube const& paths, Matrix& payAmounts) const = 0;
+
+  /** Returns the number of values in the state of a path in the streaming evaluation.
+      The default is all the spots of the path, nAssets() values per fixing time.
+  */
+  virtual size_t stateSize() const;
+
+  /** Starts the streaming evaluation of a batch of npaths paths, an alternative to evalBatch()
+      that does not need the whole paths: they are passed in one fixing time at a time, in order,
+      to updateState(), and finalizeState() computes the payments.
+      In between, the path-dependent quantities, e.g. running averages or minima, are kept
+      in states, one row of stateSize() values per path, so the memory of a path does not grow
+      with the number of fixing times. Like evalBatch(), the streaming evaluation leaves the
+      product unchanged. It resizes states to npaths rows and initializes them.
+  */
+  virtual void resetState(size_t npaths, Matrix& states) const;
+
+  /** Updates the states of a batch of paths with the spots at fixing time index idx,
+      one row per path and one column per asset.
+      The default implementation stores the spots.
+  */
+  virtual void updateState(size_t idx, Matrix const& spots, Matrix& states) const;
+
+  /** Ends the streaming evaluation of a batch of paths.
+      The payment amounts are written into payAmounts, as in evalBatch().
+      The default implementation calls evalBatch() on the stored spots.
+  */
+  virtual void finalizeState(Matrix const& states, Matrix& payAmounts) const;
+
+  /** Returns true if the streaming state is additive in the fixings: updateState() adds to the
+      states a term linear in the spots, the same at every fixing time, e.g. the running sum of
+      an average. Passing w times the spots of one fixing then counts it w times, so a pricer can
+      fold fixings interpolated between simulated ones into weights of the simulated ones.
+  */
+  virtual bool hasAdditiveState() const;
+
+  /** Returns true if the payments of some paths can be decided before the last fixing time,
+      e.g. by a knock-out barrier. The streaming evaluation then calls updateActive() after each
+      updateState(), and the pricers stop simulating the paths that are decided.
+  */
+  virtual bool hasEarlyTermination() const;
+
+  /** In the streaming evaluation, removes from active, the indices of the paths still simulated
+      in increasing order, the paths whose payments are decided by the fixings up to index idx.
+      The following calls to updateState() still pass a row for every path, with stale spots
+      for the removed paths, which must not change their states; once no path is active,
+      the remaining fixing times are not passed at all.
+      The default implementation removes none.
+  */
+  virtual void updateActive(size_t idx, Matrix const& states, std::vector<size_t>& active) const;
+
+  /** Returns true if the product implements finalizeConditional(), for conditional Monte Carlo */
+  virtual bool hasConditionalPayoff() const;
+
+  /** Conditional Monte Carlo: ends the streaming evaluation of a batch of paths whose last fixing
+      time was not passed to updateState(), writing into payAmounts the expected payments over the
+      last time step. The spots at the last fixing time are spots(p, j) * exp(loadings[j] * Z),
+      one row per path and one column per asset, with Z a standard normal deviate common to all
+      the assets and independent of the states. Integrating Z out analytically smooths
+      discontinuous payoffs, e.g. digitals, and lowers the variance of the estimator.
+      Only the one direction Z is integrated out: with several assets the other deviates of the
+      last time step stay simulated, so a payoff discontinuous in them, e.g. where the worst asset
+      changes, is smoothed only partially, the less so the smaller the loadings.
+      With early termination, the paths decided before the last fixing time have the spots of
+      the time step at which they were decided, and must be paid from their states.
+      The default implementation throws, for products without conditional payoffs.
+  */
+  virtual void finalizeConditional(Matrix const& states, Matrix const& spots, Vector const& loadings,
+                                   Matrix& payAmounts) const;
+
+  /** Evaluates the product given the passed-in path, like eval(), and computes the adjoint:
+      it writes into pathBar, resized to the size of pricePath, the derivatives of
+      sum_k payBar[k] * payAmounts()[k] with respect to the entries of pricePath.
+      Products with discontinuous payoffs differentiate a smoothed payoff.
+      The default implementation throws, for products without adjoint sensitivities.
+  */
+  virtual void evalAdjoint(Matrix const& pricePath, Vector const& payBar, Matrix& pathBar);
+
+  /** Evaluates the product at fixing time index idx, for a vector of current spots,
+      and a given continuation value.
+      Useful for PDE and Longstaff-Schwartz Monte Carlo pricing of products with early exercise features.
+  */
+  virtual void eval(size_t idx, Vector const& spots, double contValue) = 0;
+
+  /** Sets up the time steps, to be used in a numerical method.
+  The timesteps are returned in the std::vector<double> timesteps,
+  and for each timestep, the corresponding index in the fixingTimes() array
+  is in the std::vector<long> stepindex array.
+  If stepindex[i] returns -1, this means that timesteps[i] does not correspond
+  to a fixing time.
+  */
+  virtual void timeSteps(size_t nsteps,
+                         std::vector<double>& timesteps,
+                         std::vector<ptrdiff_t>& stepindex) const;
+
+protected:
+  std::string payccy_;
+  Vector fixTimes_;       // the fixing (observation) times
+  Vector payTimes_;       // the payment times
+  Vector payAmounts_;     // the payment times
+};
+
+/** Smart pointer to Product */
+using SPtrProduct = std::shared_ptr<Product>;
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+inline
+Product::Product(std::string const& payccy)
+: payccy_(payccy)
+{}
+
+inline
+void Product::evalAdjoint(Matrix const& pricePath, Vector const& payBar, Matrix& pathBar)
+{
+  ORF_ASSERT(0, "this product does not support adjoint sensitivities!");
+}
+
+inline
+size_t Product::stateSize() const
+{
+  return fixTimes_.size() * nAssets();
+}
+
+inline
+void Product::resetState(size_t npaths, Matrix& states) const
+{
+  states.set_size(npaths, stateSize());
+}
+
+inline
+void Product::updateState(size_t idx, Matrix const& spots, Matrix& states) const
+{
+  // the spots of fixing idx are stored in the columns idx * nassets, ..., so that states
+  // has the memory layout of a cube with one path per row and one fixing per slice
+  size_t nassets = spots.n_cols;
+  for (size_t j = 0; j < nassets; ++j)
+    std::copy(spots.colptr(j), spots.colptr(j) + spots.n_rows, states.colptr(idx * nassets + j));
+}
+
+inline
+void Product::finalizeState(Matrix const& states, Matrix& payAmounts) const
+{
+  size_t nassets = nAssets();
+  Cube const paths(const_cast<double*>(states.memptr()), states.n_rows, nassets,
+                   states.n_cols / nassets, false, true);
+  evalBatch(paths, payAmounts);
+}
+
+inline
+bool Product::hasAdditiveState() const
+{
+  return false;
+}
+
+inline
+bool Product::hasEarlyTermination() const
+{
+  return false;
+}
+
+inline
+void Product::updateActive(size_t idx, Matrix const& states, std::vector<size_t>& active) const
+{}
+
+inline
+bool Product::hasConditionalPayoff() const
+{
+  return false;
+}
+
+inline
+void Product::finalizeConditional(Matrix const& states, Matrix const& spots, Vector const& loadings,
+                                  Matrix& payAmounts) const
+{
+  ORF_ASSERT(0, "this product does not support conditional Monte Carlo!");
+}
+
+inline
+bool Product::isLipschitz() const
+{
+  return false;
+}
+
+inline
+bool Product::hasEarlyExercise() const
+{
+  return false;
+}
+
+inline
+Vector const& Product::fixTimes() const
+{
+  return fixTimes_;
+}
+
+inline
+Vector const& Product::payTimes() const
+{
+  return payTimes_;
+}
+
+inline
+Vector const& Product::payAmounts() const
+{
+  return payAmounts_;
+}
+
+inline
+void Product::timeSteps(size_t nsteps,
+                        std::vector<double>& timesteps,
+                        std::vector<ptrdiff_t>& stepindex) const
+{
+  timesteps.clear();
+  stepindex.clear();
+
+  // first put all the fixing times into a temp array, starting with t = 0
+  std::vector<double> tstemp(1, 0.0);
+  // put the indices also in a temp array
+  std::vector<ptrdiff_t> idxtemp(1, -1);
+  for (size_t i = 0; i < fixTimes().size(); ++i) {
+    tstemp.push_back(fixTimes()[i]);
+    idxtemp.push_back(i);
+  }
+  // if t = 0 is a fixing time, remove the extra t = 0 point
+  if (tstemp[0] == tstemp[1]) {
+    tstemp.erase(tstemp.begin());
+    idxtemp.erase(idxtemp.begin());
+  }
+
+  // NOTE: here we can put other time steps such as ex-div dates for discrete divs.
+
+  // compute the timestep size
+  double maxTime = tstemp[tstemp.size() - 1];
+  double maxdt = maxTime / std::max(nsteps, size_t(1));
+
+  for (size_t i = 0; i < tstemp.size() - 1; ++i) {
+    timesteps.push_back(tstemp[i]);           // add the time step
+    stepindex.push_back(idxtemp[i]);          // add the index
+    double dt = tstemp[i + 1] - tstemp[i];
+    if (dt - maxdt > 1.0e-8) {                // insert more steps in between
+      size_t n = size_t(dt / maxdt);
+      dt /= n;
+      double T1 = tstemp[i];
+      for (size_t j = 1; j < n; ++j) {
+        timesteps.push_back(T1 + j * dt);
+        stepindex.push_back(-1);  // this is not a product event
+      }
+    }
+  }
+  timesteps.push_back(tstemp.back());
+  stepindex.push_back(idxtemp.back());
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_PRODUCT_HPP
@@ -1,113 +1,296 @@
-/**
-@file  worstofdigitalcallput.hpp
-@brief The payoff of a Worst-of Digital Call/Put option on a basket of assets
-*/
-
-#ifndef ORF_WORSTOFDIGITALCALLPUT_HPP
-#define ORF_WORSTOFDIGITALCALLPUT_HPP
-
-#include <orflib/products/product.hpp>
-#include <algorithm>
-#include <functional>
-
-BEGIN_NAMESPACE(orf)
-
-/** The Worst-of digital call/put class
-*/
-class WorstOfDigitalCallPut : public Product
-{
-
-public:
-  /** Initializing ctor */
-  WorstOfDigitalCallPut(int payoffType,
-                        double strike,
-                        double fixingTime,
-                        double expiryTime,
-                        size_t nAssets);
-
-  /** The number of assets this product depends on */
-  virtual size_t nAssets() const override;
-
-  /** Evaluates the product given the passed-in path
-      The "pricePath" matrix must have as many rows as
-      the number of fixing times
-      */
-  virtual void eval(Matrix const & pricePath) override;
-
-  /** Evaluates the product at fixing time index idx
-  */
-  virtual void eval(size_t idx, Vector const& spots, double contValue) override;
-
-private:
-  int payoffType_;          // 1: call; -1 put
-  double strike_;
-  size_t nAssets_;          // number of assets
-};
-
-///////////////////////////////////////////////////////////////////////////////
-// Inline definitions
-
-inline
-WorstOfDigitalCallPut::WorstOfDigitalCallPut(int payoffType,
-                                             double strike,
-                                             double fixingTime,
-                                             double expiryTime,
-                                             size_t nAssets)
-: payoffType_(payoffType), strike_(strike), nAssets_(nAssets)
-{
-  ORF_ASSERT(payoffType == 1 || payoffType == -1, "WorstOfDigitalCallPut: the payoff type must be 1 (call) or -1 (put)!");
-  ORF_ASSERT(strike >= 0.0, "WorstOfDigitalCallPut: the strike must be non-negative!");
-  ORF_ASSERT(fixingTime >= 0.0,
-    "WorstOfDigitalCallPut: the fixing time must be non-negative!");
-  ORF_ASSERT(expiryTime >= fixingTime,
-    "WorstOfDigitalCallPut: the expiry time must be greater the fixing time!");
-
-  // set the fixing times
-  fixTimes_.resize(2);
-  fixTimes_[0] = fixingTime;
-  fixTimes_[1] = expiryTime;
-  // assume that it will settle (pay) at expiration
-  // TODO allow payment time later than expiration
-  payTimes_.resize(1);
-  payTimes_[0] = expiryTime;
-
-  // this product generates only one payment
-  payAmounts_.resize(1);
-}
-
-inline
-size_t WorstOfDigitalCallPut::nAssets() const
-{
-  return nAssets_;
-}
-
-inline void WorstOfDigitalCallPut::eval(Matrix const & pricePath)
-{
-  size_t nfixings = pricePath.n_rows;
-  ORF_ASSERT(fixTimes_.size() == nfixings,
-    "WorstOfDigitalCallPut: number of fixings mismatch in price path!");
-  size_t nassets = pricePath.n_cols;
-  ORF_ASSERT(nAssets_ == nassets,
-    "WorstOfDigitalCallPut: number of assets mismatch in price path!");
-
-  double worst = 1.0e16;  // huge
-  for (size_t j = 0; j < nassets; ++j) {
-    double assetReturn = pricePath(1, j) / pricePath(0, j);
-    worst = assetReturn < worst ? assetReturn : worst;
-  }
-
-  if (payoffType_ == 1)
-    payAmounts_[0] = worst >= strike_ ? 1.0 : 0.0;
-  else
-    payAmounts_[0] = worst >= strike_ ? 0.0 : 1.0;
-}
-
-// Not implemented
-inline void WorstOfDigitalCallPut::eval(size_t idx, Vector const& spots, double contValue)
-{
-  ORF_ASSERT(0, "not implemented!");
-}
-
-END_NAMESPACE(orf)
-
-#endif // ORF_WORSTOFDIGITALCALLPUT_HPP
+/**
+@file  worstofdigitalcallput.hpp
+@brief The payoff of a Worst-of Digital Call/Put option on a basket of assets
+*/
+
+#ifndef ORF_WORSTOFDIGITALCALLPUT_HPP
+#define ORF_WORSTOFDIGITALCALLPUT_HPP
+
+#include <orflib/products/product.hpp>
+#include <orflib/math/stats/normaldistribution.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+BEGIN_NAMESPACE(orf)
+
+/** The Worst-of digital call/put class
+*/
+class WorstOfDigitalCallPut : public Product
+{
+
+public:
+  /** Initializing ctor.
+      The adjoint differentiates a call spread of half-width smoothingWidth around the strike
+      in place of the digital payoff.
+  */
+  WorstOfDigitalCallPut(int payoffType,
+                        double strike,
+                        double fixingTime,
+                        double expiryTime,
+                        size_t nAssets,
+                        double smoothingWidth = 0.01);
+
+  /** The number of assets this product depends on */
+  virtual size_t nAssets() const override;
+
+  /** Returns a copy of this product */
+  virtual SPtrProduct clone() const override;
+
+  /** The payoff jumps at the strike */
+  virtual bool isLipschitz() const override;
+
+  /** Evaluates the product given the passed-in path
+      The "pricePath" matrix must have as many rows as
+      the number of fixing times
+      */
+  virtual void eval(Matrix const & pricePath) override;
+
+  /** Evaluates the product on a batch of paths */
+  virtual void evalBatch(Cube const& paths, Matrix& payAmounts) const override;
+
+  /** In the streaming evaluation, the state of a path is the spots at the fixing time and the worst return */
+  virtual size_t stateSize() const override;
+
+  /** Starts the streaming evaluation of a batch of paths */
+  virtual void resetState(size_t npaths, Matrix& states) const override;
+
+  /** Updates the states of a batch of paths with the spots at fixing time index idx */
+  virtual void updateState(size_t idx, Matrix const& spots, Matrix& states) const override;
+
+  /** Computes the payments of a batch of paths from their states */
+  virtual void finalizeState(Matrix const& states, Matrix& payAmounts) const override;
+
+  /** Supports conditional Monte Carlo */
+  virtual bool hasConditionalPayoff() const override;
+
+  /** Computes the probabilities of the worst return finishing in the money over the last time step,
+      given the deviates of the last time step other than the common one integrated out. The payoff
+      stays a step function of those, so the smoothing is partial, see Product::finalizeConditional().
+  */
+  virtual void finalizeConditional(Matrix const& states, Matrix const& spots, Vector const& loadings,
+                                   Matrix& payAmounts) const override;
+
+  /** Evaluates the product and the adjoint of the smoothed payoff on the passed-in path */
+  virtual void evalAdjoint(Matrix const& pricePath, Vector const& payBar, Matrix& pathBar) override;
+
+  /** Evaluates the product at fixing time index idx
+  */
+  virtual void eval(size_t idx, Vector const& spots, double contValue) override;
+
+private:
+  int payoffType_;          // 1: call; -1 put
+  double strike_;
+  size_t nAssets_;          // number of assets
+  double smoothingWidth_;   // half-width of the call spread replacing the digital in the adjoint
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Inline definitions
+
+inline
+WorstOfDigitalCallPut::WorstOfDigitalCallPut(int payoffType,
+                                             double strike,
+                                             double fixingTime,
+                                             double expiryTime,
+                                             size_t nAssets,
+                                             double smoothingWidth)
+: payoffType_(payoffType), strike_(strike), nAssets_(nAssets), smoothingWidth_(smoothingWidth)
+{
+  ORF_ASSERT(payoffType == 1 || payoffType == -1, "WorstOfDigitalCallPut: the payoff type must be 1 (call) or -1 (put)!");
+  ORF_ASSERT(strike >= 0.0, "WorstOfDigitalCallPut: the strike must be non-negative!");
+  ORF_ASSERT(fixingTime >= 0.0,
+    "WorstOfDigitalCallPut: the fixing time must be non-negative!");
+  ORF_ASSERT(expiryTime >= fixingTime,
+    "WorstOfDigitalCallPut: the expiry time must be greater the fixing time!");
+  ORF_ASSERT(smoothingWidth > 0.0, "WorstOfDigitalCallPut: the smoothing width must be positive!");
+
+  // set the fixing times
+  fixTimes_.resize(2);
+  fixTimes_[0] = fixingTime;
+  fixTimes_[1] = expiryTime;
+  // assume that it will settle (pay) at expiration
+  // TODO allow payment time later than expiration
+  payTimes_.resize(1);
+  payTimes_[0] = expiryTime;
+
+  // this product generates only one payment
+  payAmounts_.resize(1);
+}
+
+inline
+SPtrProduct WorstOfDigitalCallPut::clone() const
+{
+  return SPtrProduct(new WorstOfDigitalCallPut(*this));
+}
+
+inline
+bool WorstOfDigitalCallPut::isLipschitz() const
+{
+  return false;
+}
+
+inline
+size_t WorstOfDigitalCallPut::nAssets() const
+{
+  return nAssets_;
+}
+
+inline void WorstOfDigitalCallPut::eval(Matrix const & pricePath)
+{
+  size_t nfixings = pricePath.n_rows;
+  ORF_ASSERT(fixTimes_.size() == nfixings,
+    "WorstOfDigitalCallPut: number of fixings mismatch in price path!");
+  size_t nassets = pricePath.n_cols;
+  ORF_ASSERT(nAssets_ == nassets,
+    "WorstOfDigitalCallPut: number of assets mismatch in price path!");
+
+  double worst = 1.0e16;  // huge
+  for (size_t j = 0; j < nassets; ++j) {
+    double assetReturn = pricePath(1, j) / pricePath(0, j);
+    worst = assetReturn < worst ? assetReturn : worst;
+  }
+
+  if (payoffType_ == 1)
+    payAmounts_[0] = worst >= strike_ ? 1.0 : 0.0;
+  else
+    payAmounts_[0] = worst >= strike_ ? 0.0 : 1.0;
+}
+
+inline void WorstOfDigitalCallPut::evalBatch(Cube const& paths, Matrix& payAmounts) const
+{
+  size_t npaths = paths.n_rows;
+  size_t nassets = paths.n_cols;
+  ORF_ASSERT(fixTimes_.size() == paths.n_slices,
+    "WorstOfDigitalCallPut: number of fixings mismatch in paths!");
+  ORF_ASSERT(nAssets_ == nassets,
+    "WorstOfDigitalCallPut: number of assets mismatch in paths!");
+
+  // track the worst return in the payments, one asset at a time
+  payAmounts.set_size(npaths, 1);
+  double* payamts = payAmounts.colptr(0);
+  for (size_t p = 0; p < npaths; ++p)
+    payamts[p] = 1.0e16;  // huge
+  for (size_t j = 0; j < nassets; ++j) {
+    double const* fix = paths.slice_colptr(0, j);
+    double const* expiry = paths.slice_colptr(1, j);
+    for (size_t p = 0; p < npaths; ++p) {
+      double assetReturn = expiry[p] / fix[p];
+      payamts[p] = assetReturn < payamts[p] ? assetReturn : payamts[p];
+    }
+  }
+  double itm = payoffType_ == 1 ? 1.0 : 0.0;
+  for (size_t p = 0; p < npaths; ++p)
+    payamts[p] = payamts[p] >= strike_ ? itm : 1.0 - itm;
+}
+
+inline size_t WorstOfDigitalCallPut::stateSize() const
+{
+  return nAssets_ + 1;
+}
+
+inline void WorstOfDigitalCallPut::resetState(size_t npaths, Matrix& states) const
+{
+  states.set_size(npaths, nAssets_ + 1);
+  states.col(nAssets_).fill(1.0e16);  // huge
+}
+
+inline void WorstOfDigitalCallPut::updateState(size_t idx, Matrix const& spots, Matrix& states) const
+{
+  ORF_ASSERT(idx < 2, "WorstOfDigitalCallPut: wrong fixing time index!");
+  ORF_ASSERT(nAssets_ == spots.n_cols,
+    "WorstOfDigitalCallPut: number of assets mismatch in spots!");
+  size_t npaths = spots.n_rows;
+  for (size_t j = 0; j < nAssets_; ++j) {
+    double const* fixings = spots.colptr(j);
+    double* fix = states.colptr(j);
+    if (idx == 0) {
+      std::copy(fixings, fixings + npaths, fix);
+      continue;
+    }
+    double* worst = states.colptr(nAssets_);
+    for (size_t p = 0; p < npaths; ++p) {
+      double assetReturn = fixings[p] / fix[p];
+      worst[p] = assetReturn < worst[p] ? assetReturn : worst[p];
+    }
+  }
+}
+
+inline void WorstOfDigitalCallPut::finalizeState(Matrix const& states, Matrix& payAmounts) const
+{
+  size_t npaths = states.n_rows;
+  payAmounts.set_size(npaths, 1);
+  double const* worst = states.colptr(nAssets_);
+  double* payamts = payAmounts.colptr(0);
+  double itm = payoffType_ == 1 ? 1.0 : 0.0;
+  for (size_t p = 0; p < npaths; ++p)
+    payamts[p] = worst[p] >= strike_ ? itm : 1.0 - itm;
+}
+
+inline bool WorstOfDigitalCallPut::hasConditionalPayoff() const
+{
+  return true;
+}
+
+inline void WorstOfDigitalCallPut::finalizeConditional(Matrix const& states, Matrix const& spots,
+                                                       Vector const& loadings, Matrix& payAmounts) const
+{
+  ORF_ASSERT(nAssets_ == spots.n_cols,
+    "WorstOfDigitalCallPut: number of assets mismatch in spots!");
+  size_t npaths = spots.n_rows;
+  payAmounts.set_size(npaths, 1);
+  double* payamts = payAmounts.colptr(0);
+  NormalDistribution normal;
+  for (size_t p = 0; p < npaths; ++p) {
+    // all the returns R_j exp(s_j Z) are at least K for Z in the interval [lo, hi]
+    double lo = -HUGE_VAL;
+    double hi = HUGE_VAL;
+    for (size_t j = 0; j < nAssets_; ++j) {
+      double assetReturn = spots(p, j) / states(p, j);
+      double s = loadings[j];
+      if (s == 0.0) {
+        if (assetReturn < strike_)
+          hi = -HUGE_VAL;    // out of the money whatever Z
+      }
+      else if (s > 0.0)
+        lo = std::max(lo, std::log(strike_ / assetReturn) / s);
+      else
+        hi = std::min(hi, std::log(strike_ / assetReturn) / s);
+    }
+    double prob = hi > lo ? normal.cdf(hi) - normal.cdf(lo) : 0.0;
+    payamts[p] = payoffType_ == 1 ? prob : 1.0 - prob;
+  }
+}
+
+inline void WorstOfDigitalCallPut::evalAdjoint(Matrix const& pricePath, Vector const& payBar, Matrix& pathBar)
+{
+  eval(pricePath);
+  size_t nassets = pricePath.n_cols;
+  double worst = 1.0e16;  // huge
+  size_t jworst = 0;
+  for (size_t j = 0; j < nassets; ++j) {
+    double assetReturn = pricePath(1, j) / pricePath(0, j);
+    if (assetReturn < worst) {
+      worst = assetReturn;
+      jworst = j;
+    }
+  }
+
+  // slope of the call spread, only the worst performing asset matters
+  pathBar.zeros(pricePath.n_rows, nassets);
+  if (std::fabs(worst - strike_) >= smoothingWidth_)
+    return;
+  double worstBar = payBar[0] * payoffType_ * 0.5 / smoothingWidth_;
+  pathBar(1, jworst) = worstBar / pricePath(0, jworst);
+  pathBar(0, jworst) = -worstBar * worst / pricePath(0, jworst);
+}
+
+// Not implemented
+inline void WorstOfDigitalCallPut::eval(size_t idx, Vector const& spots, double contValue)
+{
+  ORF_ASSERT(0, "not implemented!");
+}
+
+END_NAMESPACE(orf)
+
+#endif // ORF_WORSTOFDIGITALCALLPUT_HPP
@@ -1,124 +1,281 @@
-/**
-@file  pyfunctions3.hpp
-@brief Implementation of Python callable functions
-*/
-#include <pyorflib/pyutils.hpp>
-
-#include <orflib/defines.hpp>
-#include <orflib/products/europeancallput.hpp>
-#include <orflib/products/digitalcallput.hpp>
-#include <orflib/products/asianbasketcallput.hpp>
-#include <orflib/products/worstofdigitalcallput.hpp>
-#include <orflib/pricers/bsmcpricer.hpp>
-#include <orflib/pricers/multiassetbsmcpricer.hpp>
-#include <orflib/math/stats/meanvarcalculator.hpp>
-#include <orflib/math/random/rng.hpp>
-
-using namespace std;
-using namespace orf;
-
-static
-PyObject*  pyOrfEuroBSMC(PyObject* pyDummy, PyObject* pyArgs)
-{
-PY_BEGIN;
-
-  PyObject* pyPayoffType(NULL);
-  PyObject* pySpot(NULL);
-  PyObject* pyStrike(NULL);
-  PyObject* pyTimeToExp(NULL);
-  PyObject* pyDiscountCrv(NULL);
-  PyObject* pyDivYield(NULL);
-  PyObject* pyVolatility(NULL);
-  PyObject* pyMcParams(NULL);
-  PyObject* pyNPaths(NULL);
-
-  if (!PyArg_ParseTuple(pyArgs, "OOOOOOOOO", &pyPayoffType, &pyStrike, &pyTimeToExp, 
-    &pySpot, &pyDiscountCrv, &pyDivYield, &pyVolatility, &pyMcParams, &pyNPaths))
-    return NULL;
-
-  int payoffType = asInt(pyPayoffType);
-  double spot = asDouble(pySpot);
-  double strike = asDouble(pyStrike);
-  double timeToExp = asDouble(pyTimeToExp);
-
-  std::string name = asString(pyDiscountCrv);
-  orf::SPtrYieldCurve spyc = orf::market().yieldCurves().get(name);
-  ORF_ASSERT(spyc, "error: yield curve " + name + " not found");
-
-  double divYield = asDouble(pyDivYield);
-  // read volatility, either number or term structure
-  orf::SPtrVolatilityTermStructure spvol;
-  if (isString(pyVolatility)) { // check if input is an object name
-    std::string volname = asString(pyVolatility);
-    spvol = orf::market().volatilities().get(volname);
-  }
-  else { // assume real number
-    double vol = asDouble(pyVolatility);
-    spvol.reset(new orf::VolatilityTermStructure(&timeToExp, &timeToExp + 1,
-      &vol, &vol + 1));
-  }
-
-  // read the MC parameters
-  orf::McParams mcparams = asMcParams(pyMcParams);
-  // read the number of paths
-  unsigned long npaths = asInt(pyNPaths);
-
-  // create the product
-  orf::SPtrProduct spprod(new orf::EuropeanCallPut(payoffType, strike, timeToExp));
-  // create the pricer
-  orf::BsMcPricer bsmcpricer(spprod, spyc, divYield, spvol, spot, mcparams);
-  // create the statistics calculator
-  orf::MeanVarCalculator<double *> sc(bsmcpricer.nVariables());
-  // run the simulation
-  bsmcpricer.simulate(sc, npaths);
-  // collect results
-  orf::Matrix const& results = sc.results();
-  // read out results
-  size_t nsamples = sc.nSamples();
-  double mean = results(0, 0);
-  double stderror = results(1, 0);
-  stderror = std::sqrt(stderror / nsamples);
-
-  // write mean and standard error into a Python dictionary
-  PyObject* ret = PyDict_New();
-  int ok = PyDict_SetItem(ret, asPyScalar("Mean"), asPyScalar(mean));
-  PyDict_SetItem(ret, asPyScalar("StdErr"), asPyScalar(stderror));
-  return ret;
-
-PY_END;
-}
-
-static
-PyObject*  pyOrfSobolSeq(PyObject* pyDummy, PyObject* pyArgs)
-{
-PY_BEGIN;
-
-  PyObject* pyNPoints(NULL);
-  PyObject* pyNDims(NULL);
-  PyObject* pyDistrib(NULL);
-
-  if (!PyArg_ParseTuple(pyArgs, "OOO", &pyNPoints, &pyNDims, &pyDistrib))
-    return NULL;
-
-  size_t npts = asInt(pyNPoints);
-  size_t ndim = asInt(pyNDims);
-  int distrib = asInt(pyDistrib);
-
-  std::shared_ptr<orf::SobolURng> urng(std::make_shared<orf::SobolURng>(ndim));
-  std::shared_ptr<orf::NormalRngSobol> nrng(std::make_shared<orf::NormalRngSobol>(ndim));
-  orf::Matrix seq(npts, ndim);
-
-  if (distrib == 0) {
-    for (size_t i = 0; i < npts; ++i) {
-      urng->next(seq.begin_row(i), seq.end_row(i));
-    }
-  }
-  else if (distrib == 1) {
-    for (size_t i = 0; i < npts; ++i) {
-      nrng->next(seq.begin_row(i), seq.end_row(i));
-    }
-  }
-
-  return asNumpy(seq);
-PY_END;
-}
+/**
+@file  pyfunctions3.hpp
+@brief Implementation of Python callable functions
+*/
+#include <pyorflib/pyutils.hpp>
+
+#include <orflib/defines.hpp>
+#include <orflib/products/europeancallput.hpp>
+#include <orflib/products/digitalcallput.hpp>
+#include <orflib/products/asianbasketcallput.hpp>
+#include <orflib/products/worstofdigitalcallput.hpp>
+#include <orflib/pricers/bsmcpricer.hpp>
+#include <orflib/pricers/multiassetbsmcpricer.hpp>
+#include <orflib/pricers/portfoliobsmcpricer.hpp>
+#include <orflib/pricers/bsmlmcpricer.hpp>
+#include <orflib/math/stats/meanvarcalculator.hpp>
+#include <orflib/math/random/rng.hpp>
+
+using namespace std;
+using namespace orf;
+
+static
+PyObject*  pyOrfEuroBSMC(PyObject* pyDummy, PyObject* pyArgs)
+{
+PY_BEGIN;
+
+  PyObject* pyPayoffType(NULL);
+  PyObject* pySpot(NULL);
+  PyObject* pyStrike(NULL);
+  PyObject* pyTimeToExp(NULL);
+  PyObject* pyDiscountCrv(NULL);
+  PyObject* pyDivYield(NULL);
+  PyObject* pyVolatility(NULL);
+  PyObject* pyMcParams(NULL);
+  PyObject* pyNPaths(NULL);
+
+  if (!PyArg_ParseTuple(pyArgs, "OOOOOOOOO", &pyPayoffType, &pyStrike, &pyTimeToExp, 
+    &pySpot, &pyDiscountCrv, &pyDivYield, &pyVolatility, &pyMcParams, &pyNPaths))
+    return NULL;
+
+  int payoffType = asInt(pyPayoffType);
+  double spot = asDouble(pySpot);
+  double strike = asDouble(pyStrike);
+  double timeToExp = asDouble(pyTimeToExp);
+
+  std::string name = asString(pyDiscountCrv);
+  orf::SPtrYieldCurve spyc = orf::market().yieldCurves().get(name);
+  ORF_ASSERT(spyc, "error: yield curve " + name + " not found");
+
+  double divYield = asDouble(pyDivYield);
+  // read volatility, either number or term structure
+  orf::SPtrVolatilityTermStructure spvol;
+  if (isString(pyVolatility)) { // check if input is an object name
+    std::string volname = asString(pyVolatility);
+    spvol = orf::market().volatilities().get(volname);
+  }
+  else { // assume real number
+    double vol = asDouble(pyVolatility);
+    spvol.reset(new orf::VolatilityTermStructure(&timeToExp, &timeToExp + 1,
+      &vol, &vol + 1));
+  }
+
+  // read the MC parameters
+  orf::McParams mcparams = asMcParams(pyMcParams);
+  // read the number of paths
+  unsigned long npaths = asInt(pyNPaths);
+
+  // create the product
+  orf::SPtrProduct spprod(new orf::EuropeanCallPut(payoffType, strike, timeToExp));
+  // create the pricer
+  orf::BsMcPricer bsmcpricer(spprod, spyc, divYield, spvol, spot, mcparams);
+  // create the statistics calculator
+  orf::MeanVarCalculator<double *> sc(bsmcpricer.nVariables());
+  // run the simulation
+  bsmcpricer.simulate(sc, npaths);
+  // collect results
+  orf::Matrix const& results = sc.results();
+  // read out results
+  size_t nsamples = sc.nSamples();
+  double mean = results(0, 0);
+  double stderror = results(1, 0);
+  stderror = std::sqrt(stderror / nsamples);
+
+  // write mean and standard error into a Python dictionary
+  PyObject* ret = PyDict_New();
+  int ok = PyDict_SetItem(ret, asPyScalar("Mean"), asPyScalar(mean));
+  PyDict_SetItem(ret, asPyScalar("StdErr"), asPyScalar(stderror));
+  // the Greeks, if requested
+  if (mcparams.computeGreeks) {
+    char const* names[] = { "Delta", "Gamma", "Vega" };
+    for (size_t j = 1; j < bsmcpricer.nVariables(); ++j) {
+      PyDict_SetItem(ret, asPyScalar(names[j - 1]), asPyScalar(results(0, j)));
+      PyDict_SetItem(ret, asPyScalar(std::string(names[j - 1]) + "StdErr"),
+        asPyScalar(std::sqrt(results(1, j) / nsamples)));
+    }
+  }
+  return ret;
+
+PY_END;
+}
+
+static
+PyObject*  pyOrfBasketPtBSMC(PyObject* pyDummy, PyObject* pyArgs)
+{
+PY_BEGIN;
+
+  PyObject* pyPayoffTypes(NULL);
+  PyObject* pyStrikes(NULL);
+  PyObject* pyTimesToExp(NULL);
+  PyObject* pyBasketWghts(NULL);
+  PyObject* pySpots(NULL);
+  PyObject* pyDiscountCrv(NULL);
+  PyObject* pyDivYields(NULL);
+  PyObject* pyVolatilities(NULL);
+  PyObject* pyCorrelMat(NULL);
+  PyObject* pyPtQtys(NULL);
+  PyObject* pyMcParams(NULL);
+  PyObject* pyNPaths(NULL);
+
+  if (!PyArg_ParseTuple(pyArgs, "OOOOOOOOOOOO", &pyPayoffTypes, &pyStrikes, &pyTimesToExp,
+    &pyBasketWghts, &pySpots, &pyDiscountCrv, &pyDivYields, &pyVolatilities, &pyCorrelMat,
+    &pyPtQtys, &pyMcParams, &pyNPaths))
+    return NULL;
+
+  Vector payoffTypes = asVector(pyPayoffTypes);
+  Vector strikes = asVector(pyStrikes);
+  Vector timesToExp = asVector(pyTimesToExp);
+  Matrix basketWghts = asMatrix(pyBasketWghts);
+  size_t nprods = payoffTypes.n_elem;
+  ORF_ASSERT(strikes.n_elem == nprods && timesToExp.n_elem == nprods && basketWghts.n_rows == nprods,
+    "error: one payoff type, strike, time to expiration and row of basket weights per product");
+
+  Vector spots = asVector(pySpots);
+  std::string name = asString(pyDiscountCrv);
+  orf::SPtrYieldCurve spyc = orf::market().yieldCurves().get(name);
+  ORF_ASSERT(spyc, "error: yield curve " + name + " not found");
+  Vector divYields = asVector(pyDivYields);
+  Vector vols = asVector(pyVolatilities);
+  Matrix correlMat = asMatrix(pyCorrelMat);
+  Vector ptQtys = asVector(pyPtQtys);
+
+  // read the MC parameters
+  orf::McParams mcparams = asMcParams(pyMcParams);
+  // read the number of paths
+  unsigned long npaths = asInt(pyNPaths);
+
+  // create the products, European basket options fixing at their expirations
+  std::vector<orf::SPtrProduct> prods(nprods);
+  for (size_t i = 0; i < nprods; ++i) {
+    Vector fixingTimes{ timesToExp[i] };
+    Vector qtys = basketWghts.row(i).t();
+    prods[i].reset(new orf::AsianBasketCallPut(int(payoffTypes[i]), strikes[i], fixingTimes, qtys));
+  }
+  // create the pricer
+  orf::PortfolioBsMcPricer ptmcpricer(prods, spyc, divYields, vols, spots, correlMat, mcparams, ptQtys);
+  // create the statistics calculator
+  orf::MeanVarCalculator<double *> sc(ptmcpricer.nVariables());
+  // run the simulation
+  ptmcpricer.simulate(sc, npaths);
+  // collect results
+  orf::Matrix const& results = sc.results();
+  // read out results, the products first and the portfolio last
+  size_t nsamples = sc.nSamples();
+  Vector means = results.row(0).t();
+  Vector stderrs = arma::sqrt(results.row(1).t() / double(nsamples));
+
+  // write the means and standard errors into a Python dictionary
+  PyObject* ret = PyDict_New();
+  int ok = PyDict_SetItem(ret, asPyScalar("Mean"), asPyScalar(means[nprods]));
+  PyDict_SetItem(ret, asPyScalar("StdErr"), asPyScalar(stderrs[nprods]));
+  PyDict_SetItem(ret, asPyScalar("ProdMeans"), asNumpy(Vector(means.head(nprods))));
+  PyDict_SetItem(ret, asPyScalar("ProdStdErrs"), asNumpy(Vector(stderrs.head(nprods))));
+  return ret;
+
+PY_END;
+}
+
+static
+PyObject*  pyOrfAsianBSMLMC(PyObject* pyDummy, PyObject* pyArgs)
+{
+PY_BEGIN;
+
+  PyObject* pyPayoffType(NULL);
+  PyObject* pyStrike(NULL);
+  PyObject* pyFixTimes(NULL);
+  PyObject* pySpot(NULL);
+  PyObject* pyDiscountCrv(NULL);
+  PyObject* pyDivYield(NULL);
+  PyObject* pyVolatility(NULL);
+  PyObject* pyMcParams(NULL);
+  PyObject* pyRmse(NULL);
+  PyObject* pyNPilotPaths(NULL);
+
+  if (!PyArg_ParseTuple(pyArgs, "OOOOOOOOOO", &pyPayoffType, &pyStrike, &pyFixTimes,
+    &pySpot, &pyDiscountCrv, &pyDivYield, &pyVolatility, &pyMcParams, &pyRmse, &pyNPilotPaths))
+    return NULL;
+
+  int payoffType = asInt(pyPayoffType);
+  double strike = asDouble(pyStrike);
+  Vector fixTimes = asVector(pyFixTimes);
+  double spot = asDouble(pySpot);
+
+  std::string name = asString(pyDiscountCrv);
+  orf::SPtrYieldCurve spyc = orf::market().yieldCurves().get(name);
+  ORF_ASSERT(spyc, "error: yield curve " + name + " not found");
+
+  double divYield = asDouble(pyDivYield);
+  // read volatility, either number or term structure
+  orf::SPtrVolatilityTermStructure spvol;
+  if (isString(pyVolatility)) { // check if input is an object name
+    std::string volname = asString(pyVolatility);
+    spvol = orf::market().volatilities().get(volname);
+  }
+  else { // assume real number
+    double vol = asDouble(pyVolatility);
+    double timeToExp = fixTimes.n_elem > 0 ? fixTimes[fixTimes.n_elem - 1] : 0.0;
+    spvol.reset(new orf::VolatilityTermStructure(&timeToExp, &timeToExp + 1,
+      &vol, &vol + 1));
+  }
+
+  // read the MC parameters
+  orf::McParams mcparams = asMcParams(pyMcParams);
+  // read the target standard error and the number of pilot paths per level
+  double rmse = asDouble(pyRmse);
+  unsigned long npilotpaths = asInt(pyNPilotPaths);
+
+  // create the product, an Asian option on the average spot
+  orf::SPtrProduct spprod(new orf::AsianBasketCallPut(payoffType, strike, fixTimes, Vector{ 1.0 }));
+  // create the pricer
+  orf::BsMlmcPricer mlmcpricer(spprod, spyc, divYield, spvol, spot, mcparams);
+  // run the simulation
+  double mean = mlmcpricer.simulate(rmse, npilotpaths);
+  double stderror = mlmcpricer.stdErr();
+  std::vector<unsigned long> levelPaths = mlmcpricer.levelPaths();
+
+  // write mean, standard error and the paths per level into a Python dictionary
+  PyObject* ret = PyDict_New();
+  int ok = PyDict_SetItem(ret, asPyScalar("Mean"), asPyScalar(mean));
+  PyDict_SetItem(ret, asPyScalar("StdErr"), asPyScalar(stderror));
+  PyDict_SetItem(ret, asPyScalar("NLevels"), asPyScalar(int(mlmcpricer.nLevels())));
+  PyDict_SetItem(ret, asPyScalar("LevelPaths"),
+    asPyArray(std::vector<int>(levelPaths.begin(), levelPaths.end())));
+  return ret;
+
+PY_END;
+}
+
+static
+PyObject*  pyOrfSobolSeq(PyObject* pyDummy, PyObject* pyArgs)
+{
+PY_BEGIN;
+
+  PyObject* pyNPoints(NULL);
+  PyObject* pyNDims(NULL);
+  PyObject* pyDistrib(NULL);
+
+  if (!PyArg_ParseTuple(pyArgs, "OOO", &pyNPoints, &pyNDims, &pyDistrib))
+    return NULL;
+
+  size_t npts = asInt(pyNPoints);
+  size_t ndim = asInt(pyNDims);
+  int distrib = asInt(pyDistrib);
+
+  std::shared_ptr<orf::SobolURng> urng(std::make_shared<orf::SobolURng>(ndim));
+  std::shared_ptr<orf::NormalRngSobol> nrng(std::make_shared<orf::NormalRngSobol>(ndim));
+  orf::Matrix seq(npts, ndim);
+
+  if (distrib == 0) {
+    for (size_t i = 0; i < npts; ++i) {
+      urng->next(seq.begin_row(i), seq.end_row(i));
+    }
+  }
+  else if (distrib == 1) {
+    for (size_t i = 0; i < npts; ++i) {
+      nrng->next(seq.begin_row(i), seq.end_row(i));
+    }
+  }
+
+  return asNumpy(seq);
+PY_END;
+}